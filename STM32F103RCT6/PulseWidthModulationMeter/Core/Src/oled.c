@@ -150,30 +150,58 @@ void OLED_ShowChar(uint8_t line, uint8_t column, char character)
  * @brief  Display a string on OLED
  * @param  line The row to display (1 to 4)
  * @param  column The starting column (1 to 16)
- * @param  str The string to display
+ * @param  str The string to display (ASCII), characters beyond column 16 are not shown
  * @retval None
+ * @note   Each half of the row is sent as one run: the cursor is set once and the glyph bytes
+ *         of all characters follow in a single I2C data transfer.
  */
 void OLED_ShowString(uint8_t line, uint8_t column, char *str)
 {
-  uint8_t i;
-  for (i = 0; str[i] != '\0'; i++)
+  uint8_t i, j, half;
+  for (half = 0; half < 2; half++)
   {
-    OLED_ShowChar(line, column + i, str[i]);
+    OLED_SetCursor((line - 1) * 2 + half, (column - 1) * 8);
+    OLED_I2C_Start();
+    OLED_I2C_SendByte(0x78); // Slave address
+    OLED_I2C_SendByte(0x40); // Data mode, the column address advances after each byte
+    for (i = 0; str[i] != '\0' && column + i <= 16; i++)
+    {
+      for (j = 0; j < 8; j++)
+      {
+        OLED_I2C_SendByte(OLED_F8x16[str[i] - ' '][half * 8 + j]);
+      }
+    }
+    OLED_I2C_Stop();
   }
 }
 
 /**
- * @brief  Power function for OLED (X^Y)
- * @retval The result of X raised to the power of Y
+ * @brief  Format a number into a string of digits in one pass
+ * @param  buf The string, at least length + 1 bytes
+ * @param  number The number to format
+ * @param  length The number of digits, padded with leading zeros (0 to 32)
+ * @param  shift 0 for decimal, 1 for binary, 4 for hexadecimal
+ * @retval None
+ * @note   The digits are taken from the lowest one, shifts and masks replace the power and divide per digit.
  */
-uint32_t OLED_Pow(uint32_t X, uint32_t Y)
+static void OLED_FormatNum(char *buf, uint32_t number, uint8_t length, uint8_t shift)
 {
-  uint32_t Result = 1;
-  while (Y--)
+  uint8_t digit;
+  buf[length] = '\0';
+  while (length > 0)
   {
-    Result *= X;
+    if (shift == 0)
+    {
+      digit = number % 10;
+      number /= 10;
+    }
+    else
+    {
+      digit = number & ((1U << shift) - 1);
+      number >>= shift;
+    }
+    buf[--length] = (digit < 10) ? digit + '0' : digit - 10 + 'A';
   }
-  return Result;
 }
 
 /**
@@ -186,11 +214,9 @@ uint32_t OLED_Pow(uint32_t X, uint32_t Y)
  */
 void OLED_ShowNum(uint8_t line, uint8_t column, uint32_t number, uint8_t length)
 {
-  uint8_t i;
-  for (i = 0; i < length; i++)
-  {
-    OLED_ShowChar(line, column + i, number / OLED_Pow(10, length - i - 1) % 10 + '0');
-  }
+  char buf[11];
+  OLED_FormatNum(buf, number, length > 10 ? 10 : length, 0);
+  OLED_ShowString(line, column, buf);
 }
 
 /**
@@ -203,22 +229,10 @@ void OLED_ShowNum(uint8_t line, uint8_t column, uint32_t number, uint8_t length)
  */
 void OLED_ShowSignedNum(uint8_t line, uint8_t column, int32_t number, uint8_t length)
 {
-  uint8_t i;
-  uint32_t Number1;
-  if (number >= 0)
-  {
-    OLED_ShowChar(line, column, '+'); // Display positive sign
-    Number1 = number;
-  }
-  else
-  {
-    OLED_ShowChar(line, column, '-'); // Display negative sign
-    Number1 = -number;
-  }
-  for (i = 0; i < length; i++)
-  {
-    OLED_ShowChar(line, column + i + 1, Number1 / OLED_Pow(10, length - i - 1) % 10 + '0');
-  }
+  char buf[12];
+  buf[0] = (number >= 0) ? '+' : '-'; // Display the sign before the digits
+  OLED_FormatNum(buf + 1, (number >= 0) ? (uint32_t)number : 0U - (uint32_t)number, length > 10 ? 10 : length, 0);
+  OLED_ShowString(line, column, buf);
 }
 
 /**
@@ -231,19 +245,9 @@ void OLED_ShowSignedNum(uint8_t line, uint8_t column, int32_t number, uint8_t le
  */
 void OLED_ShowHexNum(uint8_t line, uint8_t column, uint32_t number, uint8_t length)
 {
-  uint8_t i, SingleNumber;
-  for (i = 0; i < length; i++)
-  {
-    SingleNumber = number / OLED_Pow(16, length - i - 1) % 16;
-    if (SingleNumber < 10)
-    {
-      OLED_ShowChar(line, column + i, SingleNumber + '0'); // Display 0-9
-    }
-    else
-    {
-      OLED_ShowChar(line, column + i, SingleNumber - 10 + 'A'); // Display A-F
-    }
-  }
+  char buf[9];
+  OLED_FormatNum(buf, number, length > 8 ? 8 : length, 4);
+  OLED_ShowString(line, column, buf);
 }
 
 /**
@@ -256,11 +260,9 @@ void OLED_ShowHexNum(uint8_t line, uint8_t column, uint32_t number, uint8_t leng
  */
 void OLED_ShowBinNum(uint8_t line, uint8_t column, uint32_t number, uint8_t length)
 {
-  uint8_t i;
-  for (i = 0; i < length; i++)
-  {
-    OLED_ShowChar(line, column + i, number / OLED_Pow(2, length - i - 1) % 2 + '0'); // Display 0 or 1
-  }
+  char buf[17];
+  OLED_FormatNum(buf, number, length > 16 ? 16 : length, 1);
+  OLED_ShowString(line, column, buf);
 }
 
 /**
@@ -19,6 +19,111 @@ extern "C" {
 #define OLED_UNFILLED			0
 #define OLED_FILLED				1
 
+#define OLED_BITMAP_XBM   0
+#define OLED_BITMAP_PBM   1
+
+/* Formats of OLED_ShowNumAligned, a base combined with an alignment */
+#define OLED_NUM_DEC      0x00
+#define OLED_NUM_SIGNED   0x01  // Decimal with a sign
+#define OLED_NUM_HEX      0x02
+#define OLED_NUM_BIN      0x03
+#define OLED_NUM_ZERO     0x00  // Right-aligned, padded with leading zeros
+#define OLED_NUM_RIGHT    0x10  // Right-aligned, padded with leading spaces
+#define OLED_NUM_LEFT     0x20  // Left-aligned, padded with trailing spaces
+
+/* Point positions of OLED_ShowFixed */
+#define OLED_FIXED_DEC(scale)  (scale)         // The value is number / 10^scale
+#define OLED_FIXED_Q(q)        (0x80 | (q))    // The value is number / 2^q
+
+/* Flags of the text layout, an alignment combined with a wrap mode and OLED_TEXT_ELLIPSIS */
+#define OLED_TEXT_LEFT       0x00
+#define OLED_TEXT_CENTER     0x01
+#define OLED_TEXT_RIGHT      0x02
+#define OLED_TEXT_NO_WRAP    0x00  // Only line feeds start a new line, longer lines are cut
+#define OLED_TEXT_WRAP_CHAR  0x10  // Break between any two characters
+#define OLED_TEXT_WRAP_WORD  0x20  // Break at spaces and around Chinese characters, longer words between characters
+#define OLED_TEXT_ELLIPSIS   0x40  // End a cut line with "..."
+
+#define OLED_GRAY_4BIT    4
+#define OLED_GRAY_8BIT    8
+
+#define OLED_ROTATION_0     0
+#define OLED_ROTATION_90    1
+#define OLED_ROTATION_180   2
+#define OLED_ROTATION_270   3
+
+/* Bit-band access to the display memory array, only available when compiling for the Cortex-M3 core,
+   not from the CMSIS headers, which are also included by host builds.
+   Only the single-pixel paths use the alias: OLED_DrawPoint, OLED_GetPoint and OLED_ClearArea,
+   the other drawing functions write whole page bytes. The array is then in the NOLOAD .oled_buf section,
+   which the startup code zero-fills itself, a custom startup must do the same or call OLED_Init before drawing */
+#ifndef OLED_USE_BITBAND
+  #if defined(__arm__) && defined(__ARM_ARCH_7M__)
+    #define OLED_USE_BITBAND  1
+  #else
+    #define OLED_USE_BITBAND  0  // Portable fallback for host builds
+  #endif
+#endif
+
+/* Glyph cache of characters at y-coordinates that are not a multiple of 8, used by the character, string, text box
+   and OLED_Printf functions, RAM use is about slots * (slot size + 12) bytes */
+#ifndef OLED_GLYPH_CACHE_SLOTS
+  #define OLED_GLYPH_CACHE_SLOTS      8   // 0: no cache
+#endif
+#ifndef OLED_GLYPH_CACHE_SLOT_SIZE
+  #define OLED_GLYPH_CACHE_SLOT_SIZE  48  // A 16*16 glyph split across 3 pages, larger glyphs are not cached
+#endif
+
+/* Maximum number of lines of OLED_ShowTextBox, its stack use is 8 bytes per line */
+#ifndef OLED_TEXT_MAX_LINES
+  #define OLED_TEXT_MAX_LINES  16  // 128 pixels of OLED_6X8 text
+#endif
+
+/* SRAM address of the display memory array, it must match the .oled_buf section in STM32F103RCTX_FLASH.ld */
+#ifndef OLED_DISPLAYBUF_ADDR
+  #define OLED_DISPLAYBUF_ADDR  0x20000000UL
+#endif
+
+/* Size in bytes of a surface memory in page format */
+#define OLED_SURFACE_SIZE(width, height)  ((((height) + 7) / 8) * (width))
+
+/* Data Type Definitions -----------------------------------------------------*/
+
+/* Drawing surface in the page format of the OLED display memory array */
+typedef struct
+{
+  uint8_t *buf;    // Surface memory, (height + 7) / 8 pages of width bytes each
+  int16_t width;   // Width of the surface in pixels
+  int16_t height;  // Height of the surface in pixels
+} OLED_Surface_t;
+
+/* Rectangle of OLED_DrawRects */
+typedef struct
+{
+  int16_t x, y;            // Top-left corner
+  uint8_t width, height;
+} OLED_Rect_t;
+
+/* Line of a text layout, a part of the laid out string */
+typedef struct
+{
+  uint16_t start;    // Offset of the first byte of the line in the string
+  uint16_t length;   // Number of bytes of the line, without the line feed or the spaces at a break
+  int16_t width;     // Width in pixels, including the ellipsis
+  uint8_t ellipsis;  // 1: the line was cut and ends with "..."
+} OLED_TextLine_t;
+
+/* Entry of the seed stack of OLED_FloodFill */
+typedef struct
+{
+  int16_t x, y;
+} OLED_FillSeed_t;
+
+/* Global Variable Declarations ----------------------------------------------*/
+
+extern uint8_t OLED_DisplayBuf[8][128];
+extern OLED_Surface_t OLED_Screen;
+
 /* Function Prototypes -------------------------------------------------------*/
 
 /* OLED Screen Tool Functions ------------------------------------------------*/
@@ -30,8 +135,14 @@ uint8_t OLED_IsInAngle(int16_t x, int16_t y, int16_t start_angle, int16_t end_an
 /* OLED Screen Hardware Configuration Functions ------------------------------*/
 
 void OLED_Init(void);
+void OLED_SetRotation(uint8_t rotation);
 void OLED_SetCursor(uint8_t page, uint8_t x);
 
+/* OLED Glyph Cache Functions -----------------------------------------------*/
+
+void OLED_GlyphCacheClear(void);
+void OLED_GlyphCacheStats(uint32_t *hits, uint32_t *misses);
+
 /* OLED Screen Display Functions ----------------------------------------------*/
 
 void OLED_Update(void);
@@ -40,26 +151,65 @@ void OLED_Clear(void);
 void OLED_ClearArea(int16_t x, int16_t y, uint8_t width, uint8_t height);
 void OLED_Reverse(void);
 void OLED_ReverseArea(int16_t x, int16_t y, uint8_t width, uint8_t height);
+uint32_t OLED_DecodeUTF8(const char **str);
+uint32_t OLED_DecodeGB2312(const char **str);
+uint32_t OLED_DecodeChar(const char **str);
+const uint8_t *OLED_GetGlyph(uint8_t font_size, uint32_t code, uint8_t *width, uint8_t *height);
 void OLED_ShowChar(int16_t x, int16_t y, char character, uint8_t font_size);
 void OLED_ShowString(int16_t x, int16_t y, char *str, uint8_t font_size);
+void OLED_ShowCharScaled(int16_t x, int16_t y, char character, uint8_t font_size, uint8_t scale);
+void OLED_ShowStringScaled(int16_t x, int16_t y, char *str, uint8_t font_size, uint8_t scale);
+const OLED_PackedGlyph_t *OLED_GetPackedGlyph(const OLED_PackedFont_t *font, uint32_t code, const uint8_t **bits);
+uint8_t OLED_ShowPackedChar(int16_t x, int16_t y, uint32_t code, const OLED_PackedFont_t *font);
+void OLED_ShowPackedString(int16_t x, int16_t y, char *str, const OLED_PackedFont_t *font);
 void OLED_ShowNum(int16_t x, int16_t y, uint32_t number, uint8_t length, uint8_t font_size);
 void OLED_ShowSignedNum(int16_t x, int16_t y, int32_t number, uint8_t length, uint8_t font_size);
 void OLED_ShowHexNum(int16_t x, int16_t y, uint32_t number, uint8_t length, uint8_t font_size);
 void OLED_ShowBinNum(int16_t x, int16_t y, uint32_t number, uint8_t length, uint8_t font_size);
+void OLED_ShowNumAligned(int16_t x, int16_t y, uint32_t number, uint8_t length, uint8_t format, uint8_t font_size);
 void OLED_ShowFloatNum(int16_t x, int16_t y, double number, uint8_t int_length, uint8_t fra_length, uint8_t font_size);
+void OLED_ShowFixed(int16_t x, int16_t y, int32_t number, uint8_t point, uint8_t int_length, uint8_t fra_length, uint8_t font_size);
+void OLED_ShowFloat(int16_t x, int16_t y, float number, uint8_t int_length, uint8_t fra_length, uint8_t font_size);
 void OLED_ShowImage(int16_t x, int16_t y, uint8_t width, uint8_t height, const uint8_t *image);
+void OLED_ShowImageScaled(int16_t x, int16_t y, uint8_t width, uint8_t height, const uint8_t *image, uint8_t scale);
+void OLED_ShowImageRLE(int16_t x, int16_t y, uint8_t width, uint8_t height, const uint8_t *data);
+void OLED_ShowBitmap(int16_t x, int16_t y, uint8_t width, uint8_t height, const uint8_t *bitmap, uint8_t format);
+void OLED_ShowGrayImage(int16_t x, int16_t y, uint8_t width, uint8_t height, const uint8_t *gray, uint8_t bits);
 void OLED_Printf(int16_t x, int16_t y, uint8_t font_size, char *format, ...);
 
+/* OLED Text Layout Functions -----------------------------------------------*/
+
+int16_t OLED_MeasureString(const char *str, uint8_t font_size);
+uint8_t OLED_LayoutText(const char *str, int16_t width, int16_t height, uint8_t font_size, uint8_t flags,
+                        OLED_TextLine_t *lines, uint8_t max_lines);
+void OLED_ShowTextLines(int16_t x, int16_t y, int16_t width, const char *str, const OLED_TextLine_t *lines, uint8_t count,
+                        uint8_t font_size, uint8_t flags);
+void OLED_ShowTextBox(int16_t x, int16_t y, int16_t width, int16_t height, const char *str, uint8_t font_size, uint8_t flags);
+
+/* OLED Screen Surface Functions --------------------------------------------*/
+
+void OLED_SurfaceInit(OLED_Surface_t *surface, uint8_t *buf, int16_t width, int16_t height);
+void OLED_SetTarget(OLED_Surface_t *surface);
+OLED_Surface_t *OLED_GetTarget(void);
+void OLED_BlitSurface(int16_t x, int16_t y, int16_t width, int16_t height, const OLED_Surface_t *src, int16_t src_x, int16_t src_y);
+
 /* OLED Screen Draw Geometry Functions ---------------------------------------*/
 
 void OLED_DrawPoint(int16_t x, int16_t y);
 uint8_t OLED_GetPoint(int16_t x, int16_t y);
+void OLED_DrawPoints(const int16_t *x, const int16_t *y, uint16_t count);
 void OLED_DrawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1);
+void OLED_DrawPolyline(const int16_t *x, const int16_t *y, uint16_t count);
+void OLED_DrawPlot(int16_t x, int16_t y, uint8_t height, const int16_t *samples, uint8_t count, int16_t min, int16_t max);
 void OLED_DrawRectangle(int16_t x, int16_t y, uint8_t width, uint8_t height, uint8_t is_filled);
+void OLED_DrawRects(const OLED_Rect_t *rects, uint16_t count, uint8_t is_filled);
 void OLED_DrawTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint8_t is_filled);
 void OLED_DrawCircle(int16_t center_x, int16_t center_y, uint8_t radius, uint8_t is_filled);
 void OLED_DrawEllipse(int16_t center_x, int16_t center_y, uint8_t a, uint8_t b, uint8_t is_filled);
 void OLED_DrawArc(int16_t center_x, int16_t center_y, uint8_t radius, int16_t start_angle, int16_t end_angle, uint8_t is_filled);
+void OLED_DrawQuadBezier(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2);
+void OLED_DrawCubicBezier(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t x3, int16_t y3);
+uint16_t OLED_FloodFill(int16_t x, int16_t y, OLED_FillSeed_t *stack, uint16_t size);
 
 #ifdef __cplusplus
 }
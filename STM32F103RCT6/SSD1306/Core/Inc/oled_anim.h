@@ -0,0 +1,43 @@
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __OLED_ANIM_H__
+#define __OLED_ANIM_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "oled.h"
+
+/* Data Type Definitions -----------------------------------------------------*/
+
+/* XOR-delta animation, generated by Tools/oled_anim.c */
+typedef struct
+{
+  uint8_t width, height;     // Size of the animation in pixels
+  uint8_t frame_count;       // Number of frames, including the keyframe
+  uint16_t frame_time;       // Time of each frame in milliseconds
+  const uint8_t *keyframe;   // The first frame in page format
+  const uint8_t *deltas;     // frame_count delta records, the last one leads back to the keyframe
+} OLED_Animation_t;
+
+/* Playback state of an animation */
+typedef struct
+{
+  const OLED_Animation_t *anim;
+  int16_t x, y;              // Position of the top-left corner on the screen
+  uint8_t frame;             // Current frame
+  const uint8_t *next;       // Delta record leading to the next frame
+  uint32_t tick;             // HAL tick of the current frame
+} OLED_AnimPlayer_t;
+
+/* Function Prototypes -------------------------------------------------------*/
+
+void OLED_AnimStart(OLED_AnimPlayer_t *player, const OLED_Animation_t *anim, int16_t x, int16_t y);
+uint8_t OLED_AnimTick(OLED_AnimPlayer_t *player);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* __OLED_ANIM_H__ */
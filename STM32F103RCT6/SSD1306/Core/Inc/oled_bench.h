@@ -0,0 +1,53 @@
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __OLED_BENCH_H__
+#define __OLED_BENCH_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "oled.h"
+
+/* Macros --------------------------------------------------------------------*/
+
+/* Count the cycles with the DWT cycle counter, only when compiling for the Cortex-M3 core,
+   like OLED_TRANSITION_USE_DWT */
+#ifndef OLED_BENCH_USE_DWT
+  #if defined(__arm__) && defined(__ARM_ARCH_7M__)
+    #define OLED_BENCH_USE_DWT  1
+  #else
+    #define OLED_BENCH_USE_DWT  0
+  #endif
+#endif
+
+/* Cycle counter of the benchmarks */
+#ifndef OLED_BENCH_CYCLES
+  #if OLED_BENCH_USE_DWT
+    #define OLED_BENCH_CYCLES()  (DWT->CYCCNT)
+  #else
+    #define OLED_BENCH_CYCLES()  0U  // No cycle counter on host builds
+  #endif
+#endif
+
+/* Data Type Definitions -----------------------------------------------------*/
+
+/* Result of OLED_BenchNumbers, the cycles of one call averaged over the sample values */
+typedef struct
+{
+  uint32_t float_num;   // OLED_ShowFloatNum, double-precision software math
+  uint32_t fixed;       // OLED_ShowFixed with a decimal point
+  uint32_t single;      // OLED_ShowFloat
+  uint16_t count;       // Number of sample values
+} OLED_NumberBench_t;
+
+/* Function Prototypes -------------------------------------------------------*/
+
+void OLED_BenchNumbers(OLED_NumberBench_t *bench);
+void OLED_BenchShowNumbers(const OLED_NumberBench_t *bench);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* __OLED_BENCH_H__ */
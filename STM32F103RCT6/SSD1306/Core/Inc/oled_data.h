@@ -20,6 +20,9 @@ extern "C" {
   #define OLED_CHARSET_GB2312  // Define the character set as GB2312
 #endif
 
+/* Number of glyphs of a packed font per entry of its offset table */
+#define OLED_PACKED_OFFSET_STEP  8
+
 /* Data Type Definitions -----------------------------------------------------*/
 
 /* Basic unit of Chinese character font*/
@@ -34,12 +37,67 @@ typedef struct
     uint8_t data[32];  // Character font data
 } ChineseCell_t;
 
+/* Entry of the sorted index of the Chinese font library */
+typedef struct
+{
+    uint32_t code;  // Codepoint of the character, the Unicode codepoint for UTF-8 or the 2-byte code for GB2312
+    uint16_t cell;  // Position of the character in the font library
+} ChineseIndex_t;
+
+/* Codepoint range of a font */
+typedef struct
+{
+    uint32_t first, last;          // Codepoints covered by the range
+    uint8_t width, height;         // Size of the glyphs in pixels
+    const uint8_t *glyphs;         // Glyph data in page format
+    uint16_t stride;               // Bytes from one glyph to the next
+    const ChineseIndex_t *index;   // NULL: codepoint c is glyph c - first, otherwise the codepoints of the glyphs in ascending order
+    uint16_t index_size;           // Number of entries of the index
+} OLED_FontRange_t;
+
+/* Font, a list of codepoint ranges */
+typedef struct
+{
+    const OLED_FontRange_t *ranges;
+    uint8_t range_count;
+    uint8_t missing_width, missing_height;
+    const uint8_t *missing;        // Glyph of the characters not covered by the font
+} OLED_Font_t;
+
+/* Glyph of a packed font */
+typedef struct
+{
+    uint8_t width, height;         // Size of the bounding box of the set pixels, 0: a blank glyph
+    uint8_t x_offset, y_offset;    // Position of the bounding box in the character cell
+    uint8_t advance;               // Width of the character cell, the distance to the next character
+} OLED_PackedGlyph_t;
+
+/* Font with per-glyph advance widths and bit-packed bounding boxes */
+typedef struct
+{
+    const uint8_t *bitmap;         // Bounding boxes column by column, each column from the top, LSB first, each glyph starts at a byte
+    const uint16_t *offsets;       // Byte offset in the bitmap of every OLED_PACKED_OFFSET_STEP-th glyph
+    const OLED_PackedGlyph_t *glyphs;
+    const uint32_t *codes;         // NULL: glyph n is the codepoint first + n, otherwise the codepoints of the glyphs in ascending order
+    uint32_t first;
+    uint16_t glyph_count;
+    uint16_t missing;              // Glyph of the characters not covered by the font
+    uint8_t height;                // Height of the character cells in pixels, range: [1,32]
+} OLED_PackedFont_t;
+
 /* Font Library Declarations -------------------------------------------------*/
 
 extern const uint8_t OLED_F8x16[][16];      // ASCII font library (8x16 font size)
 extern const uint8_t OLED_F6x8[][6];        // ASCII font library (6x8 font size)
 
 extern const ChineseCell_t OLED_CF16x16[];  // Chinese font library (16x16 font size)
+extern const ChineseIndex_t OLED_CF16x16_Index[];  // Index of the Chinese font library, sorted by codepoint
+
+extern const OLED_Font_t OLED_Font8x16;     // ASCII in 8x16 and Chinese characters in 16x16
+extern const OLED_Font_t OLED_Font6x8;      // ASCII in 6x8
+
+extern const OLED_PackedFont_t OLED_PackedFont8x16;  // OLED_F8x16 as a packed font
+extern const OLED_PackedFont_t OLED_PackedFont6x8;   // OLED_F6x8 as a packed font
 
 /* Image Library Declarations ------------------------------------------------*/
 
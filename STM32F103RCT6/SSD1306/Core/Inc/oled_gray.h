@@ -0,0 +1,46 @@
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __OLED_GRAY_H__
+#define __OLED_GRAY_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "oled.h"
+
+/* Macros --------------------------------------------------------------------*/
+
+#define OLED_GRAY_PLANES_MAX  3  // Up to 8 gray levels
+
+/* Size in bytes of the plane memory of OLED_GrayInit */
+#define OLED_GRAY_BUF_SIZE(planes)  ((planes) * OLED_SURFACE_SIZE(128, 64))
+
+/* Plane rate needed for the whole plane sequence to repeat at 50 Hz, below it the gray levels flicker */
+#define OLED_GRAY_MIN_RATE(planes)  (50U * ((1U << (planes)) - 1U))
+
+/* Data Type Definitions -----------------------------------------------------*/
+
+/* Temporal gray display, binary weighted bit-planes shown in turn */
+typedef struct
+{
+  OLED_Surface_t plane[OLED_GRAY_PLANES_MAX];  // Plane k holds bit k of the gray level
+  uint8_t planes;       // Number of planes
+  uint8_t step;         // Position in the plane sequence
+  uint16_t count;       // Planes sent since rate_tick
+  uint32_t rate_tick;   // HAL tick of the last rate measurement
+  uint16_t rate;        // Measured plane rate in planes per second, 0: not measured yet
+} OLED_Gray_t;
+
+/* Function Prototypes -------------------------------------------------------*/
+
+void OLED_GrayInit(OLED_Gray_t *gray, uint8_t *buf, uint8_t planes);
+void OLED_GrayClear(OLED_Gray_t *gray);
+void OLED_GrayShowImage(OLED_Gray_t *gray, int16_t x, int16_t y, uint8_t width, uint8_t height, const uint8_t *image, uint8_t bits);
+void OLED_GrayFlush(OLED_Gray_t *gray);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* __OLED_GRAY_H__ */
@@ -0,0 +1,57 @@
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __OLED_SCENE_H__
+#define __OLED_SCENE_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "oled.h"
+
+/* Macros --------------------------------------------------------------------*/
+
+#ifndef OLED_SCENE_MAX_ITEMS
+  #define OLED_SCENE_MAX_ITEMS  32  // Capacity of the retained scene, at most 127
+#endif
+
+#define OLED_SCENE_NONE   0
+#define OLED_SCENE_TEXT   1
+#define OLED_SCENE_RECT   2
+#define OLED_SCENE_LINE   3
+#define OLED_SCENE_IMAGE  4
+
+/* Data Type Definitions -----------------------------------------------------*/
+
+/* Typed draw command of the retained scene */
+typedef struct
+{
+  uint8_t type;       // OLED_SCENE_TEXT, OLED_SCENE_RECT, OLED_SCENE_LINE or OLED_SCENE_IMAGE
+  uint8_t visible;    // Whether the item is drawn
+  uint8_t style;      // Font size of a text, is_filled of a rectangle
+  int16_t x0, y0;     // Position of the item, the first endpoint of a line
+  int16_t x1, y1;     // The second endpoint of a line, width and height of a rectangle or an image
+  const void *data;   // String of a text, data of an image
+  int16_t box_x, box_y, box_width, box_height;  // Bounding box of the item
+} OLED_SceneItem_t;
+
+/* Function Prototypes -------------------------------------------------------*/
+
+void OLED_SceneClear(void);
+int8_t OLED_SceneAddText(int16_t x, int16_t y, const char *str, uint8_t font_size);
+int8_t OLED_SceneAddRect(int16_t x, int16_t y, uint8_t width, uint8_t height, uint8_t is_filled);
+int8_t OLED_SceneAddLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1);
+int8_t OLED_SceneAddImage(int16_t x, int16_t y, uint8_t width, uint8_t height, const uint8_t *image);
+void OLED_SceneSetText(int8_t id, const char *str);
+void OLED_SceneSetImage(int8_t id, const uint8_t *image);
+void OLED_SceneMove(int8_t id, int16_t x, int16_t y);
+void OLED_SceneSetVisible(int8_t id, uint8_t visible);
+void OLED_SceneRemove(int8_t id);
+void OLED_SceneMarkDirty(int16_t x, int16_t y, int16_t width, int16_t height);
+void OLED_SceneRender(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* __OLED_SCENE_H__ */
@@ -0,0 +1,51 @@
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __OLED_SPRITE_H__
+#define __OLED_SPRITE_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "oled.h"
+
+/* Macros --------------------------------------------------------------------*/
+
+#ifndef OLED_SPRITE_MAX
+  #define OLED_SPRITE_MAX  8  // Capacity of the sprite pool, at most 127
+#endif
+
+/* Data Type Definitions -----------------------------------------------------*/
+
+/* Sprite of the compositor */
+typedef struct
+{
+  const uint8_t *image;  // Image data in page format
+  const uint8_t *mask;   // Mask data in page format, 1: opaque, 0: transparent, NULL: the whole box is opaque
+  int16_t x, y;          // Position of the top-left corner
+  uint8_t width, height;
+  int8_t z;              // Z-order, sprites with a greater z are drawn on top
+  uint8_t in_use;
+  uint8_t visible;
+  uint8_t dirty;         // Changed since the last OLED_SpriteUpdate
+  uint8_t drawn;         // Whether the sprite is on the screen, at the drawn_* box
+  int16_t drawn_x, drawn_y;
+  uint8_t drawn_width, drawn_height;
+} OLED_Sprite_t;
+
+/* Function Prototypes -------------------------------------------------------*/
+
+void OLED_SpriteSetBackground(const OLED_Surface_t *background);
+int8_t OLED_SpriteCreate(int16_t x, int16_t y, uint8_t width, uint8_t height, const uint8_t *image, const uint8_t *mask, int8_t z);
+void OLED_SpriteDestroy(int8_t id);
+void OLED_SpriteMove(int8_t id, int16_t x, int16_t y);
+void OLED_SpriteSetImage(int8_t id, const uint8_t *image, const uint8_t *mask);
+void OLED_SpriteSetZ(int8_t id, int8_t z);
+void OLED_SpriteSetVisible(int8_t id, uint8_t visible);
+void OLED_SpriteUpdate(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* __OLED_SPRITE_H__ */
@@ -0,0 +1,86 @@
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __OLED_TRANSITION_H__
+#define __OLED_TRANSITION_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "oled.h"
+
+/* Macros --------------------------------------------------------------------*/
+
+/* Transition types, the direction is the one the new screen or the wipe edge moves in */
+#define OLED_TRANSITION_SLIDE_LEFT   0x00  // The new screen slides in over the old one
+#define OLED_TRANSITION_SLIDE_RIGHT  0x01
+#define OLED_TRANSITION_SLIDE_UP     0x02
+#define OLED_TRANSITION_SLIDE_DOWN   0x03
+#define OLED_TRANSITION_PUSH_LEFT    0x04  // The new screen pushes the old one out
+#define OLED_TRANSITION_PUSH_RIGHT   0x05
+#define OLED_TRANSITION_PUSH_UP      0x06
+#define OLED_TRANSITION_PUSH_DOWN    0x07
+#define OLED_TRANSITION_WIPE_LEFT    0x08  // Neither screen moves, an edge uncovers the new one
+#define OLED_TRANSITION_WIPE_RIGHT   0x09
+#define OLED_TRANSITION_WIPE_UP      0x0A
+#define OLED_TRANSITION_WIPE_DOWN    0x0B
+
+/* Fixed-point 1.0 of the easing functions */
+#define OLED_EASE_ONE  1024
+
+/* Measure the compose time with the DWT cycle counter, only when compiling for the Cortex-M3 core,
+   the CMSIS headers define DWT in host builds as well, where the debug registers cannot be written */
+#ifndef OLED_TRANSITION_USE_DWT
+  #if defined(__arm__) && defined(__ARM_ARCH_7M__)
+    #define OLED_TRANSITION_USE_DWT  1
+  #else
+    #define OLED_TRANSITION_USE_DWT  0
+  #endif
+#endif
+
+/* Cycle counter for the compose time */
+#ifndef OLED_TRANSITION_CYCLES
+  #if OLED_TRANSITION_USE_DWT
+    #define OLED_TRANSITION_CYCLES()  (DWT->CYCCNT)
+  #else
+    #define OLED_TRANSITION_CYCLES()  0U  // No cycle counter on host builds
+  #endif
+#endif
+
+/* Data Type Definitions -----------------------------------------------------*/
+
+/* Easing function, maps the elapsed time to the progress, both range: [0,OLED_EASE_ONE] */
+typedef uint16_t (*OLED_Easing_t)(uint16_t t);
+
+/* State of a running transition */
+typedef struct
+{
+  const OLED_Surface_t *from;   // The old screen, the size of OLED_Screen
+  const OLED_Surface_t *to;     // The new screen, the size of OLED_Screen
+  uint8_t type;
+  uint16_t duration;            // Duration in milliseconds
+  OLED_Easing_t ease;
+  uint32_t start;               // HAL tick of the start
+  int16_t offset;               // Offset of the last composed frame in pixels
+  uint16_t frames;              // Number of frames composed
+  uint32_t compose_cycles;      // Compose time of the last frame in CPU cycles
+  uint32_t compose_max;         // Longest compose time of a frame in CPU cycles
+  uint32_t compose_total;       // Sum of the compose times of all frames in CPU cycles
+} OLED_Transition_t;
+
+/* Function Prototypes -------------------------------------------------------*/
+
+uint16_t OLED_EaseLinear(uint16_t t);
+uint16_t OLED_EaseIn(uint16_t t);
+uint16_t OLED_EaseOut(uint16_t t);
+uint16_t OLED_EaseInOut(uint16_t t);
+
+void OLED_TransitionStart(OLED_Transition_t *transition, const OLED_Surface_t *from, const OLED_Surface_t *to,
+                          uint8_t type, uint16_t duration, OLED_Easing_t ease);
+uint8_t OLED_TransitionTick(OLED_Transition_t *transition);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* __OLED_TRANSITION_H__ */
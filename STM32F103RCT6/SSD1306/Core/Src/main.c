@@ -24,6 +24,7 @@
 /* USER CODE BEGIN Includes */
 
 #include "oled.h"
+#include "oled_bench.h"
 
 /* USER CODE END Includes */
 
@@ -35,6 +36,11 @@
 /* Private define ------------------------------------------------------------*/
 /* USER CODE BEGIN PD */
 
+// 1: measure the number display functions with the DWT cycle counter and show the result before the demo
+#ifndef OLED_DEMO_BENCH
+#define OLED_DEMO_BENCH  0
+#endif
+
 /* USER CODE END PD */
 
 /* Private macro -------------------------------------------------------------*/
@@ -93,6 +99,19 @@ int main(void)
   // Initialize OLED screen module
   OLED_Init();
 
+#if OLED_DEMO_BENCH
+  {
+    OLED_NumberBench_t bench;
+
+    // Count the cycles of OLED_ShowFloatNum, OLED_ShowFixed and OLED_ShowFloat, and show them for 5000ms
+    OLED_BenchNumbers(&bench);
+    OLED_BenchShowNumbers(&bench);
+    OLED_Update();
+    HAL_Delay(5000);
+    OLED_Clear();
+  }
+#endif
+
   // Display the character 'A' at position (0, 0) with a font size of 8x16 dots
   OLED_ShowChar(0, 0, 'A', OLED_8X16);
 
@@ -118,7 +137,7 @@ int main(void)
   OLED_ShowBinNum(0, 38, 0xA5, 8, OLED_6X8);
 
   // Display the floating-point number 123.45 at position (60, 38) with an integer part length of 3, a fractional part length of 2, and a font size of 6x8 dots
-  OLED_ShowFloatNum(60, 38, 123.45, 3, 2, OLED_6X8);
+  OLED_ShowFloat(60, 38, 123.45f, 3, 2, OLED_6X8);
 
   // Display the English and Chinese string "Hello,世界。" at position (0, 48), supporting mixed English and Chinese text
   OLED_ShowString(0, 48, "Hello,世界。", OLED_8X16);
@@ -1,8 +1,8 @@
 /* Includes ------------------------------------------------------------------*/
 
 #include <math.h>
-#include <stdio.h>
 #include <stdarg.h>
+#include <stddef.h>
 #include <string.h>
 #include "oled_data.h"
 #include "oled.h"
@@ -15,6 +15,90 @@
 #define OLED_W_SCL(x) HAL_GPIO_WritePin(GPIOB, SCL_Pin, (GPIO_PinState)(x))
 #define OLED_W_SDA(x) HAL_GPIO_WritePin(GPIOB, SDA_Pin, (GPIO_PinState)(x))
 
+/* Number of glyphs resolved at once by the text run renderer of the strings and OLED_Printf,
+   the stack use is 8 bytes per glyph */
+#ifndef OLED_RUN_GLYPHS
+#define OLED_RUN_GLYPHS  24
+#endif
+
+#if OLED_USE_BITBAND
+/* Each bit of the SRAM region [0x20000000,0x200FFFFF] is mapped to a word in the alias region starting at 0x22000000 */
+#define OLED_BITBAND_SRAM_REF   0x20000000UL
+#define OLED_BITBAND_SRAM_BASE  0x22000000UL
+#define OLED_BITBAND_ALIAS(addr) (OLED_BITBAND_SRAM_BASE + ((OLED_BITBAND_SRAM_ADDR(addr) - OLED_BITBAND_SRAM_REF) << 5))
+
+/* SRAM address of a byte and access to an alias word, a host test replaces them with an emulation of the bit-band region */
+#ifndef OLED_BITBAND_SRAM_ADDR
+#define OLED_BITBAND_SRAM_ADDR(ptr)     ((uint32_t)(uintptr_t)(ptr))
+#endif
+#ifndef OLED_BITBAND_STORE
+#define OLED_BITBAND_STORE(alias, bit)  (*(volatile uint32_t *)(uintptr_t)(alias) = (bit))
+#endif
+#ifndef OLED_BITBAND_LOAD
+#define OLED_BITBAND_LOAD(alias)        (*(volatile uint32_t *)(uintptr_t)(alias))
+#endif
+
+/* Alias word address of the pixel (x, y) of the drawing target, the byte offset is (y / 8) * width + x and the bit number is y % 8.
+   The OLED display memory array is at a fixed address and its width is a power of two, so the screen needs neither
+   the alias of the target nor a multiplication, only other surfaces use the variable base and stride */
+#define OLED_BITBAND_SCREEN_ALIAS  (OLED_BITBAND_SRAM_BASE + ((OLED_DISPLAYBUF_ADDR - OLED_BITBAND_SRAM_REF) << 5))
+#define OLED_BITBAND_SCREEN_PIXEL(x, y) \
+  (OLED_BITBAND_SCREEN_ALIAS + ((((uint32_t)((y) / 8) << OLED_ScreenShift) + (uint32_t)(x)) << 5) + (((uint32_t)(y) % 8) << 2))
+#define OLED_BITBAND_SURFACE_PIXEL(x, y) \
+  (OLED_TargetAlias + (((uint32_t)((y) / 8) * OLED_Target->width + (uint32_t)(x)) << 5) + (((uint32_t)(y) % 8) << 2))
+#define OLED_BITBAND_PIXEL(x, y) \
+  ((OLED_Target == &OLED_Screen) ? OLED_BITBAND_SCREEN_PIXEL(x, y) : OLED_BITBAND_SURFACE_PIXEL(x, y))
+#endif
+
+/* Data Type Definitions -----------------------------------------------------*/
+
+#if OLED_GLYPH_CACHE_SLOTS > 0
+/* Slot of the glyph cache, a glyph shifted down by 1 to 7 rows and split into the page bytes it covers */
+typedef struct
+{
+	const uint8_t *glyph;  // The glyph data in the font library, NULL: empty slot
+	uint8_t width, height;
+	uint8_t shift;         // y % 8 of the glyph
+	uint16_t used;         // Stamp of the last use, the least recently used slot is replaced
+	uint8_t data[OLED_GLYPH_CACHE_SLOT_SIZE];  // (height + 7) / 8 + 1 pages of width bytes each
+} OLED_GlyphSlot_t;
+#endif
+
+/* Glyph of a text run, resolved before the run is drawn */
+typedef struct
+{
+	const uint8_t *glyph;  // The glyph data in page format, or already shifted in a glyph cache slot
+	int16_t x;             // The x-coordinate of the glyph on the drawing target
+	uint8_t width, height;
+} OLED_RunGlyph_t;
+
+/* Text run being drawn, its glyphs are collected and drawn in batches of up to OLED_RUN_GLYPHS */
+typedef struct
+{
+	OLED_RunGlyph_t glyphs[OLED_RUN_GLYPHS];
+	int16_t x;          // The x-coordinate of the next glyph
+	int16_t page;       // The page of the top row of the text
+	uint8_t shift;      // The y-offset of the text within that page
+	uint8_t font_size;
+	uint8_t count;      // Number of glyphs of the batch
+	uint8_t pages;      // Number of pages covered by the batch
+	uint8_t lookups;    // Number of glyph cache slots the batch took glyphs from
+} OLED_Run_t;
+
+/* Conversion specification of OLED_Printf, like "%-08.2k" */
+typedef struct
+{
+	uint8_t left;       // '-' flag, pad with trailing spaces
+	uint8_t zero;       // '0' flag, pad with leading zeros
+	uint8_t alt;        // '#' flag, "0x" or "0X" before nonzero hexadecimal numbers
+	char sign;          // '+' or ' ' flag, the character before positive numbers, 0: none
+	uint8_t width;      // Minimum number of characters
+	int16_t precision;  // Minimum digits of integers, digits after the point of %k, maximum characters of %s, -1: not given
+} OLED_PrintSpec_t;
+
+/* Whether a glyph at a y-coordinate that is not a multiple of 8 fits into a glyph cache slot */
+#define OLED_GLYPH_CACHEABLE(width, height)  ((((height) + 7) / 8 + 1) * (width) <= OLED_GLYPH_CACHE_SLOT_SIZE)
+
 /* Global Variables ----------------------------------------------------------*/
 
 /**
@@ -23,8 +107,60 @@
  * @note All display functions only read from or write to this display memory array.
  * 			 Subsequently, calling the OLED_Update function or the OLED_UpdateArea function
  * 			 will send the data in the display memory array to the OLED hardware for display.
+ *       On the Cortex-M3 core the array is placed in the .oled_buf section at OLED_DISPLAYBUF_ADDR,
+ *       so that every pixel can be accessed through its bit-band alias word.
+ *       The section is NOLOAD, the startup code zero-fills it like the bss segment.
  */
+#if OLED_USE_BITBAND
+uint8_t OLED_DisplayBuf[8][128] __attribute__((section(".oled_buf"), aligned(4)));
+#else
 uint8_t OLED_DisplayBuf[8][128];
+#endif
+
+/**
+ * @brief  Surface wrapping the OLED display memory array
+ */
+OLED_Surface_t OLED_Screen = {&OLED_DisplayBuf[0][0], 128, 64};
+
+/**
+ * @brief  Current drawing target
+ * 
+ * @note   All display and draw geometry functions (except the update functions) draw on this target.
+ *         It is the OLED_Screen by default, use OLED_SetTarget to draw on an off-screen surface.
+ */
+static OLED_Surface_t *OLED_Target = &OLED_Screen;
+
+/**
+ * @brief  Display rotation
+ * 
+ * @note   OLED_ROTATION_0 and OLED_ROTATION_180 only change the segment re-map and COM scan direction of the OLED hardware.
+ *         OLED_ROTATION_90 and OLED_ROTATION_270 make the OLED_Screen 64 pixels wide and 128 pixels high,
+ *         and the update functions transpose it in 8*8 blocks, the rest of the rotation is done by the hardware mirroring.
+ */
+static uint8_t OLED_Rotation = OLED_ROTATION_0;
+
+/* Whether OLED_Init has configured the OLED hardware, before that OLED_SetRotation only records the rotation */
+static uint8_t OLED_Initialized = 0;
+
+#if OLED_GLYPH_CACHE_SLOTS > 0
+/**
+ * @brief  Glyph cache
+ *
+ * @note   The key of a slot is the address of the glyph in the font library and its shift,
+ *         the content only depends on the glyph, so it stays valid for every drawing target and position.
+ */
+static OLED_GlyphSlot_t OLED_GlyphCache[OLED_GLYPH_CACHE_SLOTS];
+static uint16_t OLED_GlyphCacheClock = 0;
+#endif
+static uint32_t OLED_GlyphCacheHits = 0, OLED_GlyphCacheMisses = 0;
+
+#if OLED_USE_BITBAND
+/* Bit-band alias address of the first byte of the drawing target, used when it is not the OLED_Screen */
+static uint32_t OLED_TargetAlias = OLED_BITBAND_SCREEN_ALIAS;
+
+/* log2 of the OLED_Screen width, 7 or 6 when rotated by 90 or 270 degrees */
+static uint8_t OLED_ScreenShift = 7;
+#endif
 
 /* Software-emulated I2C Communication Functions -----------------------------*/
 
@@ -197,6 +333,37 @@ uint8_t OLED_IsInAngle(int16_t x, int16_t y, int16_t start_angle, int16_t end_an
 
 /* OLED Screen Hardware Configuration Functions ------------------------------*/
 
+/**
+ * @brief  Write the segment re-map and COM output scan direction of the current rotation
+ * @param  None
+ * @retval None
+ */
+static void OLED_WriteRotation(void)
+{
+	switch (OLED_Rotation)
+	{
+		case OLED_ROTATION_90:   // Transposed, mirrored by the segment re-map
+			OLED_WriteCommand(0xA0);
+			OLED_WriteCommand(0xC8);
+			break;
+
+		case OLED_ROTATION_180:  // Both axes mirrored
+			OLED_WriteCommand(0xA0);
+			OLED_WriteCommand(0xC0);
+			break;
+
+		case OLED_ROTATION_270:  // Transposed, mirrored by the COM scan direction
+			OLED_WriteCommand(0xA1);
+			OLED_WriteCommand(0xC0);
+			break;
+
+		default:  // Normal
+			OLED_WriteCommand(0xA1);
+			OLED_WriteCommand(0xC8);
+			break;
+	}
+}
+
 /**
  * @brief  Initialize the OLED screen
  * @param  None
@@ -221,9 +388,7 @@ void OLED_Init(void)
 
   OLED_WriteCommand(0x40);  // Set display start line
 
-  OLED_WriteCommand(0xA1);  // Set segment re-map (normal)
-
-  OLED_WriteCommand(0xC8);  // Set COM output scan direction (normal)
+  OLED_WriteRotation();  // Set segment re-map and COM output scan direction
 
   OLED_WriteCommand(0xDA);  // Set COM pins hardware configuration
   OLED_WriteCommand(0x12);
@@ -246,10 +411,49 @@ void OLED_Init(void)
 
   OLED_WriteCommand(0xAF);  // Turn on OLED panel
 
+  OLED_Initialized = 1;  // OLED_SetRotation writes the hardware from now on
+
   OLED_Clear();  // Clear the OLED screen
   OLED_Update();
 }
 
+/**
+ * @brief  Set the display rotation
+ * @param  rotation The clockwise rotation of the content, range: OLED_ROTATION_0, OLED_ROTATION_90, OLED_ROTATION_180 or OLED_ROTATION_270
+ * @retval None
+ * @note   With OLED_ROTATION_90 and OLED_ROTATION_270 the screen is 64 pixels wide and 128 pixels high,
+ *         the x-coordinate range is [0,63] and the y-coordinate range is [0,127].
+ *         The OLED display memory array is cleared, the content must be drawn again and updated.
+ *         Other values are ignored and keep the current rotation.
+ *         It can be called before OLED_Init, which then sends the rotation to the OLED hardware,
+ *         afterwards the segment re-map and COM scan direction are sent at once.
+ */
+void OLED_SetRotation(uint8_t rotation)
+{
+	if (rotation > OLED_ROTATION_270) {return;}
+	OLED_Rotation = rotation;
+
+	if (rotation == OLED_ROTATION_90 || rotation == OLED_ROTATION_270)
+	{
+		OLED_Screen.width = 64;
+		OLED_Screen.height = 128;
+	}
+	else
+	{
+		OLED_Screen.width = 128;
+		OLED_Screen.height = 64;
+	}
+#if OLED_USE_BITBAND
+	OLED_ScreenShift = (OLED_Screen.width == 64) ? 6 : 7;
+#endif
+
+	memset(OLED_DisplayBuf, 0x00, sizeof(OLED_DisplayBuf));
+	if (OLED_Initialized)  // The I2C pins are not configured before OLED_Init
+	{
+		OLED_WriteRotation();
+	}
+}
+
 /**
  * @brief  Set the display cursor position on the OLED
  * @param  page The page where the cursor is located, range: [0,7]
@@ -265,8 +469,235 @@ void OLED_SetCursor(uint8_t page, uint8_t x)
 	OLED_WriteCommand(0x00 | (x & 0x0F));			    // Set the low 4 bits of the x position
 }
 
+/* OLED Glyph Cache Functions -----------------------------------------------*/
+
+/**
+ * @brief  Empty the glyph cache and reset its counters
+ * @param  None
+ * @retval None
+ * @note   Only needed when glyph data in RAM changes, the glyphs of the font libraries in flash never do.
+ */
+void OLED_GlyphCacheClear(void)
+{
+#if OLED_GLYPH_CACHE_SLOTS > 0
+	uint8_t i;
+
+	for (i = 0; i < OLED_GLYPH_CACHE_SLOTS; i++)
+	{
+		OLED_GlyphCache[i].glyph = NULL;
+	}
+	OLED_GlyphCacheClock = 0;
+#endif
+	OLED_GlyphCacheHits = 0;
+	OLED_GlyphCacheMisses = 0;
+}
+
+/**
+ * @brief  Get the counters of the glyph cache
+ * @param  hits Returns the number of glyphs drawn from the cache
+ * @param  misses Returns the number of glyphs that had to be shifted into a slot first
+ * @retval None
+ * @note   Glyphs at page-aligned y-coordinates, scaled glyphs and glyphs larger than a slot bypass the cache
+ *         and are not counted.
+ */
+void OLED_GlyphCacheStats(uint32_t *hits, uint32_t *misses)
+{
+	*hits = OLED_GlyphCacheHits;
+	*misses = OLED_GlyphCacheMisses;
+}
+
+#if OLED_GLYPH_CACHE_SLOTS > 0
+/**
+ * @brief  Find a shifted glyph in the glyph cache, shifting it into the least recently used slot if it is missing
+ * @param  glyph The glyph data in page format
+ * @param  width The width of the glyph
+ * @param  height The height of the glyph
+ * @param  shift The y-offset of the glyph within its first page, range: [1,7]
+ * @retval The slot holding the shifted glyph
+ */
+static const OLED_GlyphSlot_t *OLED_GlyphCacheGet(const uint8_t *glyph, uint8_t width, uint8_t height, uint8_t shift)
+{
+	OLED_GlyphSlot_t *slot, *victim = &OLED_GlyphCache[0];
+	uint8_t pages = (height + 7) / 8, i, j;
+	uint8_t *dst;
+
+	for (i = 0; i < OLED_GLYPH_CACHE_SLOTS; i++)
+	{
+		slot = &OLED_GlyphCache[i];
+		if (slot->glyph == glyph && slot->shift == shift && slot->width == width && slot->height == height)
+		{
+			slot->used = ++OLED_GlyphCacheClock;
+			OLED_GlyphCacheHits++;
+			return slot;
+		}
+
+		/* Empty slots first, otherwise the one unused for the longest time, the clock may wrap around */
+		if (victim->glyph != NULL &&
+		    (slot->glyph == NULL || (uint16_t)(OLED_GlyphCacheClock - slot->used) > (uint16_t)(OLED_GlyphCacheClock - victim->used)))
+		{
+			victim = slot;
+		}
+	}
+
+	/* Split every byte of the glyph into the part in its own page and the part in the next page */
+	victim->glyph = glyph;
+	victim->width = width;
+	victim->height = height;
+	victim->shift = shift;
+	victim->used = ++OLED_GlyphCacheClock;
+	OLED_GlyphCacheMisses++;
+
+	dst = victim->data;
+	for (j = 0; j <= pages; j++)
+	{
+		for (i = 0; i < width; i++)
+		{
+			*dst++ = ((j < pages) ? glyph[j * width + i] << shift : 0) |
+			         ((j > 0) ? glyph[(j - 1) * width + i] >> (8 - shift) : 0);
+		}
+	}
+	return victim;
+}
+#endif
+
+/**
+ * @brief  Display a glyph of a font library, like OLED_ShowImageScaled
+ * @param  x The x-coordinate of the top-left corner of the glyph, range: [-32768,32767], screen area: [0,127]
+ * @param  y The y-coordinate of the top-left corner of the glyph, range: [-32768,32767], screen area: [0,63]
+ * @param  width The width of the glyph
+ * @param  height The height of the glyph
+ * @param  glyph The glyph data in page format, it must not change while it may be in the glyph cache
+ * @param  scale The enlargement factor, range: [1,4]
+ * @retval None
+ * @note   An unscaled glyph at a y-coordinate that is not a multiple of 8 is taken from the glyph cache already shifted,
+ *         each page byte is then written once with a mask instead of being cleared and shifted bit by bit.
+ */
+static void OLED_ShowGlyph(int16_t x, int16_t y, uint8_t width, uint8_t height, const uint8_t *glyph, uint8_t scale)
+{
+#if OLED_GLYPH_CACHE_SLOTS > 0
+	const OLED_GlyphSlot_t *slot;
+	const uint8_t *src;
+	uint8_t *dst;
+	int16_t page, shift, pages, target_pages, top, bottom, i, j;
+	uint8_t mask;
+
+	/* A negative coordinate needs an offset when calculating the page address and shift */
+	page = y / 8;
+	shift = y % 8;
+	if (y < 0)
+	{
+		page -= 1;
+		shift += 8;
+	}
+	pages = (height + 7) / 8 + 1;
+
+	if (scale != 1 || shift == 0 || width == 0 || height == 0 || !OLED_GLYPH_CACHEABLE(width, height))
+	{
+		OLED_ShowImageScaled(x, y, width, height, glyph, scale);
+		return;
+	}
+
+	slot = OLED_GlyphCacheGet(glyph, width, height, shift);
+	target_pages = (OLED_Target->height + 7) / 8;
+
+	for (j = 0; j < pages; j++)
+	{
+		if (page + j < 0 || page + j >= target_pages) {continue;}  // Content outside the drawing target will not be displayed
+
+		/* The rows of the glyph in this page are cleared like OLED_ClearArea, only inside the drawing target */
+		top = (j == 0) ? shift : 0;
+		bottom = shift + height - j * 8;
+		if (bottom > 8) {bottom = 8;}
+		if ((page + j) * 8 + bottom > OLED_Target->height) {bottom = OLED_Target->height - (page + j) * 8;}
+		mask = (bottom > top) ? (uint8_t)((0xFF >> (8 - bottom)) & (0xFF << top)) : 0x00;
+
+		src = slot->data + j * width;
+		for (i = 0; i < width; i++)
+		{
+			if (x + i >= 0 && x + i < OLED_Target->width)
+			{
+				dst = &OLED_Target->buf[(page + j) * OLED_Target->width + x + i];
+				*dst = (*dst & ~mask) | src[i];
+			}
+		}
+	}
+#else
+	OLED_ShowImageScaled(x, y, width, height, glyph, scale);
+#endif
+}
+
 /* OLED Screen Display Functions ---------------------------------------------*/
 
+/**
+ * @brief  Transpose an 8*8 bit matrix
+ * @param  src 8 bytes, bit j of byte i is the element (i, j)
+ * @param  dst 8 bytes, receives the element (i, j) in bit i of byte j
+ * @retval None
+ * @note   The matrix is held in two 32-bit words and transposed by three delta swaps of 1*1, 2*2 and 4*4 blocks.
+ */
+static void OLED_Transpose8(const uint8_t *src, uint8_t *dst)
+{
+	uint32_t x, y, t;
+
+	x = src[0] | (src[1] << 8) | (src[2] << 16) | ((uint32_t)src[3] << 24);  // Elements of rows 0~3
+	y = src[4] | (src[5] << 8) | (src[6] << 16) | ((uint32_t)src[7] << 24);  // Elements of rows 4~7
+
+	/* Swap the elements (i, j) and (i + 1, j - 1) of the 2*2 blocks, they are 7 bits apart */
+	t = (x ^ (x >> 7)) & 0x00AA00AA; x ^= t ^ (t << 7);
+	t = (y ^ (y >> 7)) & 0x00AA00AA; y ^= t ^ (t << 7);
+
+	/* Swap the 2*2 blocks (i, j) and (i + 2, j - 2) of the 4*4 blocks, they are 14 bits apart */
+	t = (x ^ (x >> 14)) & 0x0000CCCC; x ^= t ^ (t << 14);
+	t = (y ^ (y >> 14)) & 0x0000CCCC; y ^= t ^ (t << 14);
+
+	/* Swap the 4*4 blocks (0, 4) and (4, 0) */
+	t = ((x >> 4) ^ y) & 0x0F0F0F0F; y ^= t; x ^= t << 4;
+
+	dst[0] = x; dst[1] = x >> 8; dst[2] = x >> 16; dst[3] = x >> 24;
+	dst[4] = y; dst[5] = y >> 8; dst[6] = y >> 16; dst[7] = y >> 24;
+}
+
+/**
+ * @brief  Partially update the OLED screen when it is rotated by 90 or 270 degrees
+ * @param  x The x-coordinate of the top-left corner of the specified area, screen area: [0,63]
+ * @param  y The y-coordinate of the top-left corner of the specified area, screen area: [0,127]
+ * @param  width The width of the specified area, range: [0,64]
+ * @param  height The height of the specified area, range: [0,128]
+ * @retval None
+ * @note   The x-axis of the screen is the page direction of the OLED hardware and the y-axis its column direction,
+ *         so 8 columns of a screen page become 8 bytes of a hardware page after transposing.
+ *         The area is extended to whole 8*8 blocks.
+ */
+static void OLED_UpdateAreaTransposed(int16_t x, int16_t y, int16_t width, int16_t height)
+{
+	int16_t page, page1, block, block0, block1;
+	uint8_t line[128];
+
+	/* Clip the area to the screen */
+	if (x < 0) {width += x; x = 0;}
+	if (y < 0) {height += y; y = 0;}
+	if (x + width > 64) {width = 64 - x;}
+	if (y + height > 128) {height = 128 - y;}
+	if (width <= 0 || height <= 0) {return;}
+
+	page1 = (x + width - 1) / 8;
+	block0 = y / 8;
+	block1 = (y + height - 1) / 8;
+
+	/* Iterate through the hardware pages, each one is 8 columns of the screen */
+	for (page = x / 8; page <= page1; page++)
+	{
+		/* Iterate through the blocks, each one is 8 columns of a screen page */
+		for (block = block0; block <= block1; block++)
+		{
+			OLED_Transpose8(&OLED_Screen.buf[block * 64 + page * 8], &line[block * 8]);
+		}
+
+		OLED_SetCursor(page, block0 * 8);
+		OLED_WriteData(&line[block0 * 8], (block1 - block0 + 1) * 8);
+	}
+}
+
 /**
  * @brief  Update the OLED screen with the display memory array
  * @param  None
@@ -280,6 +711,12 @@ void OLED_Update(void)
 {
 	uint8_t j;
 
+	if (OLED_Screen.width != 128)  // Rotated by 90 or 270 degrees
+	{
+		OLED_UpdateAreaTransposed(0, 0, OLED_Screen.width, OLED_Screen.height);
+		return;
+	}
+
 	/* Iterate through each page */
 	for (j = 0; j < 8; j++)
 	{
@@ -304,28 +741,32 @@ void OLED_Update(void)
 void OLED_UpdateArea(int16_t x, int16_t y, uint8_t width, uint8_t height)
 {
 	int16_t j;
-	int16_t page, page1;
-	
-	/* A negative coordinate needs an offset when calculating the page address */
-	page = y / 8;
-	page1 = (y + height - 1) / 8 + 1;  // It's equal to (y + height) / 8 rounded up
-	if (y < 0)
+	int16_t page, page1, x1, y1;
+
+	if (OLED_Screen.width != 128)  // Rotated by 90 or 270 degrees
 	{
-		page -= 1;
-		page1 -= 1;
+		OLED_UpdateAreaTransposed(x, y, width, height);
+		return;
 	}
 	
+	/* Clip the area to the screen, content outside the screen will not be displayed */
+	x1 = (x + width < 128) ? x + width : 128;
+	y1 = (y + height < 64) ? y + height : 64;
+	if (x < 0) {x = 0;}
+	if (y < 0) {y = 0;}
+	if (x >= x1 || y >= y1) {return;}
+	
+	page = y / 8;
+	page1 = (y1 + 7) / 8;  // It's equal to y1 / 8 rounded up
+	
 	/* Iterate through the pages involved in the specified area */
 	for (j = page; j < page1; j++)
 	{
-		if (x >= 0 && x <= 127 && j >= 0 && j <= 7)		// Content outside the screen will not be displayed
-		{
-			// Set the cursor position to the specified column of the relevant page
-			OLED_SetCursor(j, x);
+		// Set the cursor position to the specified column of the relevant page
+		OLED_SetCursor(j, x);
 
-			// Transfer the display memory array data to the OLED hardware by continuously writing data bytes
-			OLED_WriteData(&OLED_DisplayBuf[j][x], width);
-		}
+		// Transfer the display memory array data to the OLED hardware by continuously writing data bytes
+		OLED_WriteData(&OLED_DisplayBuf[j][x], x1 - x);
 	}
 }
 
@@ -336,18 +777,8 @@ void OLED_UpdateArea(int16_t x, int16_t y, uint8_t width, uint8_t height)
  */
 void OLED_Clear(void)
 {
-	uint8_t i, j;
-
-	/* Iterate through 8 pages */
-	for (j = 0; j < 8; j++)				
-	{
-		/* Iterate through 128 columns */
-		for (i = 0; i < 128; i++)			
-		{
-			// Clear all data in the display memory array
-			OLED_DisplayBuf[j][i] = 0x00;	
-		}
-	}
+	// Clear all data of the drawing target, (height + 7) / 8 pages of width bytes
+	memset(OLED_Target->buf, 0x00, OLED_SURFACE_SIZE(OLED_Target->width, OLED_Target->height));
 }
 
 /**
@@ -368,11 +799,15 @@ void OLED_ClearArea(int16_t x, int16_t y, uint8_t width, uint8_t height)
 		/* Iterate through the specified columns */
 		for (i = x; i < x + width; i++)	
 		{
-			// Content outside the screen will not be displayed
-			if (i >= 0 && i <= 127 && j >=0 && j <= 63)				
+			// Content outside the drawing target will not be displayed
+			if (i >= 0 && i < OLED_Target->width && j >= 0 && j < OLED_Target->height)
 			{
-				// Clear the specified data in the display memory array
-				OLED_DisplayBuf[j / 8][i] &= ~(0x01 << (j % 8));	
+				// Clear the specified data in the drawing target
+#if OLED_USE_BITBAND
+				OLED_BITBAND_STORE(OLED_BITBAND_PIXEL(i, j), 0);
+#else
+				OLED_Target->buf[j / 8 * OLED_Target->width + i] &= ~(0x01 << (j % 8));
+#endif
 			}
 		}
 	}
@@ -385,17 +820,15 @@ void OLED_ClearArea(int16_t x, int16_t y, uint8_t width, uint8_t height)
  */
 void OLED_Reverse(void)
 {
-	uint8_t i, j;
+	uint16_t i, size;
 
-	/* Iterate through 8 pages */
-	for (j = 0; j < 8; j++)				
+	size = OLED_SURFACE_SIZE(OLED_Target->width, OLED_Target->height);
+
+	/* Iterate through all bytes of the drawing target */
+	for (i = 0; i < size; i++)
 	{
-		/* Iterate through 128 columns */
-		for (i = 0; i < 128; i++)			
-		{
-			// Invert all data in the display memory array
-			OLED_DisplayBuf[j][i] ^= 0xFF;	
-		}
+		// Invert all data in the drawing target
+		OLED_Target->buf[i] ^= 0xFF;
 	}
 }
 
@@ -417,244 +850,655 @@ void OLED_ReverseArea(int16_t x, int16_t y, uint8_t width, uint8_t height)
 		/* Iterate through the specified columns */
 		for (i = x; i < x + width; i++)	
 		{
-			// Content outside the screen will not be displayed
-			if (i >= 0 && i <= 127 && j >=0 && j <= 63)				
+			// Content outside the drawing target will not be displayed
+			if (i >= 0 && i < OLED_Target->width && j >= 0 && j < OLED_Target->height)
 			{
-				// Invert the specified data in the display memory array
-				OLED_DisplayBuf[j / 8][i] ^= 0x01 << (j % 8);	
+				// Invert the specified data in the drawing target
+				OLED_Target->buf[j / 8 * OLED_Target->width + i] ^= 0x01 << (j % 8);
 			}
 		}
 	}
 }
 
 /**
- * @brief  Display a character on the OLED
- * @param  x The x-coordinate of the top-left corner of the character, range: [-32768,32767], screen area: [0,127]
- * @param  y The y-coordinate of the top-left corner of the character, range: [-32768,32767], screen area: [0,63]
- * @param  character The character to display, range: visible ASCII characters
- * @param  font_size The font size, range: OLED_8X16 (8 pixels wide, 16 pixels high) or OLED_6X8 (6 pixels wide, 8 pixels high)
- * @retval None
+ * @brief  Decode the next character of a UTF-8 string
+ * @param  str The position in the string, it is moved past the character
+ * @retval The Unicode codepoint of the character, 0: the end of the string or an incomplete character
+ * @note   Bytes that cannot start a character are skipped. A character with an invalid continuation byte
+ *         is consumed as a whole and decoded as U+FFFD, which is then shown as the default figure.
  */
-void OLED_ShowChar(int16_t x, int16_t y, char character, uint8_t font_size)
+uint32_t OLED_DecodeUTF8(const char **str)
+{
+	const uint8_t *p = (const uint8_t *)*str;
+	uint32_t code;
+	uint8_t length, i, valid = 1;
+
+	/* Find a byte that starts a character, the flag bits of the first byte give its length */
+	while (1)
+	{
+		if (*p < 0x80)  // The first byte is 0xxxxxxx, including the end of the string
+		{
+			*str = (const char *)(*p != '\0' ? p + 1 : p);
+			return *p;
+		}
+		if ((*p & 0xE0) == 0xC0) {length = 2; code = *p & 0x1F; break;}  // 110xxxxx
+		if ((*p & 0xF0) == 0xE0) {length = 3; code = *p & 0x0F; break;}  // 1110xxxx
+		if ((*p & 0xF8) == 0xF0) {length = 4; code = *p & 0x07; break;}  // 11110xxx
+		p++;  // Unexpected byte, ignore it and check the next byte
+	}
+
+	/* Each continuation byte 10xxxxxx adds 6 bits */
+	for (i = 1; i < length; i++)
+	{
+		if (p[i] == '\0')  // Unexpected end of the string, end the display
+		{
+			*str = (const char *)(p + i);
+			return 0;
+		}
+		if ((p[i] & 0xC0) != 0x80) {valid = 0;}
+		code = (code << 6) | (p[i] & 0x3F);
+	}
+	*str = (const char *)(p + length);
+	return valid ? code : 0xFFFD;
+}
+
+/**
+ * @brief  Decode the next character of a GB2312 string
+ * @param  str The position in the string, it is moved past the character
+ * @retval The ASCII code, or the 2-byte code of a Chinese character as (first byte << 8) | second byte,
+ *         0: the end of the string or an incomplete character
+ */
+uint32_t OLED_DecodeGB2312(const char **str)
 {
-	if (font_size == OLED_8X16)		// Font size is 8 pixels wide and 16 pixels high
+	const uint8_t *p = (const uint8_t *)*str;
+
+	if (*p < 0x80)  // The highest bit is 0, a 1-byte character or the end of the string
 	{
-		// Display the specified data from the ASCII font library OLED_F8x16 in an 8*16 image format
-		OLED_ShowImage(x, y, 8, 16, OLED_F8x16[character - ' ']);
+		*str = (const char *)(*p != '\0' ? p + 1 : p);
+		return *p;
 	}
-	else if(font_size == OLED_6X8)	// Font size is 6 pixels wide and 8 pixels high
+	if (p[1] == '\0')  // Unexpected end of the string, end the display
 	{
-		// Display the specified data from the ASCII font library OLED_F6x8 in a 6*8 image format
-		OLED_ShowImage(x, y, 6, 8, OLED_F6x8[character - ' ']);
+		*str = (const char *)(p + 1);
+		return 0;
 	}
+	*str = (const char *)(p + 2);
+	return ((uint32_t)p[0] << 8) | p[1];
 }
 
 /**
- * @brief  Display a string on the OLED
- * @param  x The x-coordinate of the top-left corner of the string, range: [-32768,32767], screen area: [0,127]
- * @param  y The y-coordinate of the top-left corner of the string, range: [-32768,32767], screen area: [0,63]
- * @param  str The string to display, consisting of visible ASCII characters or Chinese characters
- * @param  font_size The font size, range: OLED_8X16 (8 pixels wide, 16 pixels high) or OLED_6X8 (6 pixels wide, 8 pixels high)
- * @retval None
- * @note   This function supports mixed input of ASCII and Chinese characters.
- *         Chinese characters to be displayed need to be defined in the OLED_CF16x16 array in oled_data.c file.
- *         If a specified Chinese character is not found, a default graphic (a box with a question mark inside) will be displayed.
- *         When the font size is OLED_8X16, Chinese characters are displayed normally in a 16*16 dot matrix.
- *         When the font size is OLED_6X8, Chinese characters are displayed as '?' in a 6*8 dot matrix.
+ * @brief  Decode the next character of a string in the character set of the font library
+ * @param  str The position in the string, it is moved past the character
+ * @retval The codepoint of the character, 0: the end of the string or an incomplete character
+ * @note   The character set is selected by OLED_CHARSET in oled_data.h.
  */
-void OLED_ShowString(int16_t x, int16_t y, char *str, uint8_t font_size)
+uint32_t OLED_DecodeChar(const char **str)
 {
-	uint16_t i = 0;
-	char single_char[5];
-	uint8_t char_length = 0;
-	uint16_t x_offset = 0;
-	uint16_t p_index;
-	
-	/* Iterate through the string */
-	while (str[i] != '\0')	
-	{
-#ifdef OLED_CHARSET_UTF8  // Define the character set as UTF-8
-		/* The purpose of this code is to extract a character from the UTF-8 string and store it in the single_char substring */
-		/* Check the flag bit of the first byte of the UTF-8 encoding */
-		if ((str[i] & 0x80) == 0x00)  // The first byte is 0xxxxxxx
-		{
-			char_length = 1;						// The character is 1 byte long
-			single_char[0] = str[i++];  // Write the first byte to the 0th position of single_char, then move i to the next byte
-			single_char[1] = '\0';			// Add a string termination flag to single_char
-		}
-		else if ((str[i] & 0xE0) == 0xC0)  // The first byte is 110xxxxx
-		{
-			char_length = 2;						     // The character is 2 bytes long
-			single_char[0] = str[i++];		   // Write the first byte to the 0th position of single_char, then move i to the next byte
-			if (str[i] == '\0') {break;}		 // Unexpected situation, break the loop and end the display
-			single_char[1] = str[i++];		   // Write the second byte to the 1st position of single_char, then move i to the next byte
-			single_char[2] = '\0';				   // Add a string termination flag to single_char
-		}
-		else if ((str[i] & 0xF0) == 0xE0)	 // The first byte is 1110xxxx
-		{
-			char_length = 3;						     // The character is 3 bytes long
-			single_char[0] = str[i++];
-			if (str[i] == '\0') {break;}
-			single_char[1] = str[i++];
-			if (str[i] == '\0') {break;}
-			single_char[2] = str[i++];
-			single_char[3] = '\0';
-		}
-		else if ((str[i] & 0xF8) == 0xF0)	// The first byte is 11110xxx
-		{
-			char_length = 4;						    // The character is 4 bytes long
-			single_char[0] = str[i++];
-			if (str[i] == '\0') {break;}
-			single_char[1] = str[i++];
-			if (str[i] == '\0') {break;}
-			single_char[2] = str[i++];
-			if (str[i] == '\0') {break;}
-			single_char[3] = str[i++];
-			single_char[4] = '\0';
-		}
-		else
-		{
-			i++;  // Unexpected situation, move i to the next byte, ignore this byte and continue to check the next byte
-			continue;
-		}
+#ifdef OLED_CHARSET_GB2312
+	return OLED_DecodeGB2312(str);
+#else
+	return OLED_DecodeUTF8(str);
 #endif
-#ifdef OLED_CHARSET_GB2312  // Define the character set as GB2312
-		/* The purpose of this code is to extract a character from the GB2312 string and store it in the single_char substring */
-		/* Check the highest bit flag of the GB2312 byte */
-		if ((str[i] & 0x80) == 0x00)  // The highest bit is 0
-		{
-			char_length = 1;						// The character is 1 byte long
-			single_char[0] = str[i++];	// Write the first byte to the 0th position of single_char, then move i to the next byte
-			single_char[1] = '\0';			// Add a string termination flag to single_char
-		}
-		else  // The highest bit is 1
+}
+
+/**
+ * @brief  Find the glyph of a character in a font
+ * @param  font_size The font, OLED_8X16 (ASCII 8*16 and Chinese characters 16*16) or OLED_6X8 (ASCII 6*8)
+ * @param  code The codepoint of the character, as returned by OLED_DecodeChar
+ * @param  width Returns the width of the glyph in pixels
+ * @param  height Returns the height of the glyph in pixels
+ * @retval The glyph data in page format, the default figure of the font if the character is not covered
+ * @note   Dense ranges like ASCII are addressed directly, sparse ranges like the Chinese font library
+ *         are searched in their sorted index, so the lookup time does not grow with the font library.
+ */
+const uint8_t *OLED_GetGlyph(uint8_t font_size, uint32_t code, uint8_t *width, uint8_t *height)
+{
+	const OLED_Font_t *font = (font_size == OLED_6X8) ? &OLED_Font6x8 : &OLED_Font8x16;
+	const OLED_FontRange_t *range;
+	uint16_t low, high, middle;
+	uint8_t i;
+
+	for (i = 0; i < font->range_count; i++)
+	{
+		range = &font->ranges[i];
+		if (code < range->first || code > range->last) {continue;}
+
+		if (range->index == NULL)  // Every codepoint of the range has a glyph
 		{
-			char_length = 2;						  // The character is 2 bytes long
-			single_char[0] = str[i++];		// Write the first byte to the 0th position of single_char, then move i to the next byte
-			if (str[i] == '\0') {break;}  // Unexpected situation, break the loop and end the display
-			single_char[1] = str[i++];		// Write the second byte to the 1st position of single_char, then move i to the next byte
-			single_char[2] = '\0';				// Add a string termination flag to single_char
+			*width = range->width;
+			*height = range->height;
+			return range->glyphs + (code - range->first) * range->stride;
 		}
-#endif
-		/* Display the single_char extracted by the above code */
-		if (char_length == 1)  // If it is a single-byte character
+
+		/* Binary search for the codepoint in the index */
+		low = 0;
+		high = range->index_size;
+		while (low < high)
 		{
-			// Use OLED_ShowChar to display this character
-			OLED_ShowChar(x + x_offset, y, single_char[0], font_size);
-			x_offset += font_size;
+			middle = (low + high) / 2;
+			if (range->index[middle].code < code) {low = middle + 1;}
+			else {high = middle;}
 		}
-		else // Otherwise, it is a multi-byte character
+		if (low < range->index_size && range->index[low].code == code)
 		{
-			// Iterate through the entire font library to find the data of this character
-			// If the last character (defined as an empty string) is found, it means the character is not defined in the font library, stop searching
-			for (p_index = 0; strcmp(OLED_CF16x16[p_index].index, "") != 0; p_index++)
-			{
-				// Find a matching character
-				if (strcmp(OLED_CF16x16[p_index].index, single_char) == 0)
-				{
-					break;  // Break the loop, at this time the value of p_index is the index of the specified character
-				}
-			}
-			if (font_size == OLED_8X16)		// The given font is 8*16 dots
-			{
-				// Display the specified data from the font library OLED_CF16x16 in a 16*16 image format
-				OLED_ShowImage(x + x_offset, y, 16, 16, OLED_CF16x16[p_index].data);
-				x_offset += 16;
-			}
-			else if (font_size == OLED_6X8)	 // The given font is 6*8 dots
-			{
-				// Insufficient space, display '?' at this position
-				OLED_ShowChar(x + x_offset, y, '?', OLED_6X8);
-				x_offset += OLED_6X8;
-			}
+			*width = range->width;
+			*height = range->height;
+			return range->glyphs + range->index[low].cell * range->stride;
 		}
 	}
+
+	*width = font->missing_width;
+	*height = font->missing_height;
+	return font->missing;
 }
 
 /**
- * @brief  Display a positive decimal integer on the OLED
- * @param  x The x-coordinate of the top-left corner of the number, range: [-32768,32767], screen area: [0,127]
- * @param  y The y-coordinate of the top-left corner of the number, range: [-32768,32767], screen area: [0,63]
- * @param  number The number to display, range: [0,4294967295]
- * @param  length The length of the number, range: [0,10]
+ * @brief  Display a character on the OLED
+ * @param  x The x-coordinate of the top-left corner of the character, range: [-32768,32767], screen area: [0,127]
+ * @param  y The y-coordinate of the top-left corner of the character, range: [-32768,32767], screen area: [0,63]
+ * @param  character The character to display, range: visible ASCII characters
  * @param  font_size The font size, range: OLED_8X16 (8 pixels wide, 16 pixels high) or OLED_6X8 (6 pixels wide, 8 pixels high)
  * @retval None
  */
-void OLED_ShowNum(int16_t x, int16_t y, uint32_t number, uint8_t length, uint8_t font_size)
+void OLED_ShowChar(int16_t x, int16_t y, char character, uint8_t font_size)
 {
-	uint8_t i;
-	
-  /* Iterate through each digit of the number */
-	for (i = 0; i < length; i++)		
-	{
-		// number / OLED_Pow(10, length - i - 1) % 10 extracts each decimal digit of the number
-		// Adding '0' converts the number to a character format
-		OLED_ShowChar(x + i * font_size, y, number / OLED_Pow(10, length - i - 1) % 10 + '0', font_size);
-	}
+	OLED_ShowCharScaled(x, y, character, font_size, 1);
 }
 
 /**
- * @brief  Display a signed decimal integer on the OLED
- * @param  x The x-coordinate of the top-left corner of the number, range: [-32768,32767], screen area: [0,127]
- * @param  y The y-coordinate of the top-left corner of the number, range: [-32768,32767], screen area: [0,63]
- * @param  number The number to display, range: [-2147483648,2147483647]
- * @param  length The length of the number, range: [0,10]
+ * @brief  Display a character enlarged by an integer factor on the OLED
+ * @param  x The x-coordinate of the top-left corner of the character, range: [-32768,32767], screen area: [0,127]
+ * @param  y The y-coordinate of the top-left corner of the character, range: [-32768,32767], screen area: [0,63]
+ * @param  character The character to display, range: visible ASCII characters
  * @param  font_size The font size, range: OLED_8X16 (8 pixels wide, 16 pixels high) or OLED_6X8 (6 pixels wide, 8 pixels high)
+ * @param  scale The enlargement factor, the character takes font_size * scale columns, range: [1,4]
  * @retval None
  */
-void OLED_ShowSignedNum(int16_t x, int16_t y, int32_t number, uint8_t length, uint8_t font_size)
+void OLED_ShowCharScaled(int16_t x, int16_t y, char character, uint8_t font_size, uint8_t scale)
 {
-	uint8_t i;
-	uint32_t number1;
-	
-	if (number >= 0)  // If the number is greater than or equal to 0
+	const uint8_t *glyph;
+	uint8_t width, height;
+
+	// Display the glyph of the character from the font of this size
+	glyph = OLED_GetGlyph(font_size, (uint8_t)character, &width, &height);
+	OLED_ShowGlyph(x, y, width, height, glyph, scale);
+}
+
+/**
+ * @brief  Display a string on the OLED
+ * @param  x The x-coordinate of the top-left corner of the string, range: [-32768,32767], screen area: [0,127]
+ * @param  y The y-coordinate of the top-left corner of the string, range: [-32768,32767], screen area: [0,63]
+ * @param  str The string to display, consisting of visible ASCII characters or Chinese characters
+ * @param  font_size The font size, range: OLED_8X16 (8 pixels wide, 16 pixels high) or OLED_6X8 (6 pixels wide, 8 pixels high)
+ * @retval None
+ * @note   This function supports mixed input of ASCII and Chinese characters.
+ *         Chinese characters to be displayed need to be defined in the OLED_CF16x16 array in oled_data.c file.
+ *         If a specified Chinese character is not found, a default graphic (a box with a question mark inside) will be displayed.
+ *         When the font size is OLED_8X16, Chinese characters are displayed normally in a 16*16 dot matrix.
+ *         When the font size is OLED_6X8, Chinese characters are displayed as '?' in a 6*8 dot matrix.
+ */
+void OLED_ShowString(int16_t x, int16_t y, char *str, uint8_t font_size)
+{
+	OLED_ShowStringScaled(x, y, str, font_size, 1);
+}
+
+/**
+ * @brief  Start a run of text on the OLED
+ * @param  run The run
+ * @param  x The x-coordinate of the top-left corner of the text, range: [-32768,32767], screen area: [0,127]
+ * @param  y The y-coordinate of the top-left corner of the text, range: [-32768,32767], screen area: [0,63]
+ * @param  font_size The font size, range: OLED_8X16 (8 pixels wide, 16 pixels high) or OLED_6X8 (6 pixels wide, 8 pixels high)
+ * @retval None
+ * @note   Characters are added with OLED_RunAdd, OLED_RunFlush draws the rest of the run.
+ *         The result is the same as OLED_ShowChar for every character.
+ */
+static void OLED_RunBegin(OLED_Run_t *run, int16_t x, int16_t y, uint8_t font_size)
+{
+	/* A negative coordinate needs an offset when calculating the page address and shift */
+	run->page = y / 8;
+	run->shift = y % 8;
+	if (y < 0)
 	{
-		OLED_ShowChar(x, y, '+', font_size);	 // Display the '+' sign
-		number1 = number;  // number1 is directly equal to number
+		run->page -= 1;
+		run->shift += 8;
 	}
-	else  // If the number is less than 0
+	run->x = x;
+	run->font_size = font_size;
+	run->count = 0;
+	run->pages = 0;
+	run->lookups = 0;
+}
+
+/**
+ * @brief  Draw the batch of glyphs of a run page by page
+ * @param  run The run
+ * @retval None
+ * @note   Each page of the drawing target is written in one sweep from left to right, every byte once,
+ *         the rows of the glyphs are cleared by a mask and the shifted glyph bits are combined in.
+ */
+static void OLED_RunFlush(OLED_Run_t *run)
+{
+	const OLED_RunGlyph_t *glyph;
+	const uint8_t *lo, *hi;
+	uint8_t *row;
+	int16_t page = run->page, target_pages, top, bottom, i, i0, i1, j;
+	uint8_t shift = run->shift, k, glyph_pages, mask;
+
+	target_pages = (OLED_Target->height + 7) / 8;
+
+	for (j = 0; j < run->pages; j++)
 	{
-		OLED_ShowChar(x, y, '-', font_size);	 // Display the '-' sign
-		number1 = -number;  // number1 is the absolute value of number
+		if (page + j < 0 || page + j >= target_pages) {continue;}  // Content outside the drawing target will not be displayed
+		row = OLED_Target->buf + (page + j) * OLED_Target->width;
+
+		for (k = 0; k < run->count; k++)
+		{
+			glyph = &run->glyphs[k];
+			glyph_pages = (glyph->height + 7) / 8;
+			if (j > glyph_pages || (j == glyph_pages && shift == 0)) {continue;}
+
+			/* The rows of the glyph in this page, only inside the drawing target */
+			top = (j == 0) ? shift : 0;
+			bottom = shift + glyph->height - j * 8;
+			if (bottom > 8) {bottom = 8;}
+			if ((page + j) * 8 + bottom > OLED_Target->height) {bottom = OLED_Target->height - (page + j) * 8;}
+			mask = (bottom > top) ? (uint8_t)((0xFF >> (8 - bottom)) & (0xFF << top)) : 0x00;
+
+			i0 = (glyph->x < 0) ? -glyph->x : 0;
+			i1 = OLED_Target->width - glyph->x;
+			if (i1 > glyph->width) {i1 = glyph->width;}
+
+#if OLED_GLYPH_CACHE_SLOTS > 0
+			/* A glyph from the glyph cache is already split into the pages */
+			if (shift > 0 && OLED_GLYPH_CACHEABLE(glyph->width, glyph->height))
+			{
+				lo = glyph->glyph + j * glyph->width;
+				for (i = i0; i < i1; i++)
+				{
+					row[glyph->x + i] = (row[glyph->x + i] & ~mask) | lo[i];
+				}
+				continue;
+			}
+#endif
+
+			/* The glyph page in this page and the one above it, shifted into place */
+			lo = (j < glyph_pages) ? glyph->glyph + j * glyph->width : NULL;
+			hi = (shift > 0 && j > 0) ? glyph->glyph + (j - 1) * glyph->width : NULL;
+			for (i = i0; i < i1; i++)
+			{
+				row[glyph->x + i] = (row[glyph->x + i] & ~mask) | (lo ? (uint8_t)(lo[i] << shift) : 0) |
+				                    (hi ? hi[i] >> (8 - shift) : 0);
+			}
+		}
 	}
-	
-	/* Iterate through each digit of the number */
-	for (i = 0; i < length; i++)			
+
+	run->count = 0;
+	run->pages = 0;
+	run->lookups = 0;
+}
+
+/**
+ * @brief  Add a character to a run of text
+ * @param  run The run
+ * @param  code The codepoint of the character
+ * @retval Whether the next character is visible, 0: the run reached the right edge of the drawing target
+ * @note   Glyphs left of or above and below the drawing target are skipped, a character at its right edge is not added.
+ *         At a y-coordinate that is not a multiple of 8, the glyph is taken from the glyph cache already shifted.
+ *         A batch is drawn before it would take glyphs from all cache slots, so no slot it uses is replaced.
+ */
+static uint8_t OLED_RunAdd(OLED_Run_t *run, uint32_t code)
+{
+	const uint8_t *data;
+	int16_t x = run->x;
+	uint8_t width, height, glyph_pages;
+
+	if (x >= OLED_Target->width) {return 0;}
+
+	data = OLED_GetGlyph(run->font_size, code, &width, &height);
+	run->x += width;
+	if (run->x <= 0 || width == 0 || height == 0) {return 1;}  // Nothing to display
+
+	glyph_pages = (height + 7) / 8 + (run->shift > 0);
+	if (run->page + glyph_pages <= 0 || run->page >= (OLED_Target->height + 7) / 8) {return run->x < OLED_Target->width;}
+
+	if (run->count == OLED_RUN_GLYPHS) {OLED_RunFlush(run);}
+#if OLED_GLYPH_CACHE_SLOTS > 0
+	if (run->shift > 0 && OLED_GLYPH_CACHEABLE(width, height))
 	{
-		OLED_ShowChar(x + (i + 1) * font_size, y, number1 / OLED_Pow(10, length - i - 1) % 10 + '0', font_size);
+		if (run->lookups == OLED_GLYPH_CACHE_SLOTS) {OLED_RunFlush(run);}
+		data = OLED_GlyphCacheGet(data, width, height, run->shift)->data;
+		run->lookups++;
 	}
+#endif
+
+	run->glyphs[run->count].glyph = data;
+	run->glyphs[run->count].x = x;
+	run->glyphs[run->count].width = width;
+	run->glyphs[run->count].height = height;
+	run->count++;
+	if (glyph_pages > run->pages) {run->pages = glyph_pages;}
+	return run->x < OLED_Target->width;
 }
 
 /**
- * @brief  Display a positive hexadecimal integer on the OLED
- * @param  x The x-coordinate of the top-left corner of the number, range: [-32768,32767], screen area: [0,127]
- * @param  y The y-coordinate of the top-left corner of the number, range: [-32768,32767], screen area: [0,63]
- * @param  number The number to display, range: [0x00000000,0xFFFFFFFF]
- * @param  length The length of the number, range: [0,8]
+ * @brief  Display a run of text on the OLED page by page
+ * @param  x The x-coordinate of the top-left corner of the text, range: [-32768,32767], screen area: [0,127]
+ * @param  y The y-coordinate of the top-left corner of the text, range: [-32768,32767], screen area: [0,63]
+ * @param  str The text, consisting of visible ASCII characters or Chinese characters
+ * @param  length The number of bytes of the text, it also ends at the end of the string
+ * @param  font_size The font size, range: OLED_8X16 (8 pixels wide, 16 pixels high) or OLED_6X8 (6 pixels wide, 8 pixels high)
+ * @retval The x-coordinate after the text
+ * @note   The result is the same as OLED_ShowChar for every character. The glyphs of up to OLED_RUN_GLYPHS characters
+ *         are looked up first, then drawn by OLED_RunFlush, the run ends at the right edge of the drawing target.
+ */
+static int16_t OLED_ShowRun(int16_t x, int16_t y, const char *str, uint16_t length, uint8_t font_size)
+{
+	OLED_Run_t run;
+	const char *p = str;
+	uint32_t code;
+
+	OLED_RunBegin(&run, x, y, font_size);
+	while (p - str < length && (code = OLED_DecodeChar(&p)) != 0 && OLED_RunAdd(&run, code)) {}
+	OLED_RunFlush(&run);
+	return run.x;
+}
+
+/**
+ * @brief  Display a string enlarged by an integer factor on the OLED
+ * @param  x The x-coordinate of the top-left corner of the string, range: [-32768,32767], screen area: [0,127]
+ * @param  y The y-coordinate of the top-left corner of the string, range: [-32768,32767], screen area: [0,63]
+ * @param  str The string to display, range: visible ASCII characters and Chinese characters in OLED_CF16x16
  * @param  font_size The font size, range: OLED_8X16 (8 pixels wide, 16 pixels high) or OLED_6X8 (6 pixels wide, 8 pixels high)
+ * @param  scale The enlargement factor, range: [1,4]
  * @retval None
  */
-void OLED_ShowHexNum(int16_t x, int16_t y, uint32_t number, uint8_t length, uint8_t font_size)
+void OLED_ShowStringScaled(int16_t x, int16_t y, char *str, uint8_t font_size, uint8_t scale)
 {
-	uint8_t i, single_number;
+	const char *p = str;
+	const uint8_t *glyph;
+	uint8_t width, height;
+	uint32_t code;
 
-	/* Iterate through each digit of the number */
-	for (i = 0; i < length; i++)		
+	if (scale == 1)
 	{
-		// Extract each hexadecimal digit of the number
-		single_number = number / OLED_Pow(16, length - i - 1) % 16;
-		
-		if (single_number < 10)  // If the single digit is less than 10
+		OLED_ShowRun(x, y, str, 0xFFFF, font_size);
+		return;
+	}
+
+	/* Decode the string one character at a time, until its end or an incomplete character */
+	while ((code = OLED_DecodeChar(&p)) != 0)
+	{
+		// Display the glyph of the character, missing characters are shown as the default figure of the font
+		glyph = OLED_GetGlyph(font_size, code, &width, &height);
+		OLED_ShowGlyph(x, y, width, height, glyph, scale);
+		x += width * scale;
+	}
+}
+
+/**
+ * @brief  Read bits from the bitmap of a packed font
+ * @param  bits The bitmap
+ * @param  position The position of the first bit, it is moved past the bits read
+ * @param  count The number of bits, range: [0,32]
+ * @retval The bits, the first bit in the LSB
+ */
+static uint32_t OLED_ReadBits(const uint8_t *bits, uint32_t *position, uint8_t count)
+{
+	uint32_t value = 0;
+	uint8_t done = 0, n;
+
+	while (done < count)
+	{
+		/* The rest of the current byte, at most the bits still needed */
+		n = 8 - *position % 8;
+		if (n > count - done) {n = count - done;}
+		value |= (uint32_t)((bits[*position / 8] >> (*position % 8)) & (0xFF >> (8 - n))) << done;
+		done += n;
+		*position += n;
+	}
+	return value;
+}
+
+/**
+ * @brief  Find the glyph of a character in a packed font
+ * @param  font The packed font
+ * @param  code The codepoint of the character, as returned by OLED_DecodeChar
+ * @param  bits Returns the packed bits of the bounding box of the glyph
+ * @retval The glyph, the missing glyph of the font if the character is not covered
+ */
+const OLED_PackedGlyph_t *OLED_GetPackedGlyph(const OLED_PackedFont_t *font, uint32_t code, const uint8_t **bits)
+{
+	uint16_t index = font->missing, low = 0, high = font->glyph_count, middle, i;
+	uint32_t offset;
+
+	if (font->codes == NULL)  // Every codepoint from the first one has a glyph
+	{
+		if (code >= font->first && code - font->first < font->glyph_count) {index = code - font->first;}
+	}
+	else
+	{
+		/* Binary search for the codepoint */
+		while (low < high)
+		{
+			middle = (low + high) / 2;
+			if (font->codes[middle] < code) {low = middle + 1;}
+			else {high = middle;}
+		}
+		if (low < font->glyph_count && font->codes[low] == code) {index = low;}
+	}
+
+	/* Only every OLED_PACKED_OFFSET_STEP-th offset is stored, add the sizes of the glyphs in between */
+	offset = font->offsets[index / OLED_PACKED_OFFSET_STEP];
+	for (i = index - index % OLED_PACKED_OFFSET_STEP; i < index; i++)
+	{
+		offset += (font->glyphs[i].width * font->glyphs[i].height + 7) / 8;
+	}
+
+	*bits = font->bitmap + offset;
+	return &font->glyphs[index];
+}
+
+/**
+ * @brief  Display a character of a packed font on the OLED
+ * @param  x The x-coordinate of the top-left corner of the character, range: [-32768,32767], screen area: [0,127]
+ * @param  y The y-coordinate of the top-left corner of the character, range: [-32768,32767], screen area: [0,63]
+ * @param  code The codepoint of the character, as returned by OLED_DecodeChar
+ * @param  font The packed font, like OLED_PackedFont8x16
+ * @retval The advance of the character, the x-distance to the next character
+ * @note   The character cell (advance * font height) is cleared like OLED_ShowChar,
+ *         the bounding box is then decoded column by column straight into the page bytes of the drawing target.
+ */
+uint8_t OLED_ShowPackedChar(int16_t x, int16_t y, uint32_t code, const OLED_PackedFont_t *font)
+{
+	const OLED_PackedGlyph_t *glyph;
+	const uint8_t *bits;
+	uint32_t position = 0;
+	uint64_t cell, data;
+	int16_t page, shift, pages, target_pages, rows, i, j;
+	uint8_t mask, *dst;
+
+	glyph = OLED_GetPackedGlyph(font, code, &bits);
+
+	/* A negative coordinate needs an offset when calculating the page address and shift */
+	page = y / 8;
+	shift = y % 8;
+	if (y < 0)
+	{
+		page -= 1;
+		shift += 8;
+	}
+	pages = (shift + font->height + 7) / 8;
+	target_pages = (OLED_Target->height + 7) / 8;
+	cell = ((((uint64_t)1) << font->height) - 1) << shift;  // The rows of the cell in its pages
+
+	for (i = 0; i < glyph->advance; i++)
+	{
+		/* The bits of a column of the bounding box, moved to their rows in the pages of the cell */
+		data = 0;
+		if (i >= glyph->x_offset && i < glyph->x_offset + glyph->width)
+		{
+			data = (uint64_t)OLED_ReadBits(bits, &position, glyph->height) << (shift + glyph->y_offset);
+		}
+
+		if (x + i < 0 || x + i >= OLED_Target->width) {continue;}  // Content outside the drawing target will not be displayed
+
+		for (j = 0; j < pages; j++)
+		{
+			if (page + j < 0 || page + j >= target_pages) {continue;}
+
+			/* Clear the rows of the cell inside the drawing target, then set the bits of the glyph */
+			mask = (uint8_t)(cell >> (8 * j));
+			rows = OLED_Target->height - (page + j) * 8;
+			if (rows < 8) {mask &= 0xFF >> (8 - rows);}
+
+			dst = &OLED_Target->buf[(page + j) * OLED_Target->width + x + i];
+			*dst = (*dst & ~mask) | (uint8_t)(data >> (8 * j));
+		}
+	}
+	return glyph->advance;
+}
+
+/**
+ * @brief  Display a string in a packed font on the OLED
+ * @param  x The x-coordinate of the top-left corner of the string, range: [-32768,32767], screen area: [0,127]
+ * @param  y The y-coordinate of the top-left corner of the string, range: [-32768,32767], screen area: [0,63]
+ * @param  str The string to display
+ * @param  font The packed font, like OLED_PackedFont8x16
+ * @retval None
+ * @note   Each character advances by its own width, characters not covered by the font show its missing glyph.
+ */
+void OLED_ShowPackedString(int16_t x, int16_t y, char *str, const OLED_PackedFont_t *font)
+{
+	const char *p = str;
+	uint32_t code;
+
+	while ((code = OLED_DecodeChar(&p)) != 0)
+	{
+		x += OLED_ShowPackedChar(x, y, code, font);
+	}
+}
+
+/**
+ * @brief  Format an integer into a string of digits in one pass
+ * @param  buf The string, at least 35 bytes
+ * @param  number The number, an int32_t cast to uint32_t for OLED_NUM_SIGNED
+ * @param  length The number of digits of the field, only the lowest digits of longer numbers are kept, range: [0,32]
+ * @param  format The base (OLED_NUM_DEC, OLED_NUM_SIGNED, OLED_NUM_HEX or OLED_NUM_BIN)
+ *                combined with the alignment (OLED_NUM_ZERO, OLED_NUM_RIGHT or OLED_NUM_LEFT)
+ * @retval None
+ * @note   The digits are taken from the lowest one, with a divide by the constant 10 for decimal
+ *         and shifts and masks for hexadecimal and binary, instead of a power and a divide per digit.
+ */
+static void OLED_FormatNum(char *buf, uint32_t number, uint8_t length, uint8_t format)
+{
+	char digits[32];
+	uint8_t base = format & 0x0F, align = format & 0xF0, count, i, n = 0;
+	char sign = 0;
+
+	if (length > 32) {length = 32;}
+
+	if (base == OLED_NUM_SIGNED)  // The sign is always shown, the digits are the absolute value
+	{
+		sign = ((int32_t)number < 0) ? '-' : '+';
+		if ((int32_t)number < 0) {number = 0U - number;}
+	}
+
+	/* The digits from the lowest one, all of the field with zero padding, otherwise only the significant ones */
+	for (count = 0; count < length; )
+	{
+		if (base == OLED_NUM_HEX)
+		{
+			digits[count++] = "0123456789ABCDEF"[number & 0x0F];
+			number >>= 4;
+		}
+		else if (base == OLED_NUM_BIN)
 		{
-			// Call the OLED_ShowChar function to display this digit
-			OLED_ShowChar(x + i * font_size, y, single_number + '0', font_size);
+			digits[count++] = '0' + (number & 0x01);
+			number >>= 1;
 		}
-		else  // If the single digit is greater than or equal to 10
+		else
 		{
-			// Adding 'A' converts the number to a hexadecimal character starting from 'A'
-			OLED_ShowChar(x + i * font_size, y, single_number - 10 + 'A', font_size);
+			digits[count++] = '0' + number % 10;
+			number /= 10;
 		}
+		if (number == 0 && align != OLED_NUM_ZERO) {break;}
+	}
+
+	/* Pad the field to its length */
+	if (align == OLED_NUM_RIGHT)
+	{
+		for (i = count; i < length; i++) {buf[n++] = ' ';}
+	}
+	if (sign != 0) {buf[n++] = sign;}
+	while (count > 0) {buf[n++] = digits[--count];}
+	if (align == OLED_NUM_LEFT)
+	{
+		for (i = n - (sign != 0); i < length; i++) {buf[n++] = ' ';}
 	}
+	buf[n] = '\0';
+}
+
+/**
+ * @brief  Display an integer in a field of fixed length on the OLED
+ * @param  x The x-coordinate of the top-left corner of the field, range: [-32768,32767], screen area: [0,127]
+ * @param  y The y-coordinate of the top-left corner of the field, range: [-32768,32767], screen area: [0,63]
+ * @param  number The number to display, an int32_t cast to uint32_t for OLED_NUM_SIGNED
+ * @param  length The number of digits of the field, only the lowest digits of longer numbers are shown, range: [0,32]
+ * @param  format The base combined with the alignment, like OLED_NUM_DEC | OLED_NUM_RIGHT
+ *                OLED_NUM_DEC, OLED_NUM_SIGNED (decimal with a sign before the digits), OLED_NUM_HEX or OLED_NUM_BIN
+ *                OLED_NUM_ZERO (padded with leading zeros), OLED_NUM_RIGHT (leading spaces) or OLED_NUM_LEFT (trailing spaces)
+ * @param  font_size The font size, range: OLED_8X16 (8 pixels wide, 16 pixels high) or OLED_6X8 (6 pixels wide, 8 pixels high)
+ * @retval None
+ * @note   The whole field is drawn, so a shorter number clears the digits of the previous one.
+ */
+void OLED_ShowNumAligned(int16_t x, int16_t y, uint32_t number, uint8_t length, uint8_t format, uint8_t font_size)
+{
+	char buf[35];
+
+	OLED_FormatNum(buf, number, length, format);
+	OLED_ShowString(x, y, buf, font_size);
+}
+
+/**
+ * @brief  Display a positive decimal integer on the OLED
+ * @param  x The x-coordinate of the top-left corner of the number, range: [-32768,32767], screen area: [0,127]
+ * @param  y The y-coordinate of the top-left corner of the number, range: [-32768,32767], screen area: [0,63]
+ * @param  number The number to display, range: [0,4294967295]
+ * @param  length The length of the number, range: [0,10]
+ * @param  font_size The font size, range: OLED_8X16 (8 pixels wide, 16 pixels high) or OLED_6X8 (6 pixels wide, 8 pixels high)
+ * @retval None
+ */
+void OLED_ShowNum(int16_t x, int16_t y, uint32_t number, uint8_t length, uint8_t font_size)
+{
+	OLED_ShowNumAligned(x, y, number, length, OLED_NUM_DEC | OLED_NUM_ZERO, font_size);
+}
+
+/**
+ * @brief  Display a signed decimal integer on the OLED
+ * @param  x The x-coordinate of the top-left corner of the number, range: [-32768,32767], screen area: [0,127]
+ * @param  y The y-coordinate of the top-left corner of the number, range: [-32768,32767], screen area: [0,63]
+ * @param  number The number to display, range: [-2147483648,2147483647]
+ * @param  length The length of the number, range: [0,10]
+ * @param  font_size The font size, range: OLED_8X16 (8 pixels wide, 16 pixels high) or OLED_6X8 (6 pixels wide, 8 pixels high)
+ * @retval None
+ */
+void OLED_ShowSignedNum(int16_t x, int16_t y, int32_t number, uint8_t length, uint8_t font_size)
+{
+	OLED_ShowNumAligned(x, y, (uint32_t)number, length, OLED_NUM_SIGNED | OLED_NUM_ZERO, font_size);
+}
+
+/**
+ * @brief  Display a positive hexadecimal integer on the OLED
+ * @param  x The x-coordinate of the top-left corner of the number, range: [-32768,32767], screen area: [0,127]
+ * @param  y The y-coordinate of the top-left corner of the number, range: [-32768,32767], screen area: [0,63]
+ * @param  number The number to display, range: [0x00000000,0xFFFFFFFF]
+ * @param  length The length of the number, range: [0,8]
+ * @param  font_size The font size, range: OLED_8X16 (8 pixels wide, 16 pixels high) or OLED_6X8 (6 pixels wide, 8 pixels high)
+ * @retval None
+ */
+void OLED_ShowHexNum(int16_t x, int16_t y, uint32_t number, uint8_t length, uint8_t font_size)
+{
+	OLED_ShowNumAligned(x, y, number, length, OLED_NUM_HEX | OLED_NUM_ZERO, font_size);
 }
 
 /**
@@ -662,21 +1506,13 @@ void OLED_ShowHexNum(int16_t x, int16_t y, uint32_t number, uint8_t length, uint
  * @param  x The x-coordinate of the top-left corner of the number, range: [-32768,32767], screen area: [0,127]
  * @param  y The y-coordinate of the top-left corner of the number, range: [-32768,32767], screen area: [0,63]
  * @param  number The number to display, range: [0x00000000,0xFFFFFFFF]
- * @param  length The length of the number, range: [0,16]
+ * @param  length The length of the number, range: [0,32]
  * @param  font_size The font size, range: OLED_8X16 (8 pixels wide, 16 pixels high) or OLED_6X8 (6 pixels wide, 8 pixels high)
  * @retval None
  */
 void OLED_ShowBinNum(int16_t x, int16_t y, uint32_t number, uint8_t length, uint8_t font_size)
 {
-	uint8_t i;
-	
-  /* Iterate through each digit of the number */
-	for (i = 0; i < length; i++)		
-	{
-		// number / OLED_Pow(2, length - i - 1) % 2 extracts each binary digit of the number
-		// Adding '0' converts the number to a character format
-		OLED_ShowChar(x + i * font_size, y, number / OLED_Pow(2, length - i - 1) % 2 + '0', font_size);
-	}
+	OLED_ShowNumAligned(x, y, number, length, OLED_NUM_BIN | OLED_NUM_ZERO, font_size);
 }
 
 /**
@@ -689,6 +1525,9 @@ void OLED_ShowBinNum(int16_t x, int16_t y, uint32_t number, uint8_t length, uint
  * @param  font_size The font size, range: OLED_8X16 (8 pixels wide, 16 pixels high) or OLED_6X8 (6 pixels wide, 8 pixels high)
  * @retval None
  * @note   The fraction is rounded for display.
+ *         The double-precision math is done in software on the Cortex-M3,
+ *         OLED_ShowFixed and OLED_ShowFloat display the same text without it,
+ *         except for decimal halves, see OLED_ShowFixed. OLED_BenchNumbers compares the three on the target.
  */
 void OLED_ShowFloatNum(int16_t x, int16_t y, double number, uint8_t int_length, uint8_t fra_length, uint8_t font_size)
 {
@@ -722,113 +1561,1510 @@ void OLED_ShowFloatNum(int16_t x, int16_t y, double number, uint8_t int_length,
 }
 
 /**
- * @brief  Display an image on the OLED
- * @param  x The x-coordinate of the top-left corner of the image, range: [-32768,32767], screen area: [0,127]
- * @param  y The y-coordinate of the top-left corner of the image, range: [-32768,32767], screen area: [0,63]
- * @param  width The width of the image, range: [0,128]
- * @param  height The height of the image, range: [0,64]
- * @param  image The image to display
+ * @brief  Display the parts of a fixed-point number on the OLED, formatted like OLED_ShowFloatNum
+ * @param  x The x-coordinate of the top-left corner of the number, range: [-32768,32767], screen area: [0,127]
+ * @param  y The y-coordinate of the top-left corner of the number, range: [-32768,32767], screen area: [0,63]
+ * @param  negative Whether the number is negative, 1: '-' sign, 0: '+' sign
+ * @param  int_num The integer part of the absolute value
+ * @param  fra_num The rounded fractional part as an integer, fra_length digits, a carry into the integer part is added
+ * @param  int_length The length of the integer part of the number, range: [0,10]
+ * @param  fra_length The length of the fractional part of the number, range: [0,9]
+ * @param  font_size The font size, range: OLED_8X16 (8 pixels wide, 16 pixels high) or OLED_6X8 (6 pixels wide, 8 pixels high)
  * @retval None
  */
-void OLED_ShowImage(int16_t x, int16_t y, uint8_t width, uint8_t height, const uint8_t *image)
+static void OLED_ShowFixedParts(int16_t x, int16_t y, uint8_t negative, uint32_t int_num, uint32_t fra_num,
+                                uint8_t int_length, uint8_t fra_length, uint8_t font_size)
 {
-	uint8_t i = 0, j = 0;
-	int16_t page, shift;
+	char buf[48];  // At most a sign, 32 integer digits, the point, 9 fractional digits and the terminator
+	uint32_t pow_num = OLED_Pow(10, fra_length);
+	uint8_t n;
+
+	if (fra_num >= pow_num)  // Rounding carried into the integer part
+	{
+		int_num += 1;
+		fra_num -= pow_num;
+	}
+
+	/* Sign, integer part, decimal point and fractional part as one string */
+	buf[0] = negative ? '-' : '+';
+	OLED_FormatNum(buf + 1, int_num, int_length, OLED_NUM_DEC | OLED_NUM_ZERO);
+	n = strlen(buf);
+	buf[n] = '.';
+	OLED_FormatNum(buf + n + 1, fra_num, fra_length, OLED_NUM_DEC | OLED_NUM_ZERO);
+	OLED_ShowString(x, y, buf, font_size);
+}
+
+/**
+ * @brief  Round the binary fraction of a fixed-point number to decimal digits
+ * @param  fraction The fractional bits, less than 2^shift and less than 2^34
+ * @param  shift The number of fractional bits, range: [0,63]
+ * @param  pow_num 10 to the power of the number of digits
+ * @retval The fraction times pow_num, rounded half away from zero, may equal pow_num
+ */
+static uint32_t OLED_RoundFraction(uint64_t fraction, uint8_t shift, uint32_t pow_num)
+{
+	if (shift == 0) {return 0;}
+	return (fraction * pow_num + ((uint64_t)1 << (shift - 1))) >> shift;
+}
+
+/**
+ * @brief  Display a fixed-point number on the OLED
+ * @param  x The x-coordinate of the top-left corner of the number, range: [-32768,32767], screen area: [0,127]
+ * @param  y The y-coordinate of the top-left corner of the number, range: [-32768,32767], screen area: [0,63]
+ * @param  number The number as an integer, its value is number / 10^scale or number / 2^q
+ * @param  point The position of the point, OLED_FIXED_DEC(scale) with scale range: [0,9],
+ *               or OLED_FIXED_Q(q) for the Q format with q range: [0,31]
+ * @param  int_length The length of the integer part of the number, range: [0,10]
+ * @param  fra_length The length of the fractional part of the number, range: [0,9]
+ * @param  font_size The font size, range: OLED_8X16 (8 pixels wide, 16 pixels high) or OLED_6X8 (6 pixels wide, 8 pixels high)
+ * @retval None
+ * @note   The text is the same as OLED_ShowFloatNum for the same value, the fraction is rounded half away from zero.
+ *         Only integer math is used, OLED_ShowFixed(x, y, 12345, OLED_FIXED_DEC(2), 3, 2, OLED_6X8) shows "+123.45".
+ *         A decimal half is exact here but not in a double, so the rounding can differ from OLED_ShowFloatNum:
+ *         OLED_ShowFixed(x, y, 64015, OLED_FIXED_DEC(2), 3, 1, OLED_6X8) shows "+640.2", while
+ *         OLED_ShowFloatNum(x, y, 640.15, 3, 1, OLED_6X8) shows "+640.1", the double nearest to 640.15 is 640.1499999...
+ */
+void OLED_ShowFixed(int16_t x, int16_t y, int32_t number, uint8_t point, uint8_t int_length, uint8_t fra_length, uint8_t font_size)
+{
+	uint32_t magnitude = (number < 0) ? 0U - (uint32_t)number : (uint32_t)number;
+	uint32_t pow_num, divisor, int_num, fra_num;
+	uint8_t scale = point & 0x3F;
+
+	if (fra_length > 9) {fra_length = 9;}
+	pow_num = OLED_Pow(10, fra_length);
+
+	if (point & OLED_FIXED_Q(0))  // Binary point, the fraction is the low q bits
+	{
+		if (scale > 31) {scale = 31;}
+		int_num = magnitude >> scale;
+		fra_num = OLED_RoundFraction(magnitude & ((1UL << scale) - 1), scale, pow_num);
+	}
+	else  // Decimal point, the fraction is the remainder of a division by 10^scale
+	{
+		if (scale > 9) {scale = 9;}
+		divisor = OLED_Pow(10, scale);
+		int_num = magnitude / divisor;
+		fra_num = magnitude % divisor;
+		if (fra_length >= scale)
+		{
+			fra_num *= OLED_Pow(10, fra_length - scale);  // Less than 10^fra_length, no overflow
+		}
+		else
+		{
+			divisor = OLED_Pow(10, scale - fra_length);
+			fra_num = (fra_num + divisor / 2) / divisor;
+		}
+	}
+
+	OLED_ShowFixedParts(x, y, number < 0, int_num, fra_num, int_length, fra_length, font_size);
+}
+
+/**
+ * @brief  Display a single-precision floating-point number on the OLED
+ * @param  x The x-coordinate of the top-left corner of the number, range: [-32768,32767], screen area: [0,127]
+ * @param  y The y-coordinate of the top-left corner of the number, range: [-32768,32767], screen area: [0,63]
+ * @param  number The number to display, range: [-4294967295.0,4294967295.0], larger numbers are shown as 4294967295
+ * @param  int_length The length of the integer part of the number, range: [0,10]
+ * @param  fra_length The length of the fractional part of the number, range: [0,9]
+ * @param  font_size The font size, range: OLED_8X16 (8 pixels wide, 16 pixels high) or OLED_6X8 (6 pixels wide, 8 pixels high)
+ * @retval None
+ * @note   The text is the same as OLED_ShowFloatNum for the same value. The float is split into
+ *         its exponent and 24-bit mantissa once, the rest is integer math, no soft-float routine is called.
+ *         A decimal literal can round to a different side as a float: 640.15f is 640.150024..., so
+ *         OLED_ShowFloat(x, y, 640.15f, 3, 1, OLED_6X8) shows "+640.2" and OLED_ShowFloatNum with 640.15 shows "+640.1".
+ */
+void OLED_ShowFloat(int16_t x, int16_t y, float number, uint8_t int_length, uint8_t fra_length, uint8_t font_size)
+{
+	uint32_t bits, mantissa, int_num = 0, fra_num = 0;
+	int16_t exponent;
+	uint8_t shift;
+
+	memcpy(&bits, &number, 4);
+	exponent = (int16_t)((bits >> 23) & 0xFF) - 127 - 23;  // The value is mantissa * 2^exponent
+	mantissa = (bits & 0x7FFFFF) | 0x800000;
+	if (fra_length > 9) {fra_length = 9;}
+
+	if ((bits & 0x7F800000) == 0)  // Zero and subnormal numbers round to zero
+	{
+		mantissa = 0;
+	}
+	else if (exponent >= 0)  // No fraction
+	{
+		int_num = (exponent > 8) ? 0xFFFFFFFF : mantissa << exponent;  // Also infinity and NaN
+	}
+	else if (exponent >= -55)  // Smaller numbers round to zero with up to 9 digits
+	{
+		shift = -exponent;
+		int_num = (shift >= 24) ? 0 : mantissa >> shift;
+		fra_num = OLED_RoundFraction(mantissa & (((uint64_t)1 << shift) - 1), shift, OLED_Pow(10, fra_length));
+	}
+
+	OLED_ShowFixedParts(x, y, (bits >> 31) && (bits & 0x7FFFFFFF) != 0, int_num, fra_num, int_length, fra_length, font_size);
+}
+
+/**
+ * @brief  OR a byte of an image into the drawing target
+ * @param  x The x-coordinate of the column of the byte
+ * @param  page The page the top of the image falls into, may be negative
+ * @param  shift The y-offset of the top of the image within that page, range: [0,8]
+ * @param  data The image byte
+ * @retval None
+ * @note   The byte is split between the page and the next page. Content outside the drawing target will not be displayed.
+ */
+static inline void OLED_ImageByte(int16_t x, int16_t page, int16_t shift, uint8_t data)
+{
+	int16_t target_width = OLED_Target->width;
+	int16_t target_pages = (OLED_Target->height + 7) / 8;
+
+	if (x >= 0 && x < target_width)  // Content outside the drawing target will not be displayed
+	{
+		if (page >= 0 && page < target_pages)  // Content outside the drawing target will not be displayed
+		{
+			// Display the content of the image on the current page
+			OLED_Target->buf[page * target_width + x] |= data << (shift);
+		}
+		
+		if (page + 1 >= 0 && page + 1 < target_pages)  // Content outside the drawing target will not be displayed
+		{					
+			// Display the content of the image on the next page
+			OLED_Target->buf[(page + 1) * target_width + x] |= data >> (8 - shift);
+		}
+	}
+}
+
+/**
+ * @brief  Display an image on the OLED
+ * @param  x The x-coordinate of the top-left corner of the image, range: [-32768,32767], screen area: [0,127]
+ * @param  y The y-coordinate of the top-left corner of the image, range: [-32768,32767], screen area: [0,63]
+ * @param  width The width of the image, range: [0,128]
+ * @param  height The height of the image, range: [0,64]
+ * @param  image The image to display
+ * @retval None
+ */
+void OLED_ShowImage(int16_t x, int16_t y, uint8_t width, uint8_t height, const uint8_t *image)
+{
+	uint8_t i = 0, j = 0;
+	int16_t page, shift;
+
+	/* A negative coordinate needs an offset when calculating the page address and shift */
+	page = y / 8;
+	shift = y % 8;
+	if (y < 0)
+	{
+		page -= 1;
+		shift += 8;
+	}
+
+	// Clear the area where the image will be displayed
+	OLED_ClearArea(x, y, width, height);
+	
+	/* Iterate through the relevant pages involved in the specified image */
+	for (j = 0; j < (height - 1) / 8 + 1; j++)  // (height - 1) / 8 + 1 is used to round up height / 8
+	{
+		/* Iterate through the relevant columns involved in the specified image */
+		for (i = 0; i < width; i++)
+		{
+			OLED_ImageByte(x + i, page + j, shift, image[j * width + i]);
+		}
+	}
+}
+
+/* Expansion of a nibble to 4 * scale bits, each bit repeated scale times, for the scales 2, 3 and 4 */
+static const uint16_t OLED_ExpandNibble[3][16] = {
+	{0x0000, 0x0003, 0x000C, 0x000F, 0x0030, 0x0033, 0x003C, 0x003F, 0x00C0, 0x00C3, 0x00CC, 0x00CF, 0x00F0, 0x00F3, 0x00FC, 0x00FF},
+	{0x0000, 0x0007, 0x0038, 0x003F, 0x01C0, 0x01C7, 0x01F8, 0x01FF, 0x0E00, 0x0E07, 0x0E38, 0x0E3F, 0x0FC0, 0x0FC7, 0x0FF8, 0x0FFF},
+	{0x0000, 0x000F, 0x00F0, 0x00FF, 0x0F00, 0x0F0F, 0x0FF0, 0x0FFF, 0xF000, 0xF00F, 0xF0F0, 0xF0FF, 0xFF00, 0xFF0F, 0xFFF0, 0xFFFF},
+};
+
+/**
+ * @brief  Display an image enlarged by an integer factor on the OLED
+ * @param  x The x-coordinate of the top-left corner of the image, range: [-32768,32767], screen area: [0,127]
+ * @param  y The y-coordinate of the top-left corner of the image, range: [-32768,32767], screen area: [0,63]
+ * @param  width The width of the image before scaling, range: [0,128]
+ * @param  height The height of the image before scaling, range: [0,64]
+ * @param  image The image to display, in the same format as OLED_ShowImage
+ * @param  scale The enlargement factor, the image covers width * scale by height * scale pixels, range: [1,4]
+ * @retval None
+ * @note   Each image byte is expanded to scale page bytes through a nibble lookup table,
+ *         and the expanded bytes are written to scale neighbouring columns, so no enlarged copy of the image is needed.
+ */
+void OLED_ShowImageScaled(int16_t x, int16_t y, uint8_t width, uint8_t height, const uint8_t *image, uint8_t scale)
+{
+	const uint16_t *expand;
+	uint32_t bits;
+	int16_t page, shift, x0, y0, x1, y1;
+	uint8_t i, j, k, c;
+
+	if (scale <= 1)
+	{
+		OLED_ShowImage(x, y, width, height, image);
+		return;
+	}
+	if (scale > 4) {scale = 4;}
+	expand = OLED_ExpandNibble[scale - 2];
+
+	/* A negative coordinate needs an offset when calculating the page address and shift */
+	page = y / 8;
+	shift = y % 8;
+	if (y < 0)
+	{
+		page -= 1;
+		shift += 8;
+	}
+
+	// Clear the part of the enlarged area inside the drawing target, it can be wider than OLED_ClearArea accepts
+	x0 = (x < 0) ? 0 : x;
+	y0 = (y < 0) ? 0 : y;
+	x1 = x + width * scale;
+	y1 = y + height * scale;
+	if (x1 > OLED_Target->width) {x1 = OLED_Target->width;}
+	if (y1 > OLED_Target->height) {y1 = OLED_Target->height;}
+	if (x0 < x1 && y0 < y1)
+	{
+		OLED_ClearArea(x0, y0, x1 - x0, y1 - y0);
+	}
+
+	for (j = 0; j < (height - 1) / 8 + 1; j++)
+	{
+		for (i = 0; i < width; i++)
+		{
+			// Expand the 8 pixels of the byte to 8 * scale pixels
+			c = image[j * width + i];
+			bits = expand[c & 0x0F] | (uint32_t)expand[c >> 4] << (4 * scale);
+			if (bits == 0) {continue;}
+
+			/* Write the expanded bytes to scale columns */
+			for (k = 0; k < scale; k++, bits >>= 8)
+			{
+				for (c = 0; c < scale; c++)
+				{
+					OLED_ImageByte(x + i * scale + c, page + j * scale + k, shift, (uint8_t)bits);
+				}
+			}
+		}
+	}
+}
+
+/**
+ * @brief  Display a run-length compressed image on the OLED
+ * @param  x The x-coordinate of the top-left corner of the image, range: [-32768,32767], screen area: [0,127]
+ * @param  y The y-coordinate of the top-left corner of the image, range: [-32768,32767], screen area: [0,63]
+ * @param  width The width of the image, range: [0,128]
+ * @param  height The height of the image, range: [0,64]
+ * @param  data The compressed image, generated by Tools/oled_rle.c
+ * @retval None
+ * @note   The data is the PackBits encoding of the page format byte stream used by OLED_ShowImage.
+ *         Each run starts with a header byte n: n in [0,127] is followed by n + 1 literal bytes,
+ *         n in [129,255] is followed by one byte repeated 257 - n times, n = 128 is ignored.
+ *         The runs are decoded straight into the drawing target without an intermediate buffer.
+ */
+void OLED_ShowImageRLE(int16_t x, int16_t y, uint8_t width, uint8_t height, const uint8_t *data)
+{
+	uint16_t size, count;
+	uint8_t header, value, literal;
+	int16_t i = 0, page, shift;
+
+	/* A negative coordinate needs an offset when calculating the page address and shift */
+	page = y / 8;
+	shift = y % 8;
+	if (y < 0)
+	{
+		page -= 1;
+		shift += 8;
+	}
+
+	// Clear the area where the image will be displayed
+	OLED_ClearArea(x, y, width, height);
+
+	size = ((height + 7) / 8) * width;  // Bytes of the uncompressed image
+
+	/* Iterate through the runs until the whole image is decoded */
+	while (size > 0 && width > 0)
+	{
+		header = *data++;
+		if (header == 128) {continue;}  // No operation
+
+		literal = (header < 128);
+		count = literal ? header + 1 : 257 - header;
+		if (count > size) {count = size;}  // Never write past the image
+		size -= count;
+
+		value = *data;
+		while (count--)
+		{
+			if (literal) {value = *data++;}
+
+			OLED_ImageByte(x + i, page, shift, value);
+
+			/* Move to the next column, wrapping to the next page of the image */
+			if (++i == width)
+			{
+				i = 0;
+				page++;
+			}
+		}
+		if (!literal) {data++;}
+	}
+}
+
+/**
+ * @brief  Display a row-major bitmap on the OLED
+ * @param  x The x-coordinate of the top-left corner of the bitmap, range: [-32768,32767], screen area: [0,127]
+ * @param  y The y-coordinate of the top-left corner of the bitmap, range: [-32768,32767], screen area: [0,63]
+ * @param  width The width of the bitmap, range: [0,255]
+ * @param  height The height of the bitmap, range: [0,255]
+ * @param  bitmap The bitmap data, row by row from top to bottom, each row padded to whole bytes
+ * @param  format The bit order of the bitmap, range: OLED_BITMAP_XBM (leftmost pixel in bit 0) or OLED_BITMAP_PBM (leftmost pixel in bit 7)
+ * @retval None
+ * @note   Used for the output of tools emitting 1bpp XBM or raw PBM (P4) bitmaps, without converting them to the page format offline.
+ *         Each 8*8 block of the bitmap is converted into 8 page bytes by a bit-matrix transpose,
+ *         a strip of 8 rows is then displayed like an image of height 8, in chunks of at most 128 columns.
+ */
+void OLED_ShowBitmap(int16_t x, int16_t y, uint8_t width, uint8_t height, const uint8_t *bitmap, uint8_t format)
+{
+	uint8_t strip[128];
+	uint8_t rows[8], columns[8];
+	uint8_t i, j, r, stride, strip_height, chunk_width;
+	uint16_t chunk;
+
+	stride = (width + 7) / 8;  // Bytes of each row
+
+	/* Iterate through the strips of 8 rows */
+	for (j = 0; j < (height + 7) / 8; j++)
+	{
+		strip_height = (height - j * 8 < 8) ? height - j * 8 : 8;
+
+		// Strips outside the drawing target are not converted
+		if (y + j * 8 + 8 <= 0 || y + j * 8 >= OLED_Target->height) {continue;}
+
+		/* Iterate through the chunks of the strip that fit in the strip buffer */
+		for (chunk = 0; chunk < width; chunk += 128)
+		{
+			chunk_width = (width - chunk < 128) ? width - chunk : 128;
+
+			// Chunks outside the drawing target are not converted
+			if (x + chunk + chunk_width <= 0 || x + chunk >= OLED_Target->width) {continue;}
+
+			/* Iterate through the 8*8 blocks of the chunk */
+			for (i = 0; i < (chunk_width + 7) / 8; i++)
+			{
+				// Gather one byte of each row, missing rows of the last strip are empty
+				for (r = 0; r < 8; r++)
+				{
+					rows[r] = (r < strip_height) ? bitmap[(j * 8 + r) * stride + chunk / 8 + i] : 0x00;
+				}
+
+				// Row r, column c becomes column c, row r
+				OLED_Transpose8(rows, columns);
+
+				/* Store the columns of the block inside the bitmap width */
+				for (r = 0; r < 8 && i * 8 + r < chunk_width; r++)
+				{
+					strip[i * 8 + r] = (format == OLED_BITMAP_PBM) ? columns[7 - r] : columns[r];
+				}
+			}
+
+			OLED_ShowImage(x + chunk, y + j * 8, chunk_width, strip_height, strip);
+		}
+	}
+}
+
+/* 8*8 Bayer matrix of ordered dithering, scaled to thresholds in the 8-bit gray range */
+static const uint8_t OLED_Bayer8[8][8] = {
+	{  2, 130,  34, 162,  10, 138,  42, 170},
+	{194,  66, 226,  98, 202,  74, 234, 106},
+	{ 50, 178,  18, 146,  58, 186,  26, 154},
+	{242, 114, 210,  82, 250, 122, 218,  90},
+	{ 14, 142,  46, 174,   6, 134,  38, 166},
+	{206,  78, 238, 110, 198,  70, 230, 102},
+	{ 62, 190,  30, 158,  54, 182,  22, 150},
+	{254, 126, 222,  94, 246, 118, 214,  86},
+};
+
+/**
+ * @brief  Display a grayscale image on the OLED with ordered dithering
+ * @param  x The x-coordinate of the top-left corner of the image, range: [-32768,32767], screen area: [0,127]
+ * @param  y The y-coordinate of the top-left corner of the image, range: [-32768,32767], screen area: [0,63]
+ * @param  width The width of the image, range: [0,255]
+ * @param  height The height of the image, range: [0,255]
+ * @param  gray The gray levels row by row from top to bottom, 0 is black
+ * @param  bits The bits per pixel, range: OLED_GRAY_4BIT (two pixels per byte, the left one in the high nibble,
+ *              each row padded to whole bytes) or OLED_GRAY_8BIT (one pixel per byte)
+ * @retval None
+ * @note   A pixel is lit when its level exceeds the threshold of the Bayer matrix at its screen position,
+ *         so neighbouring images dither seamlessly. Each strip of 8 rows is displayed like an image of height 8,
+ *         in chunks of at most 128 columns.
+ */
+void OLED_ShowGrayImage(int16_t x, int16_t y, uint8_t width, uint8_t height, const uint8_t *gray, uint8_t bits)
+{
+	uint8_t strip[128];
+	uint8_t i, j, r, c, strip_height, chunk_width, level, data;
+	uint16_t chunk;
+	uint16_t stride = (bits == OLED_GRAY_4BIT) ? (width + 1) / 2 : width;
+	const uint8_t *row;
+
+	/* Iterate through the strips of 8 rows */
+	for (j = 0; j < (height + 7) / 8; j++)
+	{
+		strip_height = (height - j * 8 < 8) ? height - j * 8 : 8;
+
+		// Strips outside the drawing target are not converted
+		if (y + j * 8 + 8 <= 0 || y + j * 8 >= OLED_Target->height) {continue;}
+
+		/* Iterate through the chunks of the strip that fit in the strip buffer */
+		for (chunk = 0; chunk < width; chunk += 128)
+		{
+			chunk_width = (width - chunk < 128) ? width - chunk : 128;
+
+			// Chunks outside the drawing target are not converted
+			if (x + chunk + chunk_width <= 0 || x + chunk >= OLED_Target->width) {continue;}
+
+			for (i = 0; i < chunk_width; i++)
+			{
+				c = chunk + i;  // Column in the image
+				data = 0x00;
+				for (r = 0; r < strip_height; r++)
+				{
+					row = gray + (j * 8 + r) * stride;
+					if (bits == OLED_GRAY_4BIT)
+					{
+						level = (c & 0x01) ? row[c / 2] & 0x0F : row[c / 2] >> 4;
+						level *= 0x11;  // Scale 0~15 to 0~255
+					}
+					else
+					{
+						level = row[c];
+					}
+
+					if (level > OLED_Bayer8[(y + j * 8 + r) & 0x07][(x + c) & 0x07])
+					{
+						data |= 0x01 << r;
+					}
+				}
+				strip[i] = data;
+			}
+
+			OLED_ShowImage(x + chunk, y + j * 8, chunk_width, strip_height, strip);
+		}
+	}
+}
+
+/**
+ * @brief  Display padding characters of OLED_Printf
+ * @param  run The run of the formatted string
+ * @param  pad The padding character, ' ' or '0'
+ * @param  count The number of characters, 0 or less: none
+ * @retval Whether the next character is visible
+ */
+static uint8_t OLED_PrintPad(OLED_Run_t *run, char pad, int16_t count)
+{
+	for (; count > 0; count--)
+	{
+		if (!OLED_RunAdd(run, pad)) {return 0;}
+	}
+	return 1;
+}
+
+/**
+ * @brief  Display a number of OLED_Printf padded to the width of its conversion specification
+ * @param  run The run of the formatted string
+ * @param  spec The conversion specification
+ * @param  number The absolute value of the number
+ * @param  prefix The sign or "0x" before the digits, "": none
+ * @param  digits The digit characters, "0123456789" for decimal, 16 characters for hexadecimal
+ * @param  point The number of digits after the point, 0: an integer
+ * @param  precision The minimum number of digits, leading zeros are added, 0 shows nothing for a zero, -1: not given
+ * @retval Whether the next character is visible
+ * @note   Like the C library, the '0' flag is ignored when a minimum number of digits is given.
+ */
+static uint8_t OLED_PrintNumber(OLED_Run_t *run, const OLED_PrintSpec_t *spec, uint32_t number, const char *prefix,
+                                const char *digits, uint8_t point, int16_t precision)
+{
+	char buf[12];
+	uint8_t base = strlen(digits), count = 0, zero = spec->zero && precision < 0;
+	int16_t length, zeros;
+
+	/* The digits from the lowest one, at least one before the point unless the precision allows none */
+	while (number != 0 || (precision < 0 && count <= point))
+	{
+		buf[count++] = digits[number % base];
+		number /= base;
+	}
+	zeros = (precision > count) ? precision - count : 0;
+
+	/* Pad to the width: spaces before the prefix, zeros after it, or spaces after the number */
+	length = strlen(prefix) + zeros + count + (point > 0);
+	if (!spec->left && !zero && !OLED_PrintPad(run, ' ', spec->width - length)) {return 0;}
+	for (; *prefix != '\0'; prefix++)
+	{
+		if (!OLED_RunAdd(run, *prefix)) {return 0;}
+	}
+	if (!spec->left && zero && !OLED_PrintPad(run, '0', spec->width - length)) {return 0;}
+	if (!OLED_PrintPad(run, '0', zeros)) {return 0;}
+	while (count > 0)
+	{
+		if (count == point && !OLED_RunAdd(run, '.')) {return 0;}
+		if (!OLED_RunAdd(run, buf[--count])) {return 0;}
+	}
+	return !spec->left || OLED_PrintPad(run, ' ', spec->width - length);
+}
+
+/**
+ * @brief  Display a string of OLED_Printf padded to the width of its conversion specification
+ * @param  run The run of the formatted string
+ * @param  spec The conversion specification, the precision limits the number of characters
+ * @param  str The string, NULL is shown as "(null)"
+ * @retval Whether the next character is visible
+ */
+static uint8_t OLED_PrintString(OLED_Run_t *run, const OLED_PrintSpec_t *spec, const char *str)
+{
+	const char *p;
+	int16_t length = 0, i;
+	uint32_t code;
+
+	if (str == NULL) {str = "(null)";}
+
+	/* The padding needs the number of characters first */
+	for (p = str; (spec->precision < 0 || length < spec->precision) && OLED_DecodeChar(&p) != 0; length++) {}
+
+	if (!spec->left && !OLED_PrintPad(run, ' ', spec->width - length)) {return 0;}
+	for (p = str, i = 0; i < length; i++)
+	{
+		code = OLED_DecodeChar(&p);
+		if (!OLED_RunAdd(run, code)) {return 0;}
+	}
+	return !spec->left || OLED_PrintPad(run, ' ', spec->width - length);
+}
+
+/**
+ * @brief  Read a signed integer argument of OLED_Printf
+ * @param  arg The argument list
+ * @param  size The length modifier, 'H': hh, 'h', 'l', 'z': z or t, 0: none
+ * @retval The argument, converted to its type first
+ */
+static int32_t OLED_PrintArgSigned(va_list *arg, char size)
+{
+	switch (size)
+	{
+		case 'H': return (signed char)va_arg(*arg, int);
+		case 'h': return (short)va_arg(*arg, int);
+		case 'l': return va_arg(*arg, long);
+		case 'z': return (int32_t)va_arg(*arg, ptrdiff_t);
+		default:  return va_arg(*arg, int);
+	}
+}
+
+/**
+ * @brief  Read an unsigned integer argument of OLED_Printf
+ * @param  arg The argument list
+ * @param  size The length modifier, 'H': hh, 'h', 'l', 'z': z or t, 0: none
+ * @retval The argument, converted to its type first
+ */
+static uint32_t OLED_PrintArgUnsigned(va_list *arg, char size)
+{
+	switch (size)
+	{
+		case 'H': return (unsigned char)va_arg(*arg, unsigned int);
+		case 'h': return (unsigned short)va_arg(*arg, unsigned int);
+		case 'l': return va_arg(*arg, unsigned long);
+		case 'z': return (uint32_t)va_arg(*arg, size_t);
+		default:  return va_arg(*arg, unsigned int);
+	}
+}
+
+/**
+ * @brief  Print a formatted string on the OLED, supporting mixed input of ASCII and Chinese characters
+ * @param  x The x-coordinate of the top-left corner of the formatted string, range: [-32768,32767], screen area: [0,127]
+ * @param  y The y-coordinate of the top-left corner of the formatted string, range: [-32768,32767], screen area: [0,63]
+ * @param  font_size The font size, range: OLED_8X16 (8 pixels wide, 16 pixels high) or OLED_6X8 (6 pixels wide, 8 pixels high)
+ * @param  format The formatted string to display, consisting of visible ASCII characters or Chinese characters
+ * @param  ... Variable argument list for the formatted string
+ * @retval None
+ * @note   The conversions are %d %i %u %x %X %c %s %% and %k, with the flags '-', '0', '+', ' ' and '#',
+ *         a width, a precision, '*' for either, and the length modifiers 'hh', 'h', 'l', 'z' and 't' of up to 32 bits.
+ *         The precision of %d %i %u %x %X is the minimum number of digits as in the C library, "%.3d" shows 7 as "007".
+ *         '#' puts "0x" or "0X" before a nonzero %x or %X.
+ *         %k displays a fixed-point int: "%.2k" shows 12345 as "123.45", the precision is the number
+ *         of decimal places, range: [0,9]. The precision of %s is the maximum number of characters.
+ *         %f %F %e %E %g %G %a %A %p %n, 64-bit integers ('ll', 'j', 'L') and %ls are not supported:
+ *         their argument is skipped and the conversion character is displayed, so the following conversions
+ *         still get their own arguments. Unknown conversions are displayed the same way without taking an argument.
+ *
+ *         The characters are added to a text run as they are formatted, without a string buffer or the C library printf,
+ *         and drawn page by page like OLED_ShowString. Formatting stops when the text reaches the right edge of the drawing target.
+ *
+ *         Chinese characters to be displayed need to be defined in the OLED_CF16x16 array in OLED_Data.c file.
+ *         If a specified Chinese character is not found, a default graphic (a box with a question mark inside) will be displayed.
+ *         When the font size is OLED_8X16, Chinese characters are displayed normally in a 16*16 dot matrix.
+ *         When the font size is OLED_6X8, Chinese characters are displayed as '?' in a 6*8 dot matrix.
+ */
+void OLED_Printf(int16_t x, int16_t y, uint8_t font_size, char *format, ...)
+{
+	const char *p = format;
+	OLED_PrintSpec_t spec;
+	OLED_Run_t run;
+	uint8_t visible = (x < OLED_Target->width), point;
+	char size;
+	char sign[2] = {0};
+	uint32_t code, number;
+	int32_t value;
+	va_list arg;
+
+	OLED_RunBegin(&run, x, y, font_size);
+	va_start(arg, format);
+	while (visible && *p != '\0')
+	{
+		if (*p != '%')  // Text between the conversions
+		{
+			code = OLED_DecodeChar(&p);
+			if (code == 0) {break;}
+			visible = OLED_RunAdd(&run, code);
+			continue;
+		}
+
+		/* Flags, width, precision and length modifier of the conversion specification */
+		memset(&spec, 0, sizeof(spec));
+		spec.precision = -1;
+		for (p++; ; p++)
+		{
+			if (*p == '-') {spec.left = 1;}
+			else if (*p == '0') {spec.zero = 1;}
+			else if (*p == '#') {spec.alt = 1;}
+			else if (*p == '+') {spec.sign = '+';}
+			else if (*p == ' ') {if (spec.sign == 0) {spec.sign = ' ';}}  // '+' wins over ' '
+			else {break;}
+		}
+		if (*p == '*')
+		{
+			value = va_arg(arg, int);
+			if (value < 0)  // A negative width is the '-' flag
+			{
+				spec.left = 1;
+				value = -value;
+			}
+			spec.width = (value > 255) ? 255 : value;
+			p++;
+		}
+		for (; *p >= '0' && *p <= '9'; p++)
+		{
+			if (spec.width < 25) {spec.width = spec.width * 10 + (*p - '0');}
+		}
+		if (*p == '.')
+		{
+			spec.precision = 0;
+			if (*++p == '*')
+			{
+				value = va_arg(arg, int);
+				spec.precision = (value < 0) ? -1 : (value > 255) ? 255 : value;
+				p++;
+			}
+			for (; *p >= '0' && *p <= '9'; p++)
+			{
+				if (spec.precision < 25) {spec.precision = spec.precision * 10 + (*p - '0');}
+			}
+		}
+		/* Length modifier, 'H' for "hh", 'q' for the 64-bit "ll" and 'j', 'z' for 'z' and 't' */
+		size = 0;
+		if (*p == 'h' || *p == 'l' || *p == 'z' || *p == 't' || *p == 'j' || *p == 'L')
+		{
+			size = (*p == 't') ? 'z' : (*p == 'j') ? 'q' : *p;
+			if (p[1] == *p && (*p == 'h' || *p == 'l'))
+			{
+				size = (*p == 'h') ? 'H' : 'q';
+				p++;
+			}
+			p++;
+		}
+		if ((size == 'q' || size == 'L') && *p != '\0' && strchr("diuxXk", *p) != NULL)
+		{
+			(void)va_arg(arg, long long);  // 64-bit integers are skipped
+			visible = OLED_RunAdd(&run, (uint8_t)*p);
+			p++;
+			continue;
+		}
+
+		switch (*p)
+		{
+			case 'd':
+			case 'i':
+				value = OLED_PrintArgSigned(&arg, size);
+				number = (value < 0) ? 0U - (uint32_t)value : (uint32_t)value;
+				sign[0] = (value < 0) ? '-' : spec.sign;
+				visible = OLED_PrintNumber(&run, &spec, number, sign, "0123456789", 0, spec.precision);
+				break;
+			case 'k':
+				value = OLED_PrintArgSigned(&arg, size);
+				number = (value < 0) ? 0U - (uint32_t)value : (uint32_t)value;
+				sign[0] = (value < 0) ? '-' : spec.sign;
+				point = (spec.precision > 0) ? ((spec.precision > 9) ? 9 : spec.precision) : 0;
+				visible = OLED_PrintNumber(&run, &spec, number, sign, "0123456789", point, -1);
+				break;
+			case 'u':
+				number = OLED_PrintArgUnsigned(&arg, size);
+				visible = OLED_PrintNumber(&run, &spec, number, "", "0123456789", 0, spec.precision);
+				break;
+			case 'x':
+			case 'X':
+				number = OLED_PrintArgUnsigned(&arg, size);
+				visible = OLED_PrintNumber(&run, &spec, number, (spec.alt && number != 0) ? ((*p == 'x') ? "0x" : "0X") : "",
+				                           (*p == 'x') ? "0123456789abcdef" : "0123456789ABCDEF", 0, spec.precision);
+				break;
+			case 'c':
+				code = (uint8_t)va_arg(arg, int);
+				visible = OLED_PrintPad(&run, ' ', spec.left ? 0 : spec.width - 1)
+				          && OLED_RunAdd(&run, code)
+				          && OLED_PrintPad(&run, ' ', spec.left ? spec.width - 1 : 0);
+				break;
+			case 's':
+				if (size == 'l')  // Wide strings are skipped
+				{
+					(void)va_arg(arg, const void *);
+					visible = OLED_RunAdd(&run, 's');
+					break;
+				}
+				visible = OLED_PrintString(&run, &spec, va_arg(arg, const char *));
+				break;
+			case 'f':
+			case 'F':
+			case 'e':
+			case 'E':
+			case 'g':
+			case 'G':
+			case 'a':
+			case 'A':
+				if (size == 'L') {(void)va_arg(arg, long double);}
+				else {(void)va_arg(arg, double);}
+				visible = OLED_RunAdd(&run, (uint8_t)*p);
+				break;
+			case 'p':
+			case 'n':
+				(void)va_arg(arg, void *);
+				visible = OLED_RunAdd(&run, (uint8_t)*p);
+				break;
+			case '\0':  // A '%' at the end of the format
+				p--;
+				break;
+			default:     // "%%" and unsupported conversions
+				visible = OLED_RunAdd(&run, (uint8_t)*p);
+				break;
+		}
+		p++;
+	}
+	va_end(arg);
+	OLED_RunFlush(&run);
+}
+
+/* OLED Text Layout Functions -----------------------------------------------*/
+
+/**
+ * @brief  Get the advance width of a character
+ * @param  code The codepoint of the character
+ * @param  font_size The font size, range: OLED_8X16 or OLED_6X8
+ * @retval The width in pixels, the same as OLED_ShowString moves by
+ */
+static uint8_t OLED_CharWidth(uint32_t code, uint8_t font_size)
+{
+	uint8_t width, height;
+
+	OLED_GetGlyph(font_size, code, &width, &height);
+	return width;
+}
+
+/**
+ * @brief  Whether a character is a CJK character, which can be broken before and after like a word
+ * @param  code The codepoint of the character, or a GB2312 code
+ * @retval 1: CJK character, 0: other character
+ */
+static uint8_t OLED_IsCJK(uint32_t code)
+{
+#ifdef OLED_CHARSET_GB2312
+	return code >= 0xA1A1;
+#else
+	return code >= 0x2E80;
+#endif
+}
+
+/**
+ * @brief  Measure the width of a string
+ * @param  str The string, consisting of visible ASCII characters or Chinese characters
+ * @param  font_size The font size, range: OLED_8X16 (8 pixels wide, 16 pixels high) or OLED_6X8 (6 pixels wide, 8 pixels high)
+ * @retval The width in pixels that OLED_ShowString takes for the string
+ * @note   The characters are decoded and looked up like OLED_ShowString, Chinese characters are 16 pixels wide
+ *         in OLED_8X16 and missing characters take the width of the default figure. Nothing is drawn.
+ */
+int16_t OLED_MeasureString(const char *str, uint8_t font_size)
+{
+	int16_t width = 0;
+	uint32_t code;
+
+	while ((code = OLED_DecodeChar(&str)) != 0)
+	{
+		width += OLED_CharWidth(code, font_size);
+	}
+	return width;
+}
+
+/**
+ * @brief  Cut a line of a text layout so that it fits with an ellipsis
+ * @param  str The string
+ * @param  line The line, it is replaced by the longest part of the string from its start that fits
+ * @param  width The width of the text box
+ * @param  font_size The font size
+ * @retval None
+ * @note   The part stops before a line feed, it may be longer than the line when the line ended at a break.
+ */
+static void OLED_EllipsizeLine(const char *str, OLED_TextLine_t *line, int16_t width, uint8_t font_size)
+{
+	const char *p = str + line->start, *next = p;
+	int16_t ellipsis = 3 * OLED_CharWidth('.', font_size), used = 0;
+	uint32_t code;
+	uint8_t w;
+
+	while ((code = OLED_DecodeChar(&next)) != 0 && code != '\n')
+	{
+		w = OLED_CharWidth(code, font_size);
+		if (used + w + ellipsis > width) {break;}
+		used += w;
+		p = next;
+	}
+
+	line->length = p - (str + line->start);
+	line->width = used + ellipsis;
+	line->ellipsis = 1;
+}
+
+/**
+ * @brief  Lay out a string in a text box, breaking it into lines
+ * @param  str The string, consisting of visible ASCII characters, Chinese characters and line feeds, at most 65535 bytes
+ * @param  width The width of the text box in pixels
+ * @param  height The height of the text box in pixels, it limits the number of lines, at least one line
+ * @param  font_size The font size, range: OLED_8X16 (16 pixels per line) or OLED_6X8 (8 pixels per line)
+ * @param  flags The wrap mode OLED_TEXT_NO_WRAP, OLED_TEXT_WRAP_CHAR or OLED_TEXT_WRAP_WORD,
+ *               optionally combined with OLED_TEXT_ELLIPSIS, the alignment is ignored here
+ * @param  lines The lines of the layout, written by this function
+ * @param  max_lines The size of lines, 0: nothing is laid out
+ * @retval The number of lines
+ * @note   Only the string and the fonts are read, the layout can be kept and drawn with OLED_ShowTextLines
+ *         as long as the string does not change.
+ *         A line ends at a line feed, or where the next character would not fit into the width:
+ *         at the last space or CJK character boundary with OLED_TEXT_WRAP_WORD, or at that character otherwise.
+ *         The spaces at a break, and those at the start of a wrapped line that do not fit, are dropped. Without wrapping, the rest of a line that does not fit is skipped.
+ *         With OLED_TEXT_ELLIPSIS, a line that lost characters, and the last line when there is more text
+ *         than lines, ends with "..." within the width.
+ */
+uint8_t OLED_LayoutText(const char *str, int16_t width, int16_t height, uint8_t font_size, uint8_t flags,
+                        OLED_TextLine_t *lines, uint8_t max_lines)
+{
+	const char *p = str, *start, *next, *end, *break_at;
+	int16_t line_width, break_width;
+	uint8_t count = 0, wrap = flags & 0x30, cut, text, w;
+	uint32_t code, last;
+
+	if (max_lines == 0) {return 0;}
+
+	/* Number of lines that fit into the height */
+	height /= (font_size == OLED_8X16) ? 16 : 8;
+	if (height < 1) {height = 1;}
+	if (height < max_lines) {max_lines = height;}
+
+	while (count < max_lines)
+	{
+		start = p;
+		break_at = NULL;
+		break_width = line_width = 0;
+		last = 0;
+		cut = 0;
+		text = 0;
+
+		/* Add characters until the end of the string, a line feed or the first character that does not fit */
+		while (1)
+		{
+			next = p;
+			code = OLED_DecodeChar(&next);
+			if (code == 0 || code == '\n')
+			{
+				end = p;
+				break;
+			}
+
+			/* Word breaks before a space, before and after CJK characters,
+			   not before the first character other than a space, which would leave an empty line */
+			if (text && (code == ' ' || OLED_IsCJK(code) || OLED_IsCJK(last)))
+			{
+				break_at = p;
+				break_width = line_width;
+			}
+
+			w = OLED_CharWidth(code, font_size);
+			if (line_width + w > width && p != start)
+			{
+				/* Spaces wider than the width at the start of a wrapped line are dropped like those at a break */
+				if (!text && wrap != OLED_TEXT_NO_WRAP)
+				{
+					while (*p == ' ') {p++;}
+					start = p;
+					line_width = 0;
+					continue;
+				}
+				end = p;
+				if (wrap == OLED_TEXT_WRAP_WORD && break_at != NULL)
+				{
+					end = break_at;
+					line_width = break_width;
+				}
+				cut = 1;
+				break;
+			}
+			line_width += w;
+			last = code;
+			if (code != ' ') {text = 1;}
+			p = next;
+		}
+
+		/* The trailing spaces of a wrapped line are not part of it */
+		if (cut && wrap != OLED_TEXT_NO_WRAP)
+		{
+			while (end > start && end[-1] == ' ')
+			{
+				end--;
+				line_width -= OLED_CharWidth(' ', font_size);
+			}
+		}
+
+		lines[count].start = start - str;
+		lines[count].length = end - start;
+		lines[count].width = line_width;
+		lines[count].ellipsis = 0;
+		count++;
+
+		/* Continue after the line: skip the rest of a cut line, or the spaces at a break */
+		p = end;
+		if (cut && wrap == OLED_TEXT_NO_WRAP)
+		{
+			if ((flags & OLED_TEXT_ELLIPSIS) != 0) {OLED_EllipsizeLine(str, &lines[count - 1], width, font_size);}
+			while (*p != '\0' && *p != '\n') {p++;}
+		}
+		else if (cut)
+		{
+			while (*p == ' ') {p++;}
+		}
+		if (*p == '\0') {return count;}
+		if (*p == '\n') {p++;}
+	}
+
+	/* More text than lines */
+	if ((flags & OLED_TEXT_ELLIPSIS) != 0 && *p != '\0')
+	{
+		OLED_EllipsizeLine(str, &lines[count - 1], width, font_size);
+	}
+	return count;
+}
+
+/**
+ * @brief  Display the lines of a text layout on the OLED
+ * @param  x The x-coordinate of the top-left corner of the text box, range: [-32768,32767], screen area: [0,127]
+ * @param  y The y-coordinate of the top-left corner of the text box, range: [-32768,32767], screen area: [0,63]
+ * @param  width The width of the text box in pixels, the lines are aligned in it
+ * @param  str The string the layout was made for
+ * @param  lines The lines from OLED_LayoutText
+ * @param  count The number of lines
+ * @param  font_size The font size, range: OLED_8X16 (8 pixels wide, 16 pixels high) or OLED_6X8 (6 pixels wide, 8 pixels high)
+ * @param  flags The alignment OLED_TEXT_LEFT, OLED_TEXT_CENTER or OLED_TEXT_RIGHT, the other flags are ignored here
+ * @retval None
+ */
+void OLED_ShowTextLines(int16_t x, int16_t y, int16_t width, const char *str, const OLED_TextLine_t *lines, uint8_t count,
+                        uint8_t font_size, uint8_t flags)
+{
+	int16_t line_x;
+	uint8_t i;
+
+	for (i = 0; i < count; i++, y += (font_size == OLED_8X16) ? 16 : 8)
+	{
+		line_x = x;
+		if ((flags & 0x03) == OLED_TEXT_CENTER) {line_x += (width - lines[i].width) / 2;}
+		else if ((flags & 0x03) == OLED_TEXT_RIGHT) {line_x += width - lines[i].width;}
+
+		line_x = OLED_ShowRun(line_x, y, str + lines[i].start, lines[i].length, font_size);
+		if (lines[i].ellipsis)
+		{
+			OLED_ShowRun(line_x, y, "...", 3, font_size);
+		}
+	}
+}
+
+/**
+ * @brief  Display a string in a text box on the OLED, wrapped and aligned
+ * @param  x The x-coordinate of the top-left corner of the text box, range: [-32768,32767], screen area: [0,127]
+ * @param  y The y-coordinate of the top-left corner of the text box, range: [-32768,32767], screen area: [0,63]
+ * @param  width The width of the text box in pixels
+ * @param  height The height of the text box in pixels, at most OLED_TEXT_MAX_LINES lines are shown
+ * @param  str The string, consisting of visible ASCII characters, Chinese characters and line feeds
+ * @param  font_size The font size, range: OLED_8X16 (8 pixels wide, 16 pixels high) or OLED_6X8 (6 pixels wide, 8 pixels high)
+ * @param  flags The alignment combined with the wrap mode and OLED_TEXT_ELLIPSIS,
+ *               like OLED_TEXT_CENTER | OLED_TEXT_WRAP_WORD | OLED_TEXT_ELLIPSIS
+ * @retval None
+ * @note   The layout is made on every call, use OLED_LayoutText and OLED_ShowTextLines to keep it for static text.
+ */
+void OLED_ShowTextBox(int16_t x, int16_t y, int16_t width, int16_t height, const char *str, uint8_t font_size, uint8_t flags)
+{
+	OLED_TextLine_t lines[OLED_TEXT_MAX_LINES];
+	uint8_t count;
+
+	count = OLED_LayoutText(str, width, height, font_size, flags, lines, OLED_TEXT_MAX_LINES);
+	OLED_ShowTextLines(x, y, width, str, lines, count, font_size, flags);
+}
+
+/* OLED Screen Surface Functions --------------------------------------------*/
+
+/**
+ * @brief  Initialize an off-screen surface
+ * @param  surface The surface to initialize
+ * @param  buf The memory of the surface provided by the caller, at least OLED_SURFACE_SIZE(width, height) bytes
+ * @param  width The width of the surface, range: [1,32767]
+ * @param  height The height of the surface, range: [1,32767]
+ * @retval None
+ * @note   The memory uses the same page format as the OLED display memory array,
+ *         (height + 7) / 8 pages of width bytes each. It is not cleared here.
+ */
+void OLED_SurfaceInit(OLED_Surface_t *surface, uint8_t *buf, int16_t width, int16_t height)
+{
+	surface->buf = buf;
+	surface->width = width;
+	surface->height = height;
+}
+
+/**
+ * @brief  Set the drawing target of all display and draw geometry functions
+ * @param  surface The surface to draw on, NULL selects the OLED display memory array
+ * @retval None
+ * @note   OLED_Update and OLED_UpdateArea always send the OLED display memory array.
+ */
+void OLED_SetTarget(OLED_Surface_t *surface)
+{
+	OLED_Target = (surface != NULL) ? surface : &OLED_Screen;
+#if OLED_USE_BITBAND
+	OLED_TargetAlias = OLED_BITBAND_ALIAS(OLED_Target->buf);
+#endif
+}
+
+/**
+ * @brief  Get the current drawing target
+ * @param  None
+ * @retval The current drawing target, &OLED_Screen if no surface was set
+ */
+OLED_Surface_t *OLED_GetTarget(void)
+{
+	return OLED_Target;
+}
+
+/**
+ * @brief  Copy an area of a surface to the drawing target
+ * @param  x The x-coordinate of the top-left corner of the destination area, range: [-32768,32767]
+ * @param  y The y-coordinate of the top-left corner of the destination area, range: [-32768,32767]
+ * @param  width The width of the area, range: [0,32767]
+ * @param  height The height of the area, range: [0,32767]
+ * @param  src The source surface, must not be the drawing target
+ * @param  src_x The x-coordinate of the top-left corner of the area in the source surface
+ * @param  src_y The y-coordinate of the top-left corner of the area in the source surface
+ * @retval None
+ * @note   The area is clipped to both the source surface and the drawing target, and replaces the destination content.
+ *         Each destination page byte is built from at most two source page bytes,
+ *         so a page-aligned copy costs one load and one store per byte.
+ */
+void OLED_BlitSurface(int16_t x, int16_t y, int16_t width, int16_t height, const OLED_Surface_t *src, int16_t src_x, int16_t src_y)
+{
+	int16_t i, page, page1, src_row, src_page, src_pages, shift;
+	int16_t target_width = OLED_Target->width;
+	uint8_t mask, data;
+	uint8_t *dst;
+	const uint8_t *src_lo, *src_hi;
+
+	/* Clip the area to the source surface */
+	if (src_x < 0) {x -= src_x; width += src_x; src_x = 0;}
+	if (src_y < 0) {y -= src_y; height += src_y; src_y = 0;}
+	if (src_x + width > src->width) {width = src->width - src_x;}
+	if (src_y + height > src->height) {height = src->height - src_y;}
+
+	/* Clip the area to the drawing target */
+	if (x < 0) {src_x -= x; width += x; x = 0;}
+	if (y < 0) {src_y -= y; height += y; y = 0;}
+	if (x + width > target_width) {width = target_width - x;}
+	if (y + height > OLED_Target->height) {height = OLED_Target->height - y;}
+
+	if (width <= 0 || height <= 0) {return;}
+
+	page = y / 8;
+	page1 = (y + height - 1) / 8;
+	src_pages = (src->height + 7) / 8;
+
+	/* Iterate through the destination pages involved in the area */
+	for (; page <= page1; page++)
+	{
+		// Mask of the rows of this page inside the area
+		mask = 0xFF;
+		if (page * 8 < y) {mask &= 0xFF << (y - page * 8);}
+		if (page * 8 + 8 > y + height) {mask &= 0xFF >> (page * 8 + 8 - y - height);}
+
+		// The first row of this page maps to this source row, rows above src_y are masked out
+		src_row = page * 8 + src_y - y;
+		src_page = (src_row >= 0) ? src_row / 8 : -1;
+		shift = src_row - src_page * 8;
+
+		// The two source pages that overlap this destination page
+		dst = &OLED_Target->buf[page * target_width + x];
+		src_lo = (src_page >= 0) ? &src->buf[src_page * src->width + src_x] : NULL;
+		src_hi = (shift != 0 && src_page + 1 < src_pages) ? &src->buf[(src_page + 1) * src->width + src_x] : NULL;
+
+		/* Iterate through the columns of the area */
+		for (i = 0; i < width; i++)
+		{
+			// Combine the two source page bytes that overlap this destination page byte
+			data = 0;
+			if (src_lo != NULL) {data = src_lo[i] >> shift;}
+			if (src_hi != NULL) {data |= src_hi[i] << (8 - shift);}
+
+			dst[i] = (dst[i] & ~mask) | (data & mask);
+		}
+	}
+}
+
+/* OLED Screen Draw Geometry Functions ---------------------------------------*/
+
+/**
+ * @brief  Draw a point on the OLED at the specified position
+ * @param  x The x-coordinate of the point, range: [-32768,32767], screen area: [0,127]
+ * @param  y The y-coordinate of the point, range: [-32768,32767], screen area: [0,63]
+ * @retval None
+ * @note   With bit-band access, the point is set by a single store to its alias word without read-modify-write.
+ */
+void OLED_DrawPoint(int16_t x, int16_t y)
+{
+	if (x >= 0 && x < OLED_Target->width && y >= 0 && y < OLED_Target->height)  // Content outside the drawing target will not be displayed
+	{
+#if OLED_USE_BITBAND
+		// Write 1 to the alias word of the specified bit in the drawing target
+		OLED_BITBAND_STORE(OLED_BITBAND_PIXEL(x, y), 1);
+#else
+		// Set the bit data at the specified position in the drawing target to 1
+		OLED_Target->buf[y / 8 * OLED_Target->width + x] |= 0x01 << (y % 8);
+#endif
+	}
+}
+
+/**
+ * @brief  Get the value of a point at the specified position on the OLED
+ * @param  x The x-coordinate of the point, range: [-32768,32767], screen area: [0,127]
+ * @param  y The y-coordinate of the point, range: [-32768,32767], screen area: [0,63]
+ * @retval Whether the point at the specified position is lit, 1: lit, 0: off
+ */
+uint8_t OLED_GetPoint(int16_t x, int16_t y)
+{
+	if (x >= 0 && x < OLED_Target->width && y >= 0 && y < OLED_Target->height)  // Content outside the drawing target will not be read
+	{
+#if OLED_USE_BITBAND
+		// The alias word of the specified bit reads as 0 or 1
+		return (uint8_t)OLED_BITBAND_LOAD(OLED_BITBAND_PIXEL(x, y));
+#else
+		// Check the data at the specified position
+		if (OLED_Target->buf[y / 8 * OLED_Target->width + x] & 0x01 << (y % 8))
+		{
+			return 1;	 // If it's 1, return 1
+		}
+#endif
+	}
+	
+	return 0;  // Otherwise, return 0
+}
+
+/**
+ * @brief  Draw a set of points on the OLED
+ * @param  x The x-coordinates of the points, range: [-32768,32767], screen area: [0,127]
+ * @param  y The y-coordinates of the points, range: [-32768,32767], screen area: [0,63]
+ * @param  count The number of points
+ * @retval None
+ * @note   The drawing target is looked up once for all points.
+ */
+void OLED_DrawPoints(const int16_t *x, const int16_t *y, uint16_t count)
+{
+	uint8_t *buf = OLED_Target->buf;
+	int16_t width = OLED_Target->width, height = OLED_Target->height;
+	uint16_t i;
+
+	for (i = 0; i < count; i++)
+	{
+		if (x[i] >= 0 && x[i] < width && y[i] >= 0 && y[i] < height)  // Content outside the drawing target will not be displayed
+		{
+			buf[y[i] / 8 * width + x[i]] |= 0x01 << (y[i] % 8);
+		}
+	}
+}
+
+/**
+ * @brief  Draw a horizontal line on the drawing target
+ * @param  x0 The x-coordinate of the left end, range: [-32768,32767]
+ * @param  x1 The x-coordinate of the right end, range: [-32768,32767], x1 >= x0
+ * @param  y The y-coordinate of the line, range: [-32768,32767]
+ * @retval None
+ * @note   The line is clipped once, then one bit mask is ORed into each column of its page.
+ */
+static void OLED_DrawHLine(int16_t x0, int16_t x1, int16_t y)
+{
+	uint8_t *p, mask;
+	int16_t x;
+
+	if (y < 0 || y >= OLED_Target->height) {return;}
+	if (x0 < 0) {x0 = 0;}
+	if (x1 >= OLED_Target->width) {x1 = OLED_Target->width - 1;}
+
+	p = OLED_Target->buf + y / 8 * OLED_Target->width;
+	mask = 0x01 << (y % 8);
+	for (x = x0; x <= x1; x++)
+	{
+		p[x] |= mask;
+	}
+}
+
+/**
+ * @brief  Draw a vertical line on the drawing target
+ * @param  x The x-coordinate of the line, range: [-32768,32767]
+ * @param  y0 The y-coordinate of the top end, range: [-32768,32767]
+ * @param  y1 The y-coordinate of the bottom end, range: [-32768,32767], y1 >= y0
+ * @retval None
+ * @note   The line is clipped once, then every page it crosses is set with a single mask OR.
+ */
+static void OLED_DrawVLine(int16_t x, int16_t y0, int16_t y1)
+{
+	uint8_t *p;
+	int16_t page, last_page;
+
+	if (x < 0 || x >= OLED_Target->width) {return;}
+	if (y0 < 0) {y0 = 0;}
+	if (y1 >= OLED_Target->height) {y1 = OLED_Target->height - 1;}
+	if (y0 > y1) {return;}
+
+	page = y0 / 8;
+	last_page = y1 / 8;
+	p = OLED_Target->buf + page * OLED_Target->width + x;
+
+	if (page == last_page)  // The line lies within one page
+	{
+		*p |= (0xFF << (y0 % 8)) & (0xFF >> (7 - y1 % 8));
+		return;
+	}
+
+	*p |= 0xFF << (y0 % 8);  // Lower part of the first page
+	for (page++, p += OLED_Target->width; page < last_page; page++, p += OLED_Target->width)
+	{
+		*p = 0xFF;  // Full pages in between
+	}
+	*p |= 0xFF >> (7 - y1 % 8);  // Upper part of the last page
+}
+
+/**
+ * @brief  Get the Cohen-Sutherland outcode of a point relative to the drawing target
+ * @param  x The x-coordinate of the point
+ * @param  y The y-coordinate of the point
+ * @retval The outcode, bit 0: left, bit 1: right, bit 2: above, bit 3: below, 0: inside
+ */
+static inline uint8_t OLED_OutCode(int16_t x, int16_t y)
+{
+	uint8_t code = 0;
+
+	if (x < 0) {code |= 0x01;}
+	else if (x >= OLED_Target->width) {code |= 0x02;}
+	if (y < 0) {code |= 0x04;}
+	else if (y >= OLED_Target->height) {code |= 0x08;}
+	return code;
+}
+
+/**
+ * @brief  Get the first step of a line at which the minor axis has grown by a given amount
+ * @param  du The length of the major axis, range: [1,65535]
+ * @param  dv The length of the minor axis, range: [1,du]
+ * @param  t The growth of the minor axis, range: [1,dv]
+ * @retval The smallest k with floor((2 * dv * k + du) / (2 * du)) >= t, that is ceil((2 * du * t - du) / (2 * dv))
+ * @note   2 * du * t does not fit in 32 bits, but du * t does: with du * t = q * dv + r the result is
+ *         q + ceil((2 * r - du) / (2 * dv)), which needs no 64-bit division on the Cortex-M3.
+ */
+static inline int32_t OLED_LineStep(uint32_t du, uint32_t dv, uint32_t t)
+{
+	uint32_t a = du * t;
+	int32_t n = (int32_t)(2 * (a % dv)) - (int32_t)du;
+
+	// C division truncates towards zero, which is the ceiling for n <= 0
+	return (int32_t)(a / dv) + ((n > 0) ? (n + 2 * (int32_t)dv - 1) / (2 * (int32_t)dv) : n / (2 * (int32_t)dv));
+}
+
+/**
+ * @brief  Rasterise a diagonal line into the page bytes of the drawing target
+ * @param  x0 The x-coordinate of one endpoint, range: [-32768,32767]
+ * @param  y0 The y-coordinate of one endpoint, range: [-32768,32767]
+ * @param  x1 The x-coordinate of the other endpoint, range: [-32768,32767], x1 != x0
+ * @param  y1 The y-coordinate of the other endpoint, range: [-32768,32767], y1 != y0
+ * @param  clip Whether an endpoint may lie outside the drawing target, 0: skip the clipping
+ * @retval None
+ * @note   Shared by OLED_DrawLine and OLED_DrawPolyline, which already know the outcodes of the endpoints.
+ */
+static void OLED_DrawLineRuns(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t clip)
+{
+	int32_t u0, v0, u1, v1, du, dv, d, incrE, incrNE, k, k_start, k_end, m, lo, hi, temp;
+	int16_t width = OLED_Target->width, height = OLED_Target->height;
+	uint8_t yflag = 0, xyflag = 0, column, mask, run;
+	uint8_t *p;
+
+	/* Use the Bresenham's algorithm to draw a line, which avoids time-consuming floating-point operations and is more efficient */
+	/* Reference document: https://www.cs.montana.edu/courses/spring2009/425/dslectures/Bresenham.pdf */
+	/* Reference tutorial: https://www.bilibili.com/video/BV1364y1d7Lo */
+
+	/* Transform the line into the 0~45 degrees range of the first quadrant, as (u, v) with u as the major axis */
+	if (x0 > x1)  // Swap the endpoints so that the line is drawn from left to right
+	{
+		temp = x0; x0 = x1; x1 = temp;
+		temp = y0; y0 = y1; y1 = temp;
+	}
+	u0 = x0; v0 = y0; u1 = x1; v1 = y1;
+	if (v0 > v1)  // Negate the y-coordinates so that the line goes up, remembered by yflag
+	{
+		v0 = -v0;
+		v1 = -v1;
+		yflag = 1;
+	}
+	if (v1 - v0 > u1 - u0)  // Swap x and y if the slope is greater than 1, remembered by xyflag
+	{
+		temp = u0; u0 = v0; v0 = temp;
+		temp = u1; u1 = v1; v1 = temp;
+		xyflag = 1;
+	}
+
+	du = u1 - u0;
+	dv = v1 - v0;
+	incrE = 2 * dv;
+	incrNE = 2 * (dv - du);
+
+	/* Clip once up front: the ranges of u and v whose points lie inside the drawing target */
+	k_start = 0;
+	k_end = du;
+	if (clip)
+	{
+		if (xyflag)
+		{
+			lo = yflag ? -(height - 1) : 0;
+			hi = yflag ? 0 : height - 1;
+		}
+		else
+		{
+			lo = 0;
+			hi = width - 1;
+		}
+		if (lo > u0) {k_start = lo - u0;}
+		if (hi < u1) {k_end = hi - u0;}
+
+		// After k steps, v has grown by m = floor((2 * dv * k + du) / (2 * du)),
+		// so the steps where v enters and leaves its range follow without walking the line
+		if (xyflag)
+		{
+			lo = 0;
+			hi = width - 1;
+		}
+		else
+		{
+			lo = yflag ? -(height - 1) : 0;
+			hi = yflag ? 0 : height - 1;
+		}
+		if (hi < v0 || lo > v1) {return;}
+		if (lo > v0)
+		{
+			temp = OLED_LineStep(du, dv, lo - v0);
+			if (temp > k_start) {k_start = temp;}
+		}
+		if (hi < v1)
+		{
+			temp = OLED_LineStep(du, dv, hi - v0 + 1) - 1;
+			if (temp < k_end) {k_end = temp;}
+		}
+		if (k_start > k_end) {return;}
+	}
 
-	/* A negative coordinate needs an offset when calculating the page address and shift */
-	page = y / 8;
-	shift = y % 8;
-	if (y < 0)
+	/* Restore the state of the Bresenham's algorithm at the first visible step */
+	k = k_start;
+	m = 0;
+	d = incrE - du;
+	if (k > 0)  // With dv * k = q * du + r: m = q + (2 * r >= du), d = incrE - du + 2 * r - 2 * du * (m - q)
 	{
-		page -= 1;
-		shift += 8;
+		m = (uint32_t)dv * k / du;
+		temp = (uint32_t)dv * k % du;
+		if (2 * temp >= du)
+		{
+			m++;
+			temp -= du;
+		}
+		d += 2 * temp;
 	}
+	u0 += k;
+	v0 += m;
 
-	// Clear the area where the image will be displayed
-	OLED_ClearArea(x, y, width, height);
-	
-	/* Iterate through the relevant pages involved in the specified image */
-	for (j = 0; j < (height - 1) / 8 + 1; j++)  // (height - 1) / 8 + 1 is used to round up height / 8
+	if (!xyflag)  // Shallow line: one pixel per column, v moves within the page or to the next one
 	{
-		/* Iterate through the relevant columns involved in the specified image */
-		for (i = 0; i < width; i++)
+		temp = yflag ? -v0 : v0;
+		p = OLED_Target->buf + temp / 8 * width + u0;
+		mask = 0x01 << (temp % 8);
+
+		for (;;)
 		{
-			if (x + i >= 0 && x + i <= 127)  // Content outside the screen will not be displayed
+			*p |= mask;
+			if (k++ == k_end) {break;}
+
+			p++;
+			if (d < 0)  // The next point is to the east of the current point
+			{
+				d += incrE;
+			}
+			else  // The next point is to the northeast of the current point
 			{
-				if (page + j >= 0 && page + j <= 7)  // Content outside the screen will not be displayed
+				d += incrNE;
+				if (yflag)
 				{
-					// Display the content of the image on the current page
-					OLED_DisplayBuf[page + j][x + i] |= image[j * width + i] << (shift);
+					mask >>= 1;
+					if (mask == 0) {mask = 0x80; p -= width;}
 				}
-				
-				if (page + j + 1 >= 0 && page + j + 1 <= 7)  // Content outside the screen will not be displayed
-				{					
-					// Display the content of the image on the next page
-					OLED_DisplayBuf[page + j + 1][x + i] |= image[j * width + i] >> (8 - shift);
+				else
+				{
+					mask <<= 1;
+					if (mask == 0) {mask = 0x01; p += width;}
 				}
 			}
 		}
 	}
-}
-
-/**
- * @brief  Use the printf function to print a formatted string on the OLED, supporting mixed input of ASCII and Chinese characters
- * @param  x The x-coordinate of the top-left corner of the formatted string, range: [-32768,32767], screen area: [0,127]
- * @param  y The y-coordinate of the top-left corner of the formatted string, range: [-32768,32767], screen area: [0,63]
- * @param  font_size The font size, range: OLED_8X16 (8 pixels wide, 16 pixels high) or OLED_6X8 (6 pixels wide, 8 pixels high)
- * @param  format The formatted string to display, consisting of visible ASCII characters or Chinese characters
- * @param  ... Variable argument list for the formatted string
- * @retval None
- * @note   Chinese characters to be displayed need to be defined in the OLED_CF16x16 array in OLED_Data.c file.
- *         If a specified Chinese character is not found, a default graphic (a box with a question mark inside) will be displayed.
- *         When the font size is OLED_8X16, Chinese characters are displayed normally in a 16*16 dot matrix.
- *         When the font size is OLED_6X8, Chinese characters are displayed as '?' in a 6*8 dot matrix.
- */
-void OLED_Printf(int16_t x, int16_t y, uint8_t font_size, char *format, ...)
-{
-	char str[256];						   // Define a character array
-	va_list arg;							   // Define a variable of variable argument list data type
-	va_start(arg, format);			 // Start receiving the argument list from format into the arg variable
-	vsprintf(str, format, arg);  // Use vsprintf to print the formatted string and argument list into the character array
-	va_end(arg);							   // End the variable arg
-	OLED_ShowString(x, y, str, font_size);	 // Display the character array (string) on the OLED
-}
-
-/* OLED Screen Draw Geometry Functions ---------------------------------------*/
-
-/**
- * @brief  Draw a point on the OLED at the specified position
- * @param  x The x-coordinate of the point, range: [-32768,32767], screen area: [0,127]
- * @param  y The y-coordinate of the point, range: [-32768,32767], screen area: [0,63]
- * @retval None
- */
-void OLED_DrawPoint(int16_t x, int16_t y)
-{
-	if (x >= 0 && x <= 127 && y >=0 && y <= 63)		// Content outside the screen will not be displayed
+	else  // Steep line: collect the run of pixels in the same column and page, then OR them at once
 	{
-		// Set the bit data at the specified position in the display buffer array to 1
-		OLED_DisplayBuf[y / 8][x] |= 0x01 << (y % 8);
-	}
-}
+		temp = yflag ? -u0 : u0;
+		p = OLED_Target->buf + temp / 8 * width + v0;
+		mask = 0x01 << (temp % 8);
+		run = 0;
 
-/**
- * @brief  Get the value of a point at the specified position on the OLED
- * @param  x The x-coordinate of the point, range: [-32768,32767], screen area: [0,127]
- * @param  y The y-coordinate of the point, range: [-32768,32767], screen area: [0,63]
- * @retval Whether the point at the specified position is lit, 1: lit, 0: off
- */
-uint8_t OLED_GetPoint(int16_t x, int16_t y)
-{
-	if (x >= 0 && x <= 127 && y >=0 && y <= 63)		// Content outside the screen will not be read
-	{
-		// Check the data at the specified position
-		if (OLED_DisplayBuf[y / 8][x] & 0x01 << (y % 8))
+		for (;;)
 		{
-			return 1;	 // If it's 1, return 1
+			run |= mask;
+			if (k++ == k_end) {break;}
+
+			mask = yflag ? mask >> 1 : mask << 1;
+			column = (d >= 0);  // Whether the next point is in the next column
+			d += column ? incrNE : incrE;
+
+			if (column || mask == 0)  // The run ends at the next column or the page boundary
+			{
+				*p |= run;
+				run = 0;
+			}
+			if (column) {p++;}
+			if (mask == 0)
+			{
+				mask = yflag ? 0x80 : 0x01;
+				p += yflag ? -width : width;
+			}
 		}
+		*p |= run;
 	}
-	
-	return 0;  // Otherwise, return 0
 }
 
 /**
@@ -838,106 +3074,123 @@ uint8_t OLED_GetPoint(int16_t x, int16_t y)
  * @param  x1 The x-coordinate of the other endpoint, range: [-32768,32767], screen area: [0,127]
  * @param  y1 The y-coordinate of the other endpoint, range: [-32768,32767], screen area: [0,63]
  * @retval None
+ * @note   The line is clipped against the drawing target once before drawing if an endpoint is outside it,
+ *         and is then rasterised directly into the page bytes: the pixels a steep line sets in the same column
+ *         of a page are collected into one mask and written with a single OR.
  */
 void OLED_DrawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1)
 {
-	int16_t x, y, dx, dy, d, incrE, incrNE, temp;
-	int16_t x0_ = x0, y0_ = y0, x1_ = x1, y1_ = y1;
-	uint8_t yflag = 0, xyflag = 0;
-	
-	if (y0_ == y1_)  // Handle horizontal lines separately
+	int16_t temp;
+
+	if (y0 == y1)  // Handle horizontal lines separately
 	{
 		// If the x-coordinate of point 0 is greater than that of point 1, swap their x-coordinates
-		if (x0_ > x1_) {temp = x0_; x0_ = x1_; x1_ = temp;}
-		
-		/* Iterate through the x-coordinates */
-		for (x = x0_; x <= x1_; x++)
-		{
-			OLED_DrawPoint(x, y0_);	 // Draw points sequentially
-		}
+		if (x0 > x1) {temp = x0; x0 = x1; x1 = temp;}
+		OLED_DrawHLine(x0, x1, y0);
+		return;
 	}
-	else if (x0_ == x1_)	 // Handle vertical lines separately
+	if (x0 == x1)  // Handle vertical lines separately
 	{
 		// If the y-coordinate of point 0 is greater than that of point 1, swap their y-coordinates
-		if (y0_ > y1_) {temp = y0_; y0_ = y1_; y1_ = temp;}
-		
-		/* Iterate through the y-coordinates */
-		for (y = y0_; y <= y1_; y++)
-		{
-			OLED_DrawPoint(x0_, y);	 // Draw points sequentially
-		}
+		if (y0 > y1) {temp = y0; y0 = y1; y1 = temp;}
+		OLED_DrawVLine(x0, y0, y1);
+		return;
 	}
-	else  // Handle diagonal lines
+
+	OLED_DrawLineRuns(x0, y0, x1, y1, (OLED_OutCode(x0, y0) | OLED_OutCode(x1, y1)) != 0);
+}
+
+
+/**
+ * @brief  Draw connected lines through a list of points on the OLED
+ * @param  x The x-coordinates of the points, range: [-32768,32767], screen area: [0,127]
+ * @param  y The y-coordinates of the points, range: [-32768,32767], screen area: [0,63]
+ * @param  count The number of points
+ * @retval None
+ * @note   The outcode of each point is computed once and shared by the two segments meeting there,
+ *         segments entirely on one side outside the drawing target are skipped without any setup,
+ *         and segments with both endpoints inside are rasterised without clipping.
+ */
+void OLED_DrawPolyline(const int16_t *x, const int16_t *y, uint16_t count)
+{
+	uint8_t code, last_code;
+	uint16_t i;
+
+	if (count == 0) {return;}
+	if (count == 1)
 	{
-		/* Use the Bresenham's algorithm to draw a line, which avoids time-consuming floating-point operations and is more efficient */
-		/* Reference document: https://www.cs.montana.edu/courses/spring2009/425/dslectures/Bresenham.pdf */
-		/* Reference tutorial: https://www.bilibili.com/video/BV1364y1d7Lo */
+		OLED_DrawPoint(x[0], y[0]);
+		return;
+	}
 
-		if (x0_ > x1_)  // If the x-coordinate of point 0 is greater than that of point 1
-		{
-      // Swap the coordinates of the two points
-			// After swapping, it does not affect the line drawing, but the drawing direction changes from the first, second, third, and fourth quadrants to the first and fourth quadrants
-			temp = x0_; x0_ = x1_; x1_ = temp;
-			temp = y0_; y0_ = y1_; y1_ = temp;
-		}
-		
-		if (y0_ > y1_)  // If the y-coordinate of point 0 is greater than that of point 1
+	last_code = OLED_OutCode(x[0], y[0]);
+	for (i = 1; i < count; i++)
+	{
+		code = OLED_OutCode(x[i], y[i]);
+		if ((code & last_code) == 0)  // Both endpoints outside on the same side: nothing to draw
 		{
-			// Negate the y-coordinates
-			// Negating affects the line drawing, but the drawing direction changes from the first and fourth quadrants to the first quadrant
-			y0_ = -y0_;
-			y1_ = -y1_;
-			
-			// Set the flag bit yflag to remember the current transformation, and swap the coordinates back when actually drawing the line later
-			yflag = 1;
+			if (x[i - 1] == x[i] || y[i - 1] == y[i])  // Horizontal and vertical segments are clipped as a whole
+			{
+				OLED_DrawLine(x[i - 1], y[i - 1], x[i], y[i]);
+			}
+			else  // Diagonal segments are rasterised directly, clipped only when an endpoint is outside
+			{
+				OLED_DrawLineRuns(x[i - 1], y[i - 1], x[i], y[i], (code | last_code) != 0);
+			}
 		}
-		
-		if (y1_ - y0_ > x1_ - x0_)	// If the slope of the line is greater than 1
+		last_code = code;
+	}
+}
+
+/**
+ * @brief  Plot samples as a connected trace on the OLED, one sample per column
+ * @param  x The x-coordinate of the first sample, range: [-32768,32767], screen area: [0,127]
+ * @param  y The y-coordinate of the top of the plot, range: [-32768,32767], screen area: [0,63]
+ * @param  height The height of the plot, max is drawn at the top and min at the bottom row, range: [1,64]
+ * @param  samples The samples
+ * @param  count The number of samples
+ * @param  min The sample value at the bottom of the plot, smaller samples are clamped
+ * @param  max The sample value at the top of the plot, larger samples are clamped
+ * @retval None
+ * @note   The result is the same as OLED_DrawPolyline through the scaled samples. As neighbouring samples are
+ *         one column apart, each segment is split into two vertical runs and drawn with a mask per page.
+ */
+void OLED_DrawPlot(int16_t x, int16_t y, uint8_t height, const int16_t *samples, uint8_t count, int16_t min, int16_t max)
+{
+	int32_t range = (int32_t)max - min, value;
+	int16_t row, last_row = 0, rise, half;
+	uint8_t i;
+
+	for (i = 0; i < count; i++, x++)
+	{
+		/* Scale the sample to a row of the plot */
+		value = samples[i];
+		if (value < min) {value = min;}
+		if (value > max) {value = max;}
+		row = y + height - 1;
+		if (range > 0) {row -= (value - min) * (height - 1) / range;}
+
+		rise = (row > last_row) ? row - last_row : last_row - row;
+		if (i == 0 || rise <= 1)  // The segment sets one pixel in each column
 		{
-			// Swap the x and y coordinates
-			// Swapping affects the line drawing, but the drawing direction changes from the 0~90 degrees range in the first quadrant to the 0~45 degrees range in the first quadrant
-			temp = x0_; x0_ = y0_; y0_ = temp;
-			temp = x1_; x1_ = y1_; y1_ = temp;
-			
-			// Set the flag bit xyflag to remember the current transformation, and swap the coordinates back when actually drawing the line later
-			xyflag = 1;
+			OLED_DrawPoint(x, row);
 		}
-		
-		// The following is the Bresenham's algorithm for drawing a line
-		// The algorithm requires that the drawing direction must be in the 0~45 degrees range in the first quadrant
-		dx = x1_ - x0_;
-		dy = y1_ - y0_;
-		incrE = 2 * dy;
-		incrNE = 2 * (dy - dx);
-		d = 2 * dy - dx;
-		x = x0_;
-		y = y0_;
-		
-		/* Draw the starting point and check the flag bits to swap the coordinates back */
-		if (yflag && xyflag)  {OLED_DrawPoint(y, -x);}
-		else if (yflag)		    {OLED_DrawPoint(x, -y);}
-		else if (xyflag)	    {OLED_DrawPoint(y, x);}
-		else				          {OLED_DrawPoint(x, y);}
-		
-		while (x < x1_)  // Iterate through each point on the x-axis
+		else
 		{
-			x++;
-			if (d < 0)		// The next point is to the east of the current point
+			// Like the Bresenham's algorithm, the first (rise + 1) / 2 pixels stay in the previous column
+			half = (rise + 1) / 2;
+			if (row > last_row)
 			{
-				d += incrE;
+				OLED_DrawVLine(x - 1, last_row, last_row + half - 1);
+				OLED_DrawVLine(x, last_row + half, row);
 			}
-			else  // The next point is to the northeast of the current point
+			else
 			{
-				y++;
-				d += incrNE;
+				OLED_DrawVLine(x - 1, last_row - half + 1, last_row);
+				OLED_DrawVLine(x, row, last_row - half);
 			}
-			
-			/* Draw each point and check the flag bits to swap the coordinates back */
-			if (yflag && xyflag){OLED_DrawPoint(y, -x);}
-			else if (yflag)		  {OLED_DrawPoint(x, -y);}
-			else if (xyflag)	  {OLED_DrawPoint(y, x);}
-			else				        {OLED_DrawPoint(x, y);}
-		}	
+		}
+		last_row = row;
 	}
 }
 
@@ -952,33 +3205,77 @@ void OLED_DrawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1)
  */
 void OLED_DrawRectangle(int16_t x, int16_t y, uint8_t width, uint8_t height, uint8_t is_filled)
 {
-	int16_t i, j;
-	if (!is_filled)  // If the rectangle is not filled
+	OLED_Rect_t rect = {x, y, width, height};
+
+	OLED_DrawRects(&rect, 1, is_filled);
+}
+
+/**
+ * @brief  Fill a rectangle on the drawing target
+ * @param  x0 The x-coordinate of the left edge
+ * @param  y0 The y-coordinate of the top edge
+ * @param  x1 The x-coordinate of the right edge, nothing is drawn if x1 < x0
+ * @param  y1 The y-coordinate of the bottom edge, nothing is drawn if y1 < y0
+ * @retval None
+ * @note   The rectangle is clipped once, and the mask of each page is computed once for all of its columns.
+ */
+static void OLED_FillRect(int16_t x0, int16_t y0, int16_t x1, int16_t y1)
+{
+	int16_t x, page, first_page, last_page;
+	uint8_t *p, mask;
+
+	if (x0 < 0) {x0 = 0;}
+	if (y0 < 0) {y0 = 0;}
+	if (x1 >= OLED_Target->width) {x1 = OLED_Target->width - 1;}
+	if (y1 >= OLED_Target->height) {y1 = OLED_Target->height - 1;}
+	if (x0 > x1 || y0 > y1) {return;}
+
+	first_page = y0 / 8;
+	last_page = y1 / 8;
+	for (page = first_page; page <= last_page; page++)
 	{
-		/* Iterate through the x-coordinates of the top and bottom edges, draw the top and bottom lines of the rectangle */
-		for (i = x; i < x + width; i++)
-		{
-			OLED_DrawPoint(i, y);
-			OLED_DrawPoint(i, y + height - 1);
-		}
-		/* Iterate through the y-coordinates of the left and right edges, draw the left and right lines of the rectangle */
-		for (i = y; i < y + height; i++)
+		mask = 0xFF;
+		if (page == first_page) {mask &= 0xFF << (y0 % 8);}
+		if (page == last_page) {mask &= 0xFF >> (7 - y1 % 8);}
+
+		p = OLED_Target->buf + page * OLED_Target->width;
+		for (x = x0; x <= x1; x++)
 		{
-			OLED_DrawPoint(x, i);
-			OLED_DrawPoint(x + width - 1, i);
+			p[x] |= mask;
 		}
 	}
-	else  // If the rectangle is filled
+}
+
+/**
+ * @brief  Draw a list of rectangles on the OLED
+ * @param  rects The rectangles, each the same as the parameters of OLED_DrawRectangle
+ * @param  count The number of rectangles
+ * @param  is_filled Whether the rectangles are filled, range: OLED_UNFILLED (not filled) or OLED_FILLED (filled)
+ * @retval None
+ * @note   Edges are drawn as horizontal runs and vertical page masks instead of single points.
+ *         OLED_DrawRectangle takes the same path, a list only saves the calls.
+ */
+void OLED_DrawRects(const OLED_Rect_t *rects, uint16_t count, uint8_t is_filled)
+{
+	int16_t x1, y1;
+	uint16_t i;
+
+	for (i = 0; i < count; i++)
 	{
-		/* Iterate through the x-coordinates */
-		for (i = x; i < x + width; i++)
+		x1 = rects[i].x + rects[i].width - 1;
+		y1 = rects[i].y + rects[i].height - 1;
+
+		if (is_filled)
 		{
-			/* Iterate through the y-coordinates */
-			for (j = y; j < y + height; j++)
-			{
-				// Draw points in the specified area to fill the rectangle
-				OLED_DrawPoint(i, j);
-			}
+			OLED_FillRect(rects[i].x, rects[i].y, x1, y1);
+		}
+		else
+		{
+			/* Top and bottom edges, then left and right edges */
+			OLED_DrawHLine(rects[i].x, x1, rects[i].y);
+			OLED_DrawHLine(rects[i].x, x1, y1);
+			OLED_DrawVLine(rects[i].x, rects[i].y, y1);
+			OLED_DrawVLine(x1, rects[i].y, y1);
 		}
 	}
 }
@@ -1299,3 +3596,314 @@ void OLED_DrawArc(int16_t center_x, int16_t center_y, uint8_t radius, int16_t st
 		}
 	}
 }
+
+/**
+ * @brief  Choose the number of steps of a Bezier curve from the length of its control polygon
+ * @param  x The x-coordinates of the control points
+ * @param  y The y-coordinates of the control points
+ * @param  count The number of control points
+ * @retval The base 2 logarithm of the number of steps, range: [0,7]
+ * @note   The control polygon is never shorter than the curve, so every step covers at most about 4 pixels.
+ *         A power of 2 lets the forward differences be scaled back with a shift instead of a division.
+ */
+static uint8_t OLED_BezierSteps(const int16_t *x, const int16_t *y, uint8_t count)
+{
+	int32_t length = 0, dx, dy;
+	uint8_t i, shift = 0;
+
+	for (i = 1; i < count; i++)
+	{
+		dx = x[i] - x[i - 1];
+		dy = y[i] - y[i - 1];
+		if (dx < 0) {dx = -dx;}
+		if (dy < 0) {dy = -dy;}
+		length += (dx > dy) ? dx : dy;
+	}
+
+	while (shift < 7 && (length >> shift) > 4)
+	{
+		shift++;
+	}
+	return shift;
+}
+
+/**
+ * @brief  Check whether a Bezier curve is a straight line
+ * @param  x The x-coordinates of the control points
+ * @param  y The y-coordinates of the control points
+ * @param  count The number of control points
+ * @retval 1: the control points lie on the line between the end points, the curve traces exactly that line, 0: otherwise
+ * @note   The curve stays within the convex hull of its control points, which is then the line itself.
+ */
+static uint8_t OLED_BezierStraight(const int16_t *x, const int16_t *y, uint8_t count)
+{
+	int32_t dx = x[count - 1] - x[0], dy = y[count - 1] - y[0];
+	uint8_t i;
+
+	for (i = 1; i < count - 1; i++)
+	{
+		if ((int64_t)(x[i] - x[0]) * dy != (int64_t)(y[i] - y[0]) * dx) {return 0;}  // Not on the line
+		if ((int64_t)(x[i] - x[0]) * (x[i] - x[count - 1]) > 0 || (int64_t)(y[i] - y[0]) * (y[i] - y[count - 1]) > 0 ||
+		    (dx == 0 && dy == 0 && (x[i] != x[0] || y[i] != y[0])))
+		{
+			return 0;  // Beyond an end point
+		}
+	}
+	return 1;
+}
+
+/**
+ * @brief  Draw the segments of a Bezier curve whose points are generated by forward differencing
+ * @param  x The scaled x-coordinate and its forward differences, x[0] is the start point
+ * @param  y The scaled y-coordinate and its forward differences, y[0] is the start point
+ * @param  order The number of forward differences, 2: quadratic, 3: cubic
+ * @param  shift The base 2 logarithm of the number of steps
+ * @retval None
+ * @note   The coordinates are scaled by 2^(order * shift), so the integer differences are exact
+ *         and the curve ends exactly on its last control point.
+ */
+static void OLED_DrawBezierSegments(int64_t *x, int64_t *y, uint8_t order, uint8_t shift)
+{
+	uint8_t scale = order * shift, last_code, code, j;
+	int64_t half = (scale > 0) ? (int64_t)1 << (scale - 1) : 0;
+	int16_t last_x, last_y, next_x, next_y;
+	uint16_t i;
+
+	last_x = (int16_t)((x[0] + half) >> scale);
+	last_y = (int16_t)((y[0] + half) >> scale);
+	last_code = OLED_OutCode(last_x, last_y);
+
+	for (i = 0; i < (1U << shift); i++)
+	{
+		/* Advance the point and the differences */
+		for (j = 0; j < order; j++)
+		{
+			x[j] += x[j + 1];
+			y[j] += y[j + 1];
+		}
+
+		next_x = (int16_t)((x[0] + half) >> scale);
+		next_y = (int16_t)((y[0] + half) >> scale);
+		code = OLED_OutCode(next_x, next_y);
+
+		if ((code & last_code) == 0 && (next_x != last_x || next_y != last_y || i == 0))
+		{
+			OLED_DrawLine(last_x, last_y, next_x, next_y);
+		}
+		last_x = next_x;
+		last_y = next_y;
+		last_code = code;
+	}
+}
+
+/**
+ * @brief  Draw a quadratic Bezier curve on the OLED
+ * @param  x0 The x-coordinate of the start point, range: [-32768,32767], screen area: [0,127]
+ * @param  y0 The y-coordinate of the start point, range: [-32768,32767], screen area: [0,63]
+ * @param  x1 The x-coordinate of the control point, range: [-32768,32767], screen area: [0,127]
+ * @param  y1 The y-coordinate of the control point, range: [-32768,32767], screen area: [0,63]
+ * @param  x2 The x-coordinate of the end point, range: [-32768,32767], screen area: [0,127]
+ * @param  y2 The y-coordinate of the end point, range: [-32768,32767], screen area: [0,63]
+ * @retval None
+ * @note   The curve is approximated by line segments, their number grows with the length of the curve, at most 128.
+ *         The points are computed with integer forward differences, no floating point is used.
+ *         The curve always ends on both end points. A straight control polygon is drawn as OLED_DrawLine.
+ */
+void OLED_DrawQuadBezier(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2)
+{
+	int16_t px[3] = {x0, x1, x2}, py[3] = {y0, y1, y2};
+	uint8_t shift = OLED_BezierSteps(px, py, 3);
+	int64_t n = (int64_t)1 << shift, x[3], y[3];
+
+	if (OLED_BezierStraight(px, py, 3))
+	{
+		OLED_DrawLine(x0, y0, x2, y2);
+		return;
+	}
+
+	/* P(t) = a * t^2 + b * t + c, with the step 1 / n and everything scaled by n^2 */
+	int32_t ax = x0 - 2 * x1 + x2, bx = 2 * (x1 - x0);
+	int32_t ay = y0 - 2 * y1 + y2, by = 2 * (y1 - y0);
+
+	x[0] = x0 * n * n;
+	x[1] = ax + bx * n;
+	x[2] = 2 * ax;
+	y[0] = y0 * n * n;
+	y[1] = ay + by * n;
+	y[2] = 2 * ay;
+
+	OLED_DrawBezierSegments(x, y, 2, shift);
+}
+
+/**
+ * @brief  Draw a cubic Bezier curve on the OLED
+ * @param  x0 The x-coordinate of the start point, range: [-32768,32767], screen area: [0,127]
+ * @param  y0 The y-coordinate of the start point, range: [-32768,32767], screen area: [0,63]
+ * @param  x1 The x-coordinate of the first control point, range: [-32768,32767], screen area: [0,127]
+ * @param  y1 The y-coordinate of the first control point, range: [-32768,32767], screen area: [0,63]
+ * @param  x2 The x-coordinate of the second control point, range: [-32768,32767], screen area: [0,127]
+ * @param  y2 The y-coordinate of the second control point, range: [-32768,32767], screen area: [0,63]
+ * @param  x3 The x-coordinate of the end point, range: [-32768,32767], screen area: [0,127]
+ * @param  y3 The y-coordinate of the end point, range: [-32768,32767], screen area: [0,63]
+ * @retval None
+ * @note   The curve is approximated by line segments, their number grows with the length of the curve, at most 128.
+ *         The points are computed with integer forward differences, no floating point is used.
+ *         The curve always ends on both end points. A straight control polygon is drawn as OLED_DrawLine.
+ */
+void OLED_DrawCubicBezier(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t x3, int16_t y3)
+{
+	int16_t px[4] = {x0, x1, x2, x3}, py[4] = {y0, y1, y2, y3};
+	uint8_t shift = OLED_BezierSteps(px, py, 4);
+	int64_t n = (int64_t)1 << shift, x[4], y[4];
+
+	if (OLED_BezierStraight(px, py, 4))
+	{
+		OLED_DrawLine(x0, y0, x3, y3);
+		return;
+	}
+
+	/* P(t) = a * t^3 + b * t^2 + c * t + d, with the step 1 / n and everything scaled by n^3 */
+	int32_t ax = -x0 + 3 * x1 - 3 * x2 + x3, bx = 3 * x0 - 6 * x1 + 3 * x2, cx = 3 * (x1 - x0);
+	int32_t ay = -y0 + 3 * y1 - 3 * y2 + y3, by = 3 * y0 - 6 * y1 + 3 * y2, cy = 3 * (y1 - y0);
+
+	x[0] = x0 * n * n * n;
+	x[1] = ax + bx * n + cx * n * n;
+	x[2] = 6 * ax + 2 * bx * n;
+	x[3] = 6 * ax;
+	y[0] = y0 * n * n * n;
+	y[1] = ay + by * n + cy * n * n;
+	y[2] = 6 * ay + 2 * by * n;
+	y[3] = 6 * ay;
+
+	OLED_DrawBezierSegments(x, y, 3, shift);
+}
+
+/**
+ * @brief  Push a seed for every run of unlit pixels within a range of a column
+ * @param  x The x-coordinate of the column
+ * @param  y0 The y-coordinate of the top of the range
+ * @param  y1 The y-coordinate of the bottom of the range
+ * @param  stack The seed stack
+ * @param  size The capacity of the seed stack
+ * @param  count The number of seeds on the stack
+ * @retval The number of seeds that did not fit on the stack
+ * @note   The runs are found a page byte at a time: a run starts at an unlit bit whose upper neighbour is lit.
+ */
+static uint16_t OLED_FloodFillScan(int16_t x, int16_t y0, int16_t y1, OLED_FillSeed_t *stack, uint16_t size, uint16_t *count)
+{
+	int16_t page, last_page = y1 / 8, bit;
+	uint8_t unlit, starts, above = 0, mask;
+	uint16_t dropped = 0;
+	const uint8_t *p;
+
+	if (x < 0 || x >= OLED_Target->width) {return 0;}
+
+	p = OLED_Target->buf + y0 / 8 * OLED_Target->width + x;
+	for (page = y0 / 8; page <= last_page; page++, p += OLED_Target->width)
+	{
+		mask = 0xFF;
+		if (page == y0 / 8) {mask &= 0xFF << (y0 % 8);}
+		if (page == last_page) {mask &= 0xFF >> (7 - y1 % 8);}
+
+		unlit = ~*p & mask;
+		starts = unlit & ~((unlit << 1) | above);
+		above = unlit >> 7;  // Whether the run continues into the next page
+
+		for (bit = 0; starts != 0; bit++, starts >>= 1)
+		{
+			if (starts & 0x01)
+			{
+				if (*count < size)
+				{
+					stack[*count].x = x;
+					stack[*count].y = page * 8 + bit;
+					(*count)++;
+				}
+				else
+				{
+					dropped++;
+				}
+			}
+		}
+	}
+	return dropped;
+}
+
+/**
+ * @brief  Fill the closed area of unlit pixels around a point on the OLED
+ * @param  x The x-coordinate of a point inside the area, range: [-32768,32767], screen area: [0,127]
+ * @param  y The y-coordinate of a point inside the area, range: [-32768,32767], screen area: [0,63]
+ * @param  stack The seed stack provided by the caller
+ * @param  size The capacity of the seed stack, 32 is enough for most outlines
+ * @retval The number of seeds dropped because the stack was full, 0: the area is completely filled
+ * @note   The area consists of the unlit pixels connected to the point horizontally and vertically,
+ *         it is bounded by lit pixels and the edges of the drawing target.
+ *         The fill works on vertical spans, because a page byte holds 8 vertical pixels:
+ *         the ends of a span and the runs in the neighbouring columns are found a byte at a time,
+ *         and each span is set with one mask per page.
+ *         When the stack overflows, the remaining seeds are dropped instead of overrunning memory.
+ *         The filled part is then still correct but some branches of the area stay unfilled,
+ *         calling OLED_FloodFill again inside them with the same stack completes the fill.
+ */
+uint16_t OLED_FloodFill(int16_t x, int16_t y, OLED_FillSeed_t *stack, uint16_t size)
+{
+	int16_t width = OLED_Target->width, height = OLED_Target->height;
+	int16_t page, pages = (height + 7) / 8, top, bottom, bit;
+	uint16_t count = 0, dropped = 0;
+	const uint8_t *column;
+	uint8_t lit;
+
+	if (x < 0 || x >= width || y < 0 || y >= height || size == 0) {return 0;}
+
+	stack[count].x = x;
+	stack[count].y = y;
+	count++;
+
+	while (count > 0)
+	{
+		count--;
+		x = stack[count].x;
+		y = stack[count].y;
+		column = OLED_Target->buf + x;
+
+		page = y / 8;
+		bit = y % 8;
+		if (column[page * width] & (0x01 << bit)) {continue;}  // Already filled by another span
+
+		/* Find the top of the span: the lowest lit bit above the seed, skipping unlit page bytes as a whole */
+		lit = column[page * width] & (0xFF >> (8 - bit));
+		while (lit == 0 && page > 0)
+		{
+			page--;
+			lit = column[page * width];
+		}
+		top = page * 8;
+		if (lit != 0)
+		{
+			for (bit = 7; !(lit & (0x01 << bit)); bit--) {}
+			top += bit + 1;
+		}
+
+		/* Find the bottom of the span the same way below the seed */
+		page = y / 8;
+		lit = column[page * width] & (0xFE << (y % 8));
+		while (lit == 0 && page < pages - 1)
+		{
+			page++;
+			lit = column[page * width];
+		}
+		bottom = page * 8 + 7;
+		if (lit != 0)
+		{
+			for (bit = 0; !(lit & (0x01 << bit)); bit++) {}
+			bottom = page * 8 + bit - 1;
+		}
+		if (bottom >= height) {bottom = height - 1;}
+
+		/* Fill the span and look for unfilled runs beside it */
+		OLED_DrawVLine(x, top, bottom);
+		dropped += OLED_FloodFillScan(x - 1, top, bottom, stack, size, &count);
+		dropped += OLED_FloodFillScan(x + 1, top, bottom, stack, size, &count);
+	}
+	return dropped;
+}
@@ -0,0 +1,207 @@
+/* Includes ------------------------------------------------------------------*/
+
+#include "oled_anim.h"
+
+/* Notes ---------------------------------------------------------------------*/
+
+/**
+ * @brief  XOR-delta animation format
+ *
+ * @note   An animation stores its first frame as a keyframe in page format, followed by one delta record per frame.
+ *         Delta record n turns frame n into frame n + 1, the last one turns the last frame back into the keyframe.
+ *         Each record is the bounding box of the changed page bytes relative to the animation:
+ *
+ *           x, page, width, pages  (4 bytes, width = 0 means that nothing changes)
+ *           PackBits runs of the width * pages XOR bytes, page by page, like OLED_ShowImageRLE
+ *
+ *         Flash use and the bytes sent per frame therefore scale with the area that actually moves.
+ */
+
+/* OLED Animation Private Functions ------------------------------------------*/
+
+/**
+ * @brief  XOR a byte of a delta into the OLED display memory array
+ * @param  x The x-coordinate of the column of the byte
+ * @param  page The page the top of the byte falls into, may be negative
+ * @param  shift The y-offset of the top of the byte within that page, range: [0,8]
+ * @param  data The XOR byte
+ * @retval None
+ */
+static inline void OLED_AnimXorByte(int16_t x, int16_t page, int16_t shift, uint8_t data)
+{
+	int16_t pages = (OLED_Screen.height + 7) / 8;
+
+	if (x >= 0 && x < OLED_Screen.width)  // Content outside the screen will not be displayed
+	{
+		if (page >= 0 && page < pages)
+		{
+			OLED_Screen.buf[page * OLED_Screen.width + x] ^= data << shift;
+		}
+		if (page + 1 >= 0 && page + 1 < pages)
+		{
+			OLED_Screen.buf[(page + 1) * OLED_Screen.width + x] ^= data >> (8 - shift);
+		}
+	}
+}
+
+/**
+ * @brief  Apply a delta record to the OLED display memory array
+ * @param  player The player
+ * @param  record The delta record
+ * @param  box The changed area on the screen as x0, y0, x1, y1, it is extended by the area of this record
+ * @retval The next delta record
+ */
+static const uint8_t *OLED_AnimApply(const OLED_AnimPlayer_t *player, const uint8_t *record, int16_t *box)
+{
+	int16_t x, y, page, shift, i = 0, width, pages;
+	uint16_t size, count;
+	uint8_t header, value, literal;
+
+	/* Bounding box of the record relative to the animation */
+	x = player->x + record[0];
+	y = player->y + record[1] * 8;
+	width = record[2];
+	pages = record[3];
+	size = width * pages;
+	record += 4;
+	if (size == 0) {return record;}
+
+	/* Extend the changed area */
+	if (x < box[0]) {box[0] = x;}
+	if (y < box[1]) {box[1] = y;}
+	if (x + width > box[2]) {box[2] = x + width;}
+	if (y + pages * 8 > box[3]) {box[3] = y + pages * 8;}
+
+	/* A negative coordinate needs an offset when calculating the page address and shift */
+	page = y / 8;
+	shift = y % 8;
+	if (y < 0)
+	{
+		page -= 1;
+		shift += 8;
+	}
+
+	/* Decode the PackBits runs and XOR them into the box */
+	while (size > 0)
+	{
+		header = *record++;
+		if (header == 128) {continue;}  // No operation
+
+		literal = (header < 128);
+		count = literal ? header + 1 : 257 - header;
+		if (count > size) {count = size;}
+		size -= count;
+
+		value = *record;
+		while (count--)
+		{
+			if (literal) {value = *record++;}
+
+			if (value != 0x00)
+			{
+				OLED_AnimXorByte(x + i, page, shift, value);
+			}
+
+			/* Move to the next column, wrapping to the next page of the box */
+			if (++i == width)
+			{
+				i = 0;
+				page++;
+			}
+		}
+		if (!literal) {record++;}
+	}
+	return record;
+}
+
+/**
+ * @brief  Send the part of an area that is inside the screen to the OLED hardware
+ * @param  x0 The x-coordinate of the left edge of the area
+ * @param  y0 The y-coordinate of the top edge of the area
+ * @param  x1 The x-coordinate after the right edge of the area
+ * @param  y1 The y-coordinate after the bottom edge of the area
+ * @retval None
+ * @note   OLED_UpdateArea does not clip areas that start outside the screen, so this is done here.
+ */
+static void OLED_AnimFlush(int16_t x0, int16_t y0, int16_t x1, int16_t y1)
+{
+	if (x0 < 0) {x0 = 0;}
+	if (y0 < 0) {y0 = 0;}
+	if (x1 > OLED_Screen.width) {x1 = OLED_Screen.width;}
+	if (y1 > OLED_Screen.height) {y1 = OLED_Screen.height;}
+	if (x0 < x1 && y0 < y1)
+	{
+		OLED_UpdateArea(x0, y0, x1 - x0, y1 - y0);
+	}
+}
+
+/* OLED Animation Functions --------------------------------------------------*/
+
+/**
+ * @brief  Start playing an animation, the keyframe is displayed and sent to the OLED hardware
+ * @param  player The playback state
+ * @param  anim The animation
+ * @param  x The x-coordinate of the top-left corner of the animation, range: [-32768,32767], screen area: [0,127]
+ * @param  y The y-coordinate of the top-left corner of the animation, range: [-32768,32767], screen area: [0,63]
+ * @retval None
+ */
+void OLED_AnimStart(OLED_AnimPlayer_t *player, const OLED_Animation_t *anim, int16_t x, int16_t y)
+{
+	OLED_Surface_t *target = OLED_GetTarget();
+
+	player->anim = anim;
+	player->x = x;
+	player->y = y;
+	player->frame = 0;
+	player->next = anim->deltas;
+	player->tick = HAL_GetTick();
+
+	OLED_SetTarget(NULL);
+	OLED_ShowImage(x, y, anim->width, anim->height, anim->keyframe);
+	OLED_SetTarget(target);
+
+	// Whole pages of the keyframe, OLED_ShowImage also draws the padding bits of the last page like the deltas
+	OLED_AnimFlush(x, y, x + anim->width, y + (anim->height + 7) / 8 * 8);
+}
+
+/**
+ * @brief  Advance an animation according to the HAL tick
+ * @param  player The playback state
+ * @retval Whether the frame changed, 1: changed, 0: not yet
+ * @note   Call it regularly from the main loop. All frames that are due are applied,
+ *         and only the union of their changed areas is sent to the OLED hardware.
+ *         The animation loops, the content below it must not be changed while it plays.
+ */
+uint8_t OLED_AnimTick(OLED_AnimPlayer_t *player)
+{
+	const OLED_Animation_t *anim = player->anim;
+	uint32_t now = HAL_GetTick();
+	int16_t box[4] = {32767, 32767, -32768, -32768};
+
+	if (anim->frame_count < 2 || anim->frame_time == 0 || now - player->tick < anim->frame_time)
+	{
+		return 0;
+	}
+
+	// After a long stall, only advance by one frame instead of catching up
+	if (now - player->tick > (uint32_t)anim->frame_time * anim->frame_count)
+	{
+		player->tick = now - anim->frame_time;
+	}
+
+	/* Apply every frame that is due */
+	while (now - player->tick >= anim->frame_time)
+	{
+		player->next = OLED_AnimApply(player, player->next, box);
+		player->tick += anim->frame_time;
+
+		if (++player->frame == anim->frame_count)  // Back at the keyframe
+		{
+			player->frame = 0;
+			player->next = anim->deltas;
+		}
+	}
+
+	OLED_AnimFlush(box[0], box[1], box[2], box[3]);
+	return 1;
+}
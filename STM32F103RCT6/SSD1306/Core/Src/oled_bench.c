@@ -0,0 +1,88 @@
+/* Includes ------------------------------------------------------------------*/
+
+#include <string.h>
+#include "oled_bench.h"
+
+/* Notes ---------------------------------------------------------------------*/
+
+/**
+ * @brief  On-target benchmarks
+ *
+ * @note   The cycles are counted with the DWT cycle counter of the Cortex-M3 core, on host builds they read 0.
+ *         Each function is called with the same sample values and lengths and draws on a scratch surface,
+ *         so the display memory array is not changed and the drawing cost is the same for all of them;
+ *         the differences come from the number conversion.
+ */
+
+/* Data ----------------------------------------------------------------------*/
+
+/* Sample values of OLED_BenchNumbers, as the number, a fixed-point number with 3 decimals and a float */
+static const double OLED_BenchValues[] = {0.0, 3.14159, -0.996, 123.45, -99.5, 640.15, 65535.5, -1234567.891};
+
+/* OLED Benchmark Functions ---------------------------------------------------*/
+
+/**
+ * @brief  Measure the number display functions
+ * @param  bench Receives the cycles of one call of each function
+ * @retval None
+ * @note   OLED_ShowFloatNum, OLED_ShowFixed and OLED_ShowFloat show the sample values with 7 integer
+ *         and 3 fractional digits in the 6x8 font. The fixed-point and float arguments are converted before
+ *         the counter is read, as an application would keep its values in that form.
+ */
+void OLED_BenchNumbers(OLED_NumberBench_t *bench)
+{
+	static uint8_t scratch[OLED_SURFACE_SIZE(128, 8)];
+	OLED_Surface_t surface, *target = OLED_GetTarget();
+	int32_t fixed;
+	float single;
+	uint32_t cycles;
+	uint16_t i;
+
+#if OLED_BENCH_USE_DWT
+	/* Enable the cycle counter */
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+
+	memset(bench, 0x00, sizeof(*bench));
+	OLED_SurfaceInit(&surface, scratch, 128, 8);
+	OLED_SetTarget(&surface);
+
+	for (i = 0; i < sizeof(OLED_BenchValues) / sizeof(OLED_BenchValues[0]); i++)
+	{
+		fixed = (int32_t)(OLED_BenchValues[i] * 1000 + (OLED_BenchValues[i] < 0 ? -0.5 : 0.5));
+		single = (float)OLED_BenchValues[i];
+
+		cycles = OLED_BENCH_CYCLES();
+		OLED_ShowFloatNum(0, 0, OLED_BenchValues[i], 7, 3, OLED_6X8);
+		bench->float_num += OLED_BENCH_CYCLES() - cycles;
+
+		cycles = OLED_BENCH_CYCLES();
+		OLED_ShowFixed(0, 0, fixed, OLED_FIXED_DEC(3), 7, 3, OLED_6X8);
+		bench->fixed += OLED_BENCH_CYCLES() - cycles;
+
+		cycles = OLED_BENCH_CYCLES();
+		OLED_ShowFloat(0, 0, single, 7, 3, OLED_6X8);
+		bench->single += OLED_BENCH_CYCLES() - cycles;
+
+		bench->count++;
+	}
+
+	bench->float_num /= bench->count;
+	bench->fixed /= bench->count;
+	bench->single /= bench->count;
+	OLED_SetTarget(target);
+}
+
+/**
+ * @brief  Display the result of OLED_BenchNumbers
+ * @param  bench The result
+ * @retval None
+ * @note   Three lines in the 6x8 font at the top-left corner of the drawing target, call OLED_Update to see them.
+ */
+void OLED_BenchShowNumbers(const OLED_NumberBench_t *bench)
+{
+	OLED_Printf(0, 0, OLED_6X8, "FloatNum %7lu cyc", (unsigned long)bench->float_num);
+	OLED_Printf(0, 8, OLED_6X8, "Fixed    %7lu cyc", (unsigned long)bench->fixed);
+	OLED_Printf(0, 16, OLED_6X8, "Float    %7lu cyc", (unsigned long)bench->single);
+}
@@ -359,6 +359,7 @@ const uint8_t OLED_F6x8[][6] =
  *        The order of Chinese characters does not matter.
  *        All characters must be Chinese characters or full-width characters.
  *        Do not include any half-width characters.
+ *        The array and its index can also be generated from a BDF or PCF font with Tools/oled_compile.c (-m cells).
  */
 
 /* OLED font library, 16 pixels wide, 16 pixels high */
@@ -399,6 +400,350 @@ const ChineseCell_t OLED_CF16x16[] = {
 	0xFF,0x80,0x80,0x80,0x80,0x80,0x80,0x96,0x81,0x80,0x80,0x80,0x80,0x80,0x80,0xFF,
 };
 
+/**
+ * @note  After changing the Chinese font library, regenerate this index with Tools/oled_cjk_index.c
+ *        (with -g for a GB2312 source file). Adding or removing characters without it fails to compile.
+ */
+
+/* Index of OLED_CF16x16 sorted by codepoint, generated by Tools/oled_cjk_index.c */
+const ChineseIndex_t OLED_CF16x16_Index[] = {
+	{0x3002, 1},  // 。
+	{0x4E16, 4},  // 世
+	{0x4F60, 2},  // 你
+	{0x597D, 3},  // 好
+	{0x754C, 5},  // 界
+	{0xFF0C, 0},  // ，
+};
+
+_Static_assert(sizeof(OLED_CF16x16_Index) / sizeof(OLED_CF16x16_Index[0]) + 1 == sizeof(OLED_CF16x16) / sizeof(OLED_CF16x16[0]),
+               "OLED_CF16x16_Index does not match OLED_CF16x16, regenerate it with Tools/oled_cjk_index.c");
+
+/* Font Descriptor Definitions -----------------------------------------------*/
+
+/* ASCII, then every other codepoint through the index of the Chinese font library */
+static const OLED_FontRange_t OLED_Font8x16_Ranges[] = {
+	{0x20, 0x7E, 8, 16, OLED_F8x16[0], sizeof(OLED_F8x16[0]), NULL, 0},
+	{0x80, 0x10FFFF, 16, 16, OLED_CF16x16[0].data, sizeof(OLED_CF16x16[0]),
+	 OLED_CF16x16_Index, sizeof(OLED_CF16x16_Index) / sizeof(OLED_CF16x16_Index[0])},
+};
+
+/* Missing characters are shown as the default figure at the end of the Chinese font library */
+const OLED_Font_t OLED_Font8x16 = {
+	OLED_Font8x16_Ranges, sizeof(OLED_Font8x16_Ranges) / sizeof(OLED_Font8x16_Ranges[0]),
+	16, 16, OLED_CF16x16[sizeof(OLED_CF16x16) / sizeof(OLED_CF16x16[0]) - 1].data,
+};
+
+static const OLED_FontRange_t OLED_Font6x8_Ranges[] = {
+	{0x20, 0x7E, 6, 8, OLED_F6x8[0], sizeof(OLED_F6x8[0]), NULL, 0},
+};
+
+/* There is no space for Chinese characters, missing characters are shown as '?' */
+const OLED_Font_t OLED_Font6x8 = {
+	OLED_Font6x8_Ranges, sizeof(OLED_Font6x8_Ranges) / sizeof(OLED_Font6x8_Ranges[0]),
+	6, 8, OLED_F6x8['?' - ' '],
+};
+
+/* Packed Font Library Definitions ------------------------------------------*/
+
+/**
+ * @note  Generated from OLED_F8x16 and OLED_F6x8 by Tools/oled_pack_font.c, the glyphs keep their position
+ *        in the cell and render exactly like the fixed-width font libraries.
+ *        Generate proportional fonts with its -p option.
+ */
+
+/* OLED_PackedFont8x16, 95 characters from ' ', packed from OLED_F8x16 */
+static const OLED_PackedGlyph_t OLED_PackedFont8x16_Glyphs[] = {
+	/* width, height, x_offset, y_offset, advance */
+	{ 0,  0,  0,  0,  8},  // ' '
+	{ 2, 11,  3,  3,  8},  // '!'
+	{ 5,  4,  1,  1,  8},  // '"'
+	{ 7, 11,  0,  3,  8},  // '#'
+	{ 5, 14,  1,  2,  8},  // '$'
+	{ 7, 11,  0,  3,  8},  // '%'
+	{ 8, 11,  0,  3,  8},  // '&'
+	{ 2,  4,  3,  1,  8},  // '''
+	{ 4, 14,  3,  1,  8},  // '('
+	{ 4, 14,  1,  1,  8},  // ')'
+	{ 7,  8,  0,  4,  8},  // '*'
+	{ 7,  9,  0,  4,  8},  // '+'
+	{ 2,  4,  1, 12,  8},  // ','
+	{ 7,  1,  1,  8,  8},  // '-'
+	{ 2,  2,  1, 12,  8},  // '.'
+	{ 7, 13,  1,  2,  8},  // '/'
+	{ 6, 11,  1,  3,  8},  // '0'
+	{ 5, 11,  1,  3,  8},  // '1'
+	{ 6, 11,  1,  3,  8},  // '2'
+	{ 6, 11,  1,  3,  8},  // '3'
+	{ 6, 11,  1,  3,  8},  // '4'
+	{ 6, 11,  1,  3,  8},  // '5'
+	{ 6, 11,  1,  3,  8},  // '6'
+	{ 6, 11,  1,  3,  8},  // '7'
+	{ 6, 11,  1,  3,  8},  // '8'
+	{ 6, 11,  1,  3,  8},  // '9'
+	{ 2,  8,  3,  6,  8},  // ':'
+	{ 3, 10,  2,  6,  8},  // ';'
+	{ 6, 11,  1,  3,  8},  // '<'
+	{ 7,  5,  0,  6,  8},  // '='
+	{ 6, 11,  1,  3,  8},  // '>'
+	{ 6, 11,  1,  3,  8},  // '?'
+	{ 7, 11,  0,  3,  8},  // '@'
+	{ 8, 11,  0,  3,  8},  // 'A'
+	{ 7, 11,  0,  3,  8},  // 'B'
+	{ 7, 11,  0,  3,  8},  // 'C'
+	{ 7, 11,  0,  3,  8},  // 'D'
+	{ 7, 11,  0,  3,  8},  // 'E'
+	{ 7, 11,  0,  3,  8},  // 'F'
+	{ 7, 11,  0,  3,  8},  // 'G'
+	{ 8, 11,  0,  3,  8},  // 'H'
+	{ 5, 11,  1,  3,  8},  // 'I'
+	{ 7, 13,  0,  3,  8},  // 'J'
+	{ 7, 11,  0,  3,  8},  // 'K'
+	{ 7, 11,  0,  3,  8},  // 'L'
+	{ 7, 11,  0,  3,  8},  // 'M'
+	{ 8, 11,  0,  3,  8},  // 'N'
+	{ 7, 11,  0,  3,  8},  // 'O'
+	{ 7, 11,  0,  3,  8},  // 'P'
+	{ 7, 12,  0,  3,  8},  // 'Q'
+	{ 8, 11,  0,  3,  8},  // 'R'
+	{ 6, 11,  1,  3,  8},  // 'S'
+	{ 7, 11,  0,  3,  8},  // 'T'
+	{ 8, 11,  0,  3,  8},  // 'U'
+	{ 8, 11,  0,  3,  8},  // 'V'
+	{ 7, 11,  0,  3,  8},  // 'W'
+	{ 8, 11,  0,  3,  8},  // 'X'
+	{ 7, 11,  0,  3,  8},  // 'Y'
+	{ 7, 11,  0,  3,  8},  // 'Z'
+	{ 4, 14,  3,  1,  8},  // '['
+	{ 6, 14,  1,  2,  8},  // '\'
+	{ 4, 14,  1,  1,  8},  // ']'
+	{ 7,  4,  1,  2,  8},  // '^'
+	{ 8,  1,  0, 15,  8},  // '_'
+	{ 3,  3,  1,  1,  8},  // '`'
+	{ 7,  7,  1,  7,  8},  // 'a'
+	{ 7, 11,  0,  3,  8},  // 'b'
+	{ 6,  7,  1,  7,  8},  // 'c'
+	{ 7, 11,  1,  3,  8},  // 'd'
+	{ 6,  7,  1,  7,  8},  // 'e'
+	{ 7, 11,  1,  3,  8},  // 'f'
+	{ 6,  9,  1,  7,  8},  // 'g'
+	{ 8, 11,  0,  3,  8},  // 'h'
+	{ 5, 11,  1,  3,  8},  // 'i'
+	{ 5, 13,  1,  3,  8},  // 'j'
+	{ 7, 11,  0,  3,  8},  // 'k'
+	{ 5, 11,  1,  3,  8},  // 'l'
+	{ 8,  7,  0,  7,  8},  // 'm'
+	{ 7,  7,  1,  7,  8},  // 'n'
+	{ 6,  7,  1,  7,  8},  // 'o'
+	{ 7,  9,  0,  7,  8},  // 'p'
+	{ 7,  9,  1,  7,  8},  // 'q'
+	{ 7,  7,  0,  7,  8},  // 'r'
+	{ 6,  7,  1,  7,  8},  // 's'
+	{ 5,  9,  1,  5,  8},  // 't'
+	{ 8,  7,  0,  7,  8},  // 'u'
+	{ 8,  7,  0,  7,  8},  // 'v'
+	{ 8,  7,  0,  7,  8},  // 'w'
+	{ 6,  7,  1,  7,  8},  // 'x'
+	{ 8,  9,  0,  7,  8},  // 'y'
+	{ 6,  7,  1,  7,  8},  // 'z'
+	{ 4, 14,  4,  1,  8},  // '{'
+	{ 1, 16,  4,  0,  8},  // '|'
+	{ 4, 14,  1,  1,  8},  // '}'
+	{ 7,  3,  1,  6,  8},  // '~'
+};
+
+static const uint8_t OLED_PackedFont8x16_Bitmap[] = {
+	0x7F,0x06,0x30,0x7B,0xB0,0x07,0x88,0xC0,0xFF,0x23,0x10,0x81,0xFF,0x47,0x20,0x02,
+	0x1C,0x86,0x08,0xF2,0xFF,0x0B,0x21,0x8C,0x07,0x1E,0x08,0xA1,0xE7,0xC0,0xC0,0xBD,
+	0x11,0x02,0x0F,0xC0,0xF3,0x61,0x18,0x23,0xE9,0x32,0x70,0x82,0x10,0x40,0x7B,0xF0,
+	0x03,0x03,0x23,0x00,0x05,0x80,0x01,0xA0,0x00,0xC4,0xC0,0xC0,0x0F,0x24,0x24,0x18,
+	0xFF,0x18,0x24,0x24,0x10,0x20,0x40,0xF8,0x0F,0x01,0x02,0x04,0x7B,0x7F,0x0F,0x00,
+	0x18,0xC0,0x00,0x06,0x30,0x80,0x01,0x0C,0x40,0x00,0x00,0xFC,0x11,0x50,0x00,0x03,
+	0x28,0x20,0xFE,0x00,0x02,0x14,0xE0,0xFF,0x01,0x08,0x40,0x0E,0x0E,0x68,0x20,0x83,
+	0x18,0x43,0x07,0x03,0x06,0x0B,0x60,0x04,0x23,0x98,0x22,0xE3,0x00,0xE0,0xC0,0x04,
+	0x21,0x05,0xF9,0x7F,0x40,0x02,0x3F,0x0B,0x61,0x04,0x23,0x18,0xA2,0xE0,0x00,0xFC,
+	0x11,0x51,0x04,0x23,0x38,0x22,0xE0,0x00,0x07,0x08,0x40,0xF8,0x33,0x70,0x80,0x00,
+	0x00,0x8E,0x8B,0x62,0x08,0x43,0x18,0x45,0xC7,0x01,0x1C,0x10,0x71,0x10,0x83,0x28,
+	0x22,0xFE,0x00,0xC3,0xC3,0x00,0x0E,0x3B,0x1C,0x20,0x80,0x02,0x22,0x08,0x22,0xA0,
+	0x00,0x02,0x31,0xC6,0x18,0x63,0x04,0x01,0x14,0x10,0x41,0x10,0x01,0x05,0x10,0x00,
+	0x0E,0x48,0x40,0x80,0x83,0x1D,0x02,0x0F,0x00,0xF8,0x30,0x58,0x3E,0x0B,0xD9,0x47,
+	0x41,0xF1,0x05,0x00,0x04,0x3C,0x1E,0x8F,0xC0,0x05,0x70,0x02,0x1C,0x80,0x01,0xFC,
+	0x7F,0x04,0x23,0x18,0x41,0x17,0x01,0x07,0xF8,0x30,0x58,0x00,0x03,0x18,0xC0,0x00,
+	0x1D,0x04,0x01,0xFC,0x7F,0x00,0x03,0x18,0x40,0x01,0xF1,0x07,0x01,0xFC,0x7F,0x04,
+	0x23,0xD8,0xC7,0x00,0x0A,0x0C,0x01,0xFC,0x7F,0x04,0x23,0xD0,0x87,0x00,0x08,0x00,
+	0xF8,0x30,0x58,0x00,0x03,0x18,0xC4,0xE3,0x01,0x01,0x01,0xFC,0x7F,0x08,0x41,0x00,
+	0x82,0x10,0xFE,0x3F,0x80,0x01,0x0C,0xE0,0xFF,0x03,0x18,0x40,0x00,0x18,0x00,0x06,
+	0xC0,0x00,0xF8,0xFF,0x02,0x40,0x00,0x00,0x01,0xFC,0x7F,0x04,0x71,0x50,0xCC,0x81,
+	0x07,0x10,0x01,0xFC,0x7F,0x00,0x01,0x08,0x40,0x00,0x02,0x18,0x01,0xFC,0xFF,0x07,
+	0xC0,0xFF,0x81,0xFF,0x07,0x10,0x01,0xFC,0xBF,0x01,0x31,0x00,0x8E,0x80,0xFD,0x3F,
+	0x00,0xFC,0x11,0x50,0x00,0x03,0x18,0x40,0x01,0xF1,0x07,0x01,0xFC,0x7F,0x08,0x43,
+	0x10,0x82,0x10,0x78,0x00,0xFC,0x21,0x30,0x81,0x14,0x48,0x01,0x27,0xA0,0xFC,0x09,
+	0x01,0xFC,0x7F,0x04,0x23,0x10,0x87,0xC8,0x38,0x18,0x80,0x0E,0x8F,0x60,0x08,0x43,
+	0x18,0xC4,0xC3,0x01,0x03,0x08,0x40,0x00,0xFF,0x1F,0xC0,0x00,0x0C,0x00,0x01,0xF8,
+	0x5F,0x00,0x01,0x08,0xC0,0x00,0xFE,0x2F,0x00,0x01,0x78,0x40,0x3C,0x00,0x0E,0x9C,
+	0x1C,0x1C,0x20,0x00,0x7F,0x08,0x3C,0x38,0x3E,0x00,0x8E,0xC0,0xFF,0x01,0x01,0x1C,
+	0x70,0x63,0xE1,0x00,0x87,0xC6,0x0E,0x38,0x80,0x01,0x38,0x40,0x06,0xC1,0x9F,0xC1,
+	0x03,0x04,0x00,0x02,0x0C,0x78,0x30,0x43,0x98,0xC1,0x03,0x06,0x0C,0xFF,0x7F,0x00,
+	0x18,0x00,0x06,0x80,0x03,0x00,0x03,0x00,0x07,0x00,0x06,0x00,0x0E,0x00,0x0C,0x01,
+	0x60,0x00,0x18,0x00,0xFE,0xFF,0x48,0x12,0x42,0x08,0xFF,0x11,0x01,0xB2,0x64,0xB1,
+	0x58,0xF4,0x03,0x01,0x01,0xF8,0x3F,0x88,0x20,0x08,0x41,0x10,0x01,0x07,0x1C,0x51,
+	0x30,0x18,0x14,0x01,0xC0,0x01,0x11,0x04,0x21,0x18,0xA1,0xFF,0x03,0x10,0xBE,0x62,
+	0xB1,0x58,0x34,0x01,0x10,0x84,0xA0,0xFF,0x23,0x18,0xC1,0x08,0x0C,0x00,0xD6,0x52,
+	0xA6,0x4C,0x79,0x32,0x18,0x01,0xFC,0x3F,0x08,0x21,0x00,0x01,0x08,0x82,0x1F,0x80,
+	0x10,0x9C,0xE0,0xFC,0x01,0x08,0x40,0x00,0x18,0x00,0x42,0xC0,0x09,0x38,0xFF,0x00,
+	0x01,0xFC,0x3F,0x20,0x81,0x00,0x5B,0x08,0x43,0x10,0x01,0x0C,0xE0,0xFF,0x01,0x08,
+	0x40,0xC1,0x7F,0x30,0xF0,0x0F,0x06,0xFC,0xC1,0xBF,0x30,0x10,0xF4,0x03,0x01,0xBE,
+	0x60,0x30,0x18,0xF4,0x01,0x01,0xFF,0x0B,0x0D,0x12,0x44,0x04,0x07,0x1C,0x44,0x04,
+	0x09,0x12,0xF4,0x3F,0x40,0xC1,0xE0,0x5F,0x18,0x0C,0x0C,0x00,0xE6,0x64,0x32,0x99,
+	0x9C,0x01,0x04,0x08,0xFC,0x23,0x48,0x10,0x81,0x1F,0x10,0x08,0x0C,0xFD,0x81,0x81,
+	0x41,0x07,0x0C,0x69,0x0C,0x02,0x9F,0x30,0xE6,0x80,0x09,0x7F,0x02,0xC1,0x31,0xB7,
+	0x33,0x0E,0x02,0x01,0x07,0x76,0x04,0x07,0xA3,0xC1,0x80,0x00,0xC3,0x70,0xB6,0x38,
+	0x0C,0x03,0x40,0x80,0xEF,0x17,0x00,0x06,0x80,0xFF,0xFF,0x01,0x60,0x00,0xE8,0xFB,
+	0x01,0x01,0x4A,0x44,0x0A,
+};
+
+static const uint16_t OLED_PackedFont8x16_Offsets[] = {
+	0, 47, 91, 161, 217, 298, 379, 462,
+	523, 581, 645, 701,
+};
+
+/* 1240 bytes instead of 1520 */
+const OLED_PackedFont_t OLED_PackedFont8x16 = {OLED_PackedFont8x16_Bitmap, OLED_PackedFont8x16_Offsets, OLED_PackedFont8x16_Glyphs, NULL, 0x20, 95, '?' - ' ', 16};
+
+/* OLED_PackedFont6x8, 95 characters from ' ', packed from OLED_F6x8 */
+static const OLED_PackedGlyph_t OLED_PackedFont6x8_Glyphs[] = {
+	/* width, height, x_offset, y_offset, advance */
+	{ 0,  0,  0,  0,  6},  // ' '
+	{ 1,  6,  3,  0,  6},  // '!'
+	{ 3,  3,  2,  0,  6},  // '"'
+	{ 5,  7,  1,  0,  6},  // '#'
+	{ 5,  7,  1,  0,  6},  // '$'
+	{ 5,  7,  1,  0,  6},  // '%'
+	{ 5,  7,  1,  0,  6},  // '&'
+	{ 1,  3,  3,  0,  6},  // '''
+	{ 3,  7,  2,  0,  6},  // '('
+	{ 3,  7,  2,  0,  6},  // ')'
+	{ 5,  5,  1,  1,  6},  // '*'
+	{ 5,  5,  1,  1,  6},  // '+'
+	{ 2,  3,  3,  5,  6},  // ','
+	{ 5,  1,  1,  3,  6},  // '-'
+	{ 2,  2,  2,  5,  6},  // '.'
+	{ 5,  5,  1,  1,  6},  // '/'
+	{ 5,  7,  1,  0,  6},  // '0'
+	{ 3,  7,  2,  0,  6},  // '1'
+	{ 5,  7,  1,  0,  6},  // '2'
+	{ 5,  7,  1,  0,  6},  // '3'
+	{ 5,  7,  1,  0,  6},  // '4'
+	{ 5,  7,  1,  0,  6},  // '5'
+	{ 5,  7,  1,  0,  6},  // '6'
+	{ 5,  7,  1,  0,  6},  // '7'
+	{ 5,  7,  1,  0,  6},  // '8'
+	{ 5,  7,  1,  0,  6},  // '9'
+	{ 2,  5,  2,  1,  6},  // ':'
+	{ 2,  6,  2,  1,  6},  // ';'
+	{ 4,  7,  1,  0,  6},  // '<'
+	{ 5,  3,  1,  2,  6},  // '='
+	{ 4,  7,  2,  0,  6},  // '>'
+	{ 5,  7,  1,  0,  6},  // '?'
+	{ 5,  7,  1,  0,  6},  // '@'
+	{ 5,  7,  1,  0,  6},  // 'A'
+	{ 5,  7,  1,  0,  6},  // 'B'
+	{ 5,  7,  1,  0,  6},  // 'C'
+	{ 5,  7,  1,  0,  6},  // 'D'
+	{ 5,  7,  1,  0,  6},  // 'E'
+	{ 5,  7,  1,  0,  6},  // 'F'
+	{ 5,  7,  1,  0,  6},  // 'G'
+	{ 5,  7,  1,  0,  6},  // 'H'
+	{ 3,  7,  2,  0,  6},  // 'I'
+	{ 5,  7,  1,  0,  6},  // 'J'
+	{ 5,  7,  1,  0,  6},  // 'K'
+	{ 5,  7,  1,  0,  6},  // 'L'
+	{ 5,  7,  1,  0,  6},  // 'M'
+	{ 5,  7,  1,  0,  6},  // 'N'
+	{ 5,  7,  1,  0,  6},  // 'O'
+	{ 5,  7,  1,  0,  6},  // 'P'
+	{ 5,  7,  1,  0,  6},  // 'Q'
+	{ 5,  7,  1,  0,  6},  // 'R'
+	{ 5,  7,  1,  0,  6},  // 'S'
+	{ 5,  7,  1,  0,  6},  // 'T'
+	{ 5,  7,  1,  0,  6},  // 'U'
+	{ 5,  7,  1,  0,  6},  // 'V'
+	{ 5,  7,  1,  0,  6},  // 'W'
+	{ 5,  7,  1,  0,  6},  // 'X'
+	{ 5,  7,  1,  0,  6},  // 'Y'
+	{ 5,  7,  1,  0,  6},  // 'Z'
+	{ 3,  7,  2,  0,  6},  // '['
+	{ 5,  5,  1,  1,  6},  // '\'
+	{ 3,  7,  2,  0,  6},  // ']'
+	{ 5,  3,  1,  0,  6},  // '^'
+	{ 5,  1,  1,  6,  6},  // '_'
+	{ 3,  3,  2,  0,  6},  // '`'
+	{ 5,  5,  1,  2,  6},  // 'a'
+	{ 5,  7,  1,  0,  6},  // 'b'
+	{ 5,  5,  1,  2,  6},  // 'c'
+	{ 5,  7,  1,  0,  6},  // 'd'
+	{ 5,  5,  1,  2,  6},  // 'e'
+	{ 5,  7,  1,  0,  6},  // 'f'
+	{ 5,  6,  1,  2,  6},  // 'g'
+	{ 5,  7,  1,  0,  6},  // 'h'
+	{ 3,  7,  2,  0,  6},  // 'i'
+	{ 4,  8,  1,  0,  6},  // 'j'
+	{ 4,  7,  1,  0,  6},  // 'k'
+	{ 3,  7,  2,  0,  6},  // 'l'
+	{ 5,  5,  1,  2,  6},  // 'm'
+	{ 5,  5,  1,  2,  6},  // 'n'
+	{ 5,  5,  1,  2,  6},  // 'o'
+	{ 5,  6,  1,  2,  6},  // 'p'
+	{ 5,  6,  1,  2,  6},  // 'q'
+	{ 5,  5,  1,  2,  6},  // 'r'
+	{ 5,  5,  1,  2,  6},  // 's'
+	{ 5,  7,  1,  0,  6},  // 't'
+	{ 5,  5,  1,  2,  6},  // 'u'
+	{ 5,  5,  1,  2,  6},  // 'v'
+	{ 5,  5,  1,  2,  6},  // 'w'
+	{ 5,  5,  1,  2,  6},  // 'x'
+	{ 5,  6,  1,  2,  6},  // 'y'
+	{ 5,  5,  1,  2,  6},  // 'z'
+	{ 3,  7,  2,  0,  6},  // '{'
+	{ 1,  7,  3,  0,  6},  // '|'
+	{ 3,  7,  2,  0,  6},  // '}'
+	{ 5,  3,  1,  2,  6},  // '~'
+};
+
+static const uint8_t OLED_PackedFont6x8_Bitmap[] = {
+	0x2F,0xC7,0x01,0x94,0x3F,0xE5,0x4F,0x01,0x24,0xD5,0x5F,0x25,0x01,0xA3,0x09,0x82,
+	0x2C,0x06,0xB6,0x64,0x55,0x04,0x05,0x07,0x1C,0x51,0x10,0x41,0x11,0x07,0x8A,0x7C,
+	0xA2,0x00,0x84,0x7C,0x42,0x00,0x1D,0x1F,0x0F,0x10,0x11,0x11,0x00,0xBE,0x68,0xB2,
+	0xE8,0x03,0xC2,0x3F,0x10,0xC2,0x70,0x34,0x69,0x04,0xA1,0x60,0x71,0x19,0x03,0x18,
+	0x8A,0xE4,0x0F,0x01,0xA7,0x62,0xB1,0x98,0x03,0x3C,0x65,0x32,0x09,0x03,0x81,0x78,
+	0xA2,0x30,0x00,0xB6,0x64,0x32,0x69,0x03,0x86,0x64,0x32,0xE5,0x01,0x7B,0x03,0xEB,
+	0x06,0x08,0x8A,0x28,0x08,0x6D,0x5B,0x41,0x11,0x05,0x01,0x82,0x40,0x34,0x61,0x00,
+	0xBE,0x64,0x35,0xEB,0x02,0x7C,0x49,0x44,0xC2,0x07,0xFF,0x64,0x32,0x69,0x03,0xBE,
+	0x60,0x30,0x28,0x02,0xFF,0x60,0x50,0xC4,0x01,0xFF,0x64,0x32,0x19,0x04,0xFF,0x44,
+	0x22,0x11,0x00,0xBE,0x60,0x32,0xA9,0x07,0x7F,0x04,0x02,0xF1,0x07,0xC1,0x7F,0x10,
+	0x20,0x60,0xF0,0x17,0x00,0x7F,0x04,0x45,0x14,0x04,0x7F,0x20,0x10,0x08,0x04,0x7F,
+	0x01,0x43,0xF0,0x07,0x7F,0x02,0x02,0xF2,0x07,0xBE,0x60,0x30,0xE8,0x03,0xFF,0x44,
+	0x22,0x61,0x00,0xBE,0x60,0x34,0xE4,0x05,0xFF,0x44,0x26,0x65,0x04,0xC6,0x64,0x32,
+	0x19,0x03,0x81,0xC0,0x3F,0x10,0x00,0x3F,0x20,0x10,0xF8,0x03,0x1F,0x10,0x10,0xF4,
+	0x01,0x3F,0x20,0x0E,0xF8,0x03,0x63,0x0A,0x82,0x32,0x06,0x07,0x04,0x1C,0x71,0x00,
+	0xE1,0x68,0xB2,0x38,0x04,0xFF,0x60,0x10,0x41,0x10,0x04,0x01,0xC1,0xE0,0x1F,0x54,
+	0x44,0x1F,0x11,0x01,0xA8,0xD6,0xEA,0x01,0x7F,0x24,0x91,0x88,0x03,0x2E,0xC6,0x88,
+	0x00,0x38,0x22,0x11,0xF9,0x07,0xAE,0xD6,0x6A,0x00,0x08,0x7F,0x22,0x20,0x00,0x46,
+	0x9A,0xA6,0x1F,0x7F,0x04,0x81,0x80,0x07,0xC4,0x3E,0x10,0x40,0x80,0x84,0x7D,0x7F,
+	0x08,0x8A,0x08,0xC1,0x3F,0x10,0x3F,0x98,0xE0,0x01,0x5F,0x84,0xE0,0x01,0x2E,0xC6,
+	0xE8,0x00,0x7F,0x92,0x24,0x06,0x46,0x92,0x18,0x3F,0x5F,0x84,0x20,0x00,0xB2,0xD6,
+	0x8A,0x00,0x84,0x1F,0x11,0x08,0x02,0x0F,0x42,0xF4,0x01,0x07,0x41,0x74,0x00,0x0F,
+	0x32,0xF8,0x00,0x51,0x11,0x15,0x01,0x07,0x8A,0xA2,0x1F,0x31,0xD7,0x19,0x01,0x88,
+	0x7F,0x10,0x7F,0xC1,0x3F,0x02,0x8A,0x28,
+};
+
+static const uint16_t OLED_PackedFont6x8_Offsets[] = {
+	0, 24, 45, 83, 112, 152, 190, 230,
+	258, 291, 322, 355,
+};
+
+/* 875 bytes instead of 570 */
+const OLED_PackedFont_t OLED_PackedFont6x8 = {OLED_PackedFont6x8_Bitmap, OLED_PackedFont6x8_Offsets, OLED_PackedFont6x8_Glyphs, NULL, 0x20, 95, '?' - ' ', 8};
+
 /* Image Library Definitions -------------------------------------------------*/
 
 /* Test image (a box with diode symbols inside), 16 pixels wide, 16 pixels high */
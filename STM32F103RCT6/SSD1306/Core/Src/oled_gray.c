@@ -0,0 +1,180 @@
+/* Includes ------------------------------------------------------------------*/
+
+#include <string.h>
+#include "oled_gray.h"
+
+/* Notes ---------------------------------------------------------------------*/
+
+/**
+ * @brief  Temporal gray display
+ *
+ * @note   A gray level of n bits is split into n bit-planes, each a 1bpp copy of the screen.
+ *         OLED_GrayFlush sends one plane per call, plane k is sent 2^k times in every sequence of 2^n - 1 planes,
+ *         so a pixel is lit for a fraction of the time proportional to its level.
+ *         The planes are interleaved (for 3 planes: 2 1 2 0 2 1 2) to spread the lit frames evenly.
+ *
+ *         The gray levels only look steady when the whole sequence repeats faster than the eye can follow,
+ *         at about 50 Hz that is OLED_GRAY_MIN_RATE planes per second. Every plane is a full screen update,
+ *         compare the measured rate with that number to see whether the transport can sustain it.
+ *         For still images without that requirement, OLED_ShowGrayImage dithers into a single plane instead.
+ */
+
+/* OLED Gray Private Functions -----------------------------------------------*/
+
+/**
+ * @brief  Read a pixel of a grayscale image
+ * @param  image The gray levels in the format of OLED_ShowGrayImage
+ * @param  bits The bits per pixel, OLED_GRAY_4BIT or OLED_GRAY_8BIT
+ * @param  stride The bytes of each row
+ * @param  x The x-coordinate of the pixel
+ * @param  y The y-coordinate of the pixel
+ * @retval The gray level, range: [0,255]
+ */
+static inline uint8_t OLED_GrayPixel(const uint8_t *image, uint8_t bits, uint16_t stride, uint8_t x, uint8_t y)
+{
+	const uint8_t *row = image + y * stride;
+
+	if (bits == OLED_GRAY_4BIT)
+	{
+		return ((x & 0x01) ? row[x / 2] & 0x0F : row[x / 2] >> 4) * 0x11;
+	}
+	return row[x];
+}
+
+/* OLED Gray Functions -------------------------------------------------------*/
+
+/**
+ * @brief  Initialize a temporal gray display
+ * @param  gray The gray display
+ * @param  buf The memory of the planes, OLED_GRAY_BUF_SIZE(planes) bytes
+ * @param  planes The number of planes, 2 gives 4 gray levels and 3 gives 8, range: [1,OLED_GRAY_PLANES_MAX]
+ * @retval None
+ * @note   The planes have the size of the screen at the current rotation, set the rotation first.
+ */
+void OLED_GrayInit(OLED_Gray_t *gray, uint8_t *buf, uint8_t planes)
+{
+	uint8_t k;
+
+	if (planes < 1) {planes = 1;}
+	if (planes > OLED_GRAY_PLANES_MAX) {planes = OLED_GRAY_PLANES_MAX;}
+
+	for (k = 0; k < planes; k++)
+	{
+		OLED_SurfaceInit(&gray->plane[k], buf + k * OLED_SURFACE_SIZE(OLED_Screen.width, OLED_Screen.height),
+		                 OLED_Screen.width, OLED_Screen.height);
+	}
+	gray->planes = planes;
+	gray->step = 0;
+	gray->count = 0;
+	gray->rate_tick = HAL_GetTick();
+	gray->rate = 0;
+
+	OLED_GrayClear(gray);
+}
+
+/**
+ * @brief  Clear all planes of a temporal gray display
+ * @param  gray The gray display
+ * @retval None
+ */
+void OLED_GrayClear(OLED_Gray_t *gray)
+{
+	uint8_t k;
+
+	for (k = 0; k < gray->planes; k++)
+	{
+		memset(gray->plane[k].buf, 0x00, OLED_SURFACE_SIZE(gray->plane[k].width, gray->plane[k].height));
+	}
+}
+
+/**
+ * @brief  Display a grayscale image on a temporal gray display
+ * @param  gray The gray display
+ * @param  x The x-coordinate of the top-left corner of the image, range: [-32768,32767], screen area: [0,127]
+ * @param  y The y-coordinate of the top-left corner of the image, range: [-32768,32767], screen area: [0,63]
+ * @param  width The width of the image, range: [0,255]
+ * @param  height The height of the image, range: [0,255]
+ * @param  image The gray levels in the format of OLED_ShowGrayImage
+ * @param  bits The bits per pixel, range: OLED_GRAY_4BIT or OLED_GRAY_8BIT
+ * @retval None
+ * @note   The levels are rounded to the levels of the planes, and each plane gets strips of 8 rows like OLED_ShowImage,
+ *         in chunks of at most 128 columns.
+ */
+void OLED_GrayShowImage(OLED_Gray_t *gray, int16_t x, int16_t y, uint8_t width, uint8_t height, const uint8_t *image, uint8_t bits)
+{
+	OLED_Surface_t *target = OLED_GetTarget();
+	uint8_t strip[128];
+	uint8_t i, j, k, r, strip_height, chunk_width, level;
+	uint16_t chunk;
+	uint16_t stride = (bits == OLED_GRAY_4BIT) ? (width + 1) / 2 : width;
+	uint16_t levels = (1U << gray->planes) - 1;
+
+	/* Iterate through the strips of 8 rows, the chunks of each strip that fit in the strip buffer, and the planes */
+	for (j = 0; j < (height + 7) / 8; j++)
+	{
+		strip_height = (height - j * 8 < 8) ? height - j * 8 : 8;
+
+		// Strips outside the planes are not converted
+		if (y + j * 8 + 8 <= 0 || y + j * 8 >= gray->plane[0].height) {continue;}
+
+		for (chunk = 0; chunk < width; chunk += 128)
+		{
+			chunk_width = (width - chunk < 128) ? width - chunk : 128;
+
+			// Chunks outside the planes are not converted
+			if (x + chunk + chunk_width <= 0 || x + chunk >= gray->plane[0].width) {continue;}
+
+			for (k = 0; k < gray->planes; k++)
+			{
+				/* Collect bit k of the quantized level of each pixel */
+				for (i = 0; i < chunk_width; i++)
+				{
+					strip[i] = 0x00;
+					for (r = 0; r < strip_height; r++)
+					{
+						level = (OLED_GrayPixel(image, bits, stride, chunk + i, j * 8 + r) * levels + 127) / 255;
+						if (level & (0x01 << k)) {strip[i] |= 0x01 << r;}
+					}
+				}
+
+				OLED_SetTarget(&gray->plane[k]);
+				OLED_ShowImage(x + chunk, y + j * 8, chunk_width, strip_height, strip);
+			}
+		}
+	}
+	OLED_SetTarget(target);
+}
+
+/**
+ * @brief  Send the next plane of a temporal gray display to the OLED hardware
+ * @param  gray The gray display
+ * @retval None
+ * @note   Call it as often as possible, e.g. from the main loop or a timer. The plane is copied to the
+ *         display memory array and sent with OLED_Update. The rate field is updated about once a second.
+ */
+void OLED_GrayFlush(OLED_Gray_t *gray)
+{
+	uint8_t k, n = gray->step + 1;
+	uint32_t now, elapsed;
+
+	/* The plane of step s is planes - 1 minus the trailing zeros of s + 1, giving the weights 2^k */
+	for (k = gray->planes - 1; k > 0 && (n & 0x01) == 0; k--)
+	{
+		n >>= 1;
+	}
+	if (++gray->step == (1U << gray->planes) - 1) {gray->step = 0;}
+
+	memcpy(OLED_Screen.buf, gray->plane[k].buf, OLED_SURFACE_SIZE(OLED_Screen.width, OLED_Screen.height));
+	OLED_Update();
+
+	/* Measure the plane rate */
+	gray->count++;
+	now = HAL_GetTick();
+	elapsed = now - gray->rate_tick;
+	if (elapsed >= 1000)
+	{
+		gray->rate = (uint32_t)gray->count * 1000 / elapsed;
+		gray->count = 0;
+		gray->rate_tick = now;
+	}
+}
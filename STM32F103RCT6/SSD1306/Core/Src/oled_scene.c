@@ -0,0 +1,443 @@
+/* Includes ------------------------------------------------------------------*/
+
+#include <string.h>
+#include "oled_scene.h"
+
+/* Notes ---------------------------------------------------------------------*/
+
+/**
+ * @brief  Retained scene with tile-based dirty re-rendering
+ *
+ * @note   Instead of drawing into the OLED display memory array directly, the items of a screen are added to the scene once.
+ *         When an item changes, the 8*8 tiles under its old and new bounding boxes are marked dirty.
+ *         OLED_SceneRender then re-rasterises only the dirty tiles, by replaying the overlapping items into them
+ *         in slot order, and sends only those tiles to the OLED hardware.
+ *         Contiguous dirty tiles of a page are handled as one span, to share the replay and the I2C transfer.
+ *         The scene owns the whole screen, other content in a dirty tile is overwritten.
+ */
+
+/* Global Variables ----------------------------------------------------------*/
+
+/* Items of the scene, a free slot has the type OLED_SCENE_NONE */
+static OLED_SceneItem_t OLED_SceneItems[OLED_SCENE_MAX_ITEMS];
+
+/* Dirty tiles, bit n of OLED_SceneDirty[page] is the tile at x = [n * 8, n * 8 + 7] of the page */
+/* A screen rotated by 90 or 270 degrees has 16 pages of 8 tiles */
+static uint16_t OLED_SceneDirty[16];
+
+/* Memory of the off-screen surface a dirty span is rasterised into, one page of at most 128 columns */
+static uint8_t OLED_SceneSpanBuf[128];
+
+/* OLED Scene Private Functions ----------------------------------------------*/
+
+/**
+ * @brief  Recalculate the bounding box of an item
+ * @param  item The item
+ * @retval None
+ */
+static void OLED_SceneUpdateBox(OLED_SceneItem_t *item)
+{
+	switch (item->type)
+	{
+		case OLED_SCENE_TEXT:
+			item->box_x = item->x0;
+			item->box_y = item->y0;
+			item->box_width = OLED_MeasureString((const char *)item->data, item->style);
+			item->box_height = (item->style == OLED_8X16) ? 16 : 8;
+			break;
+
+		case OLED_SCENE_LINE:
+			item->box_x = (item->x0 < item->x1) ? item->x0 : item->x1;
+			item->box_y = (item->y0 < item->y1) ? item->y0 : item->y1;
+			item->box_width = ((item->x0 < item->x1) ? item->x1 - item->x0 : item->x0 - item->x1) + 1;
+			item->box_height = ((item->y0 < item->y1) ? item->y1 - item->y0 : item->y0 - item->y1) + 1;
+			break;
+
+		case OLED_SCENE_IMAGE:  // OLED_ShowImage also draws the padding bits of the last page of the image
+			item->box_x = item->x0;
+			item->box_y = item->y0;
+			item->box_width = item->x1;
+			item->box_height = (item->y1 + 7) / 8 * 8;
+			break;
+
+		default:  // Rectangles
+			item->box_x = item->x0;
+			item->box_y = item->y0;
+			item->box_width = item->x1;
+			item->box_height = item->y1;
+			break;
+	}
+}
+
+/**
+ * @brief  Mark the tiles under the bounding box of an item dirty
+ * @param  item The item
+ * @retval None
+ */
+static void OLED_SceneMarkItem(const OLED_SceneItem_t *item)
+{
+	if (item->visible)
+	{
+		OLED_SceneMarkDirty(item->box_x, item->box_y, item->box_width, item->box_height);
+	}
+}
+
+/**
+ * @brief  Add an item to a free slot of the scene
+ * @param  item The item to copy into the scene
+ * @retval The item ID, or -1 if the scene is full
+ */
+static int8_t OLED_SceneAdd(const OLED_SceneItem_t *item)
+{
+	int8_t id;
+
+	/* Find a free slot */
+	for (id = 0; id < OLED_SCENE_MAX_ITEMS; id++)
+	{
+		if (OLED_SceneItems[id].type == OLED_SCENE_NONE)
+		{
+			OLED_SceneItems[id] = *item;
+			OLED_SceneItems[id].visible = 1;
+			OLED_SceneUpdateBox(&OLED_SceneItems[id]);
+			OLED_SceneMarkItem(&OLED_SceneItems[id]);
+			return id;
+		}
+	}
+	return -1;
+}
+
+/**
+ * @brief  Get the item of an ID
+ * @param  id The item ID
+ * @retval The item, or NULL if the ID is not in use
+ */
+static OLED_SceneItem_t *OLED_SceneGet(int8_t id)
+{
+	if (id < 0 || id >= OLED_SCENE_MAX_ITEMS || OLED_SceneItems[id].type == OLED_SCENE_NONE)
+	{
+		return NULL;
+	}
+	return &OLED_SceneItems[id];
+}
+
+/**
+ * @brief  Replay an item on the drawing target
+ * @param  item The item
+ * @param  x The x-coordinate of the screen that maps to x = 0 of the drawing target
+ * @param  y The y-coordinate of the screen that maps to y = 0 of the drawing target
+ * @retval None
+ */
+static void OLED_SceneDraw(const OLED_SceneItem_t *item, int16_t x, int16_t y)
+{
+	if (item->box_width <= 0 || item->box_height <= 0) {return;}  // An empty rectangle or image
+
+	switch (item->type)
+	{
+		case OLED_SCENE_TEXT:
+			OLED_ShowString(item->x0 - x, item->y0 - y, (char *)item->data, item->style);
+			break;
+
+		case OLED_SCENE_RECT:
+			OLED_DrawRectangle(item->x0 - x, item->y0 - y, item->x1, item->y1, item->style);
+			break;
+
+		case OLED_SCENE_LINE:
+			OLED_DrawLine(item->x0 - x, item->y0 - y, item->x1 - x, item->y1 - y);
+			break;
+
+		case OLED_SCENE_IMAGE:
+			OLED_ShowImage(item->x0 - x, item->y0 - y, item->x1, item->y1, (const uint8_t *)item->data);
+			break;
+
+		default:
+			break;
+	}
+}
+
+/* OLED Scene Functions ------------------------------------------------------*/
+
+/**
+ * @brief  Remove all items of the scene and mark the whole screen dirty
+ * @param  None
+ * @retval None
+ */
+void OLED_SceneClear(void)
+{
+	memset(OLED_SceneItems, 0, sizeof(OLED_SceneItems));
+	OLED_SceneMarkDirty(0, 0, OLED_Screen.width, OLED_Screen.height);
+}
+
+/**
+ * @brief  Add a string to the scene
+ * @param  x The x-coordinate of the top-left corner of the string, range: [-32768,32767], screen area: [0,127]
+ * @param  y The y-coordinate of the top-left corner of the string, range: [-32768,32767], screen area: [0,63]
+ * @param  str The string, it is not copied and must stay valid while the item is in the scene
+ * @param  font_size The font size, range: OLED_8X16 or OLED_6X8
+ * @retval The item ID, or -1 if the scene is full
+ * @note   After changing the content of the string, call OLED_SceneSetText to mark it dirty.
+ */
+int8_t OLED_SceneAddText(int16_t x, int16_t y, const char *str, uint8_t font_size)
+{
+	OLED_SceneItem_t item = {0};
+
+	item.type = OLED_SCENE_TEXT;
+	item.style = font_size;
+	item.x0 = x;
+	item.y0 = y;
+	item.data = str;
+	return OLED_SceneAdd(&item);
+}
+
+/**
+ * @brief  Add a rectangle to the scene
+ * @param  x The x-coordinate of the top-left corner of the rectangle, range: [-32768,32767], screen area: [0,127]
+ * @param  y The y-coordinate of the top-left corner of the rectangle, range: [-32768,32767], screen area: [0,63]
+ * @param  width The width of the rectangle, range: [0,128]
+ * @param  height The height of the rectangle, range: [0,64]
+ * @param  is_filled Whether the rectangle is filled, range: OLED_UNFILLED (not filled) or OLED_FILLED (filled)
+ * @retval The item ID, or -1 if the scene is full
+ * @note   A rectangle with a width or height of 0 is not drawn.
+ */
+int8_t OLED_SceneAddRect(int16_t x, int16_t y, uint8_t width, uint8_t height, uint8_t is_filled)
+{
+	OLED_SceneItem_t item = {0};
+
+	item.type = OLED_SCENE_RECT;
+	item.style = is_filled;
+	item.x0 = x;
+	item.y0 = y;
+	item.x1 = width;
+	item.y1 = height;
+	return OLED_SceneAdd(&item);
+}
+
+/**
+ * @brief  Add a line to the scene
+ * @param  x0 The x-coordinate of one endpoint, range: [-32768,32767], screen area: [0,127]
+ * @param  y0 The y-coordinate of one endpoint, range: [-32768,32767], screen area: [0,63]
+ * @param  x1 The x-coordinate of the other endpoint, range: [-32768,32767], screen area: [0,127]
+ * @param  y1 The y-coordinate of the other endpoint, range: [-32768,32767], screen area: [0,63]
+ * @retval The item ID, or -1 if the scene is full
+ */
+int8_t OLED_SceneAddLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1)
+{
+	OLED_SceneItem_t item = {0};
+
+	item.type = OLED_SCENE_LINE;
+	item.x0 = x0;
+	item.y0 = y0;
+	item.x1 = x1;
+	item.y1 = y1;
+	return OLED_SceneAdd(&item);
+}
+
+/**
+ * @brief  Add an image to the scene
+ * @param  x The x-coordinate of the top-left corner of the image, range: [-32768,32767], screen area: [0,127]
+ * @param  y The y-coordinate of the top-left corner of the image, range: [-32768,32767], screen area: [0,63]
+ * @param  width The width of the image, range: [0,128]
+ * @param  height The height of the image, range: [0,64]
+ * @param  image The image data, it is not copied and must stay valid while the item is in the scene
+ * @retval The item ID, or -1 if the scene is full
+ * @note   An image with a width or height of 0 is not drawn.
+ */
+int8_t OLED_SceneAddImage(int16_t x, int16_t y, uint8_t width, uint8_t height, const uint8_t *image)
+{
+	OLED_SceneItem_t item = {0};
+
+	item.type = OLED_SCENE_IMAGE;
+	item.x0 = x;
+	item.y0 = y;
+	item.x1 = width;
+	item.y1 = height;
+	item.data = image;
+	return OLED_SceneAdd(&item);
+}
+
+/**
+ * @brief  Change the string of a text item
+ * @param  id The item ID
+ * @param  str The new string, it can be the same buffer with a changed content
+ * @retval None
+ */
+void OLED_SceneSetText(int8_t id, const char *str)
+{
+	OLED_SceneItem_t *item = OLED_SceneGet(id);
+
+	if (item != NULL && item->type == OLED_SCENE_TEXT)
+	{
+		OLED_SceneMarkItem(item);  // The old bounding box
+		item->data = str;
+		OLED_SceneUpdateBox(item);
+		OLED_SceneMarkItem(item);  // The new bounding box
+	}
+}
+
+/**
+ * @brief  Change the data of an image item
+ * @param  id The item ID
+ * @param  image The new image data, with the same width and height
+ * @retval None
+ */
+void OLED_SceneSetImage(int8_t id, const uint8_t *image)
+{
+	OLED_SceneItem_t *item = OLED_SceneGet(id);
+
+	if (item != NULL && item->type == OLED_SCENE_IMAGE)
+	{
+		item->data = image;
+		OLED_SceneMarkItem(item);
+	}
+}
+
+/**
+ * @brief  Move an item
+ * @param  id The item ID
+ * @param  x The new x-coordinate of the item, a line keeps its direction and length
+ * @param  y The new y-coordinate of the item
+ * @retval None
+ */
+void OLED_SceneMove(int8_t id, int16_t x, int16_t y)
+{
+	OLED_SceneItem_t *item = OLED_SceneGet(id);
+
+	if (item != NULL)
+	{
+		OLED_SceneMarkItem(item);
+		if (item->type == OLED_SCENE_LINE)
+		{
+			item->x1 += x - item->x0;
+			item->y1 += y - item->y0;
+		}
+		item->x0 = x;
+		item->y0 = y;
+		OLED_SceneUpdateBox(item);
+		OLED_SceneMarkItem(item);
+	}
+}
+
+/**
+ * @brief  Show or hide an item
+ * @param  id The item ID
+ * @param  visible Whether the item is drawn, 1: shown, 0: hidden
+ * @retval None
+ */
+void OLED_SceneSetVisible(int8_t id, uint8_t visible)
+{
+	OLED_SceneItem_t *item = OLED_SceneGet(id);
+
+	if (item != NULL && item->visible != !!visible)
+	{
+		item->visible = 1;  // Mark the bounding box in both directions
+		OLED_SceneMarkItem(item);
+		item->visible = !!visible;
+	}
+}
+
+/**
+ * @brief  Remove an item from the scene
+ * @param  id The item ID, it may be reused by the next added item
+ * @retval None
+ */
+void OLED_SceneRemove(int8_t id)
+{
+	OLED_SceneItem_t *item = OLED_SceneGet(id);
+
+	if (item != NULL)
+	{
+		OLED_SceneMarkItem(item);
+		item->type = OLED_SCENE_NONE;
+	}
+}
+
+/**
+ * @brief  Mark the tiles under an area dirty
+ * @param  x The x-coordinate of the top-left corner of the area, range: [-32768,32767], screen area: [0,127]
+ * @param  y The y-coordinate of the top-left corner of the area, range: [-32768,32767], screen area: [0,63]
+ * @param  width The width of the area
+ * @param  height The height of the area
+ * @retval None
+ */
+void OLED_SceneMarkDirty(int16_t x, int16_t y, int16_t width, int16_t height)
+{
+	int16_t page, page1, tile, tile1;
+	uint16_t mask;
+
+	/* Clip the area to the screen */
+	if (x < 0) {width += x; x = 0;}
+	if (y < 0) {height += y; y = 0;}
+	if (x + width > OLED_Screen.width) {width = OLED_Screen.width - x;}
+	if (y + height > OLED_Screen.height) {height = OLED_Screen.height - y;}
+	if (width <= 0 || height <= 0) {return;}
+
+	tile = x / 8;
+	tile1 = (x + width - 1) / 8;
+	page1 = (y + height - 1) / 8;
+
+	// Tiles [tile,tile1] of each page
+	mask = (uint16_t)((0xFFFFUL >> (15 - tile1)) & (0xFFFFUL << tile));
+
+	for (page = y / 8; page <= page1; page++)
+	{
+		OLED_SceneDirty[page] |= mask;
+	}
+}
+
+/**
+ * @brief  Re-rasterise the dirty tiles and send them to the OLED hardware
+ * @param  None
+ * @retval None
+ * @note   The items are drawn into the OLED display memory array, the drawing target is restored afterwards.
+ */
+void OLED_SceneRender(void)
+{
+	int16_t page, tile, tile1, span_x, span_width;
+	uint8_t id;
+	uint16_t dirty;
+	OLED_SceneItem_t *item;
+	OLED_Surface_t span;
+	OLED_Surface_t *target = OLED_GetTarget();
+
+	/* Iterate through the pages of the screen */
+	for (page = 0; page < (OLED_Screen.height + 7) / 8; page++)
+	{
+		dirty = OLED_SceneDirty[page];
+		OLED_SceneDirty[page] = 0;
+
+		/* Iterate through the runs of contiguous dirty tiles */
+		tile = 0;
+		while (dirty >> tile)
+		{
+			while (!(dirty & (0x01 << tile))) {tile++;}
+			tile1 = tile;
+			while (tile1 < 16 && (dirty & (0x01 << tile1))) {tile1++;}
+
+			span_x = tile * 8;
+			span_width = (tile1 - tile) * 8;
+
+			/* Replay the items overlapping the span into an off-screen surface */
+			OLED_SurfaceInit(&span, OLED_SceneSpanBuf, span_width, 8);
+			OLED_SetTarget(&span);
+			OLED_Clear();
+			for (id = 0; id < OLED_SCENE_MAX_ITEMS; id++)
+			{
+				item = &OLED_SceneItems[id];
+				if (item->type != OLED_SCENE_NONE && item->visible &&
+					  item->box_x < span_x + span_width && item->box_x + item->box_width > span_x &&
+					  item->box_y < page * 8 + 8 && item->box_y + item->box_height > page * 8)
+				{
+					OLED_SceneDraw(item, span_x, page * 8);
+				}
+			}
+
+			/* Copy the span to the OLED display memory array and send it */
+			OLED_SetTarget(NULL);
+			OLED_BlitSurface(span_x, page * 8, span_width, 8, &span, 0, 0);
+			OLED_UpdateArea(span_x, page * 8, span_width, 8);
+
+			tile = tile1;
+		}
+	}
+
+	OLED_SetTarget(target);
+}
@@ -0,0 +1,423 @@
+/* Includes ------------------------------------------------------------------*/
+
+#include <string.h>
+#include "oled_sprite.h"
+
+/* Notes ---------------------------------------------------------------------*/
+
+/**
+ * @brief  Sprite layer compositor
+ *
+ * @note   The sprites are drawn over a background surface with the size of the screen.
+ *         OLED_SpriteUpdate only touches the old and new bounding boxes of the changed sprites:
+ *         each box is restored from the background, the sprites overlapping it are composited in z-order
+ *         through their masks, and the box is sent to the OLED hardware.
+ *         Moving a sprite therefore needs neither OLED_ClearArea nor redrawing the background by hand,
+ *         and costs time proportional to the sprite area, not the screen.
+ */
+
+/* Data Type Definitions -----------------------------------------------------*/
+
+/* Area of the screen to recompose */
+typedef struct
+{
+	int16_t x, y, width, height;
+} OLED_SpriteRegion_t;
+
+/* Global Variables ----------------------------------------------------------*/
+
+static OLED_Sprite_t OLED_Sprites[OLED_SPRITE_MAX];
+
+/* Background the sprites are composited over, NULL: a cleared background */
+static const OLED_Surface_t *OLED_SpriteBackground = NULL;
+
+/* Areas to recompose at the next update, at most the old and new boxes of each sprite */
+static OLED_SpriteRegion_t OLED_SpriteRegions[OLED_SPRITE_MAX * 2];
+static uint8_t OLED_SpriteRegionCount = 0;
+
+/* OLED Sprite Private Functions ---------------------------------------------*/
+
+/**
+ * @brief  Add an area to recompose, merging it with an overlapping area
+ * @param  x The x-coordinate of the top-left corner of the area
+ * @param  y The y-coordinate of the top-left corner of the area
+ * @param  width The width of the area
+ * @param  height The height of the area
+ * @retval None
+ */
+static void OLED_SpriteAddRegion(int16_t x, int16_t y, int16_t width, int16_t height)
+{
+	uint8_t i;
+	int16_t x1, y1;
+	OLED_SpriteRegion_t *region;
+
+	/* Clip the area to the screen */
+	if (x < 0) {width += x; x = 0;}
+	if (y < 0) {height += y; y = 0;}
+	if (x + width > OLED_Screen.width) {width = OLED_Screen.width - x;}
+	if (y + height > OLED_Screen.height) {height = OLED_Screen.height - y;}
+	if (width <= 0 || height <= 0) {return;}
+
+	/* Find an overlapping area, or use the last one if the list is full */
+	for (i = 0; i < OLED_SpriteRegionCount; i++)
+	{
+		region = &OLED_SpriteRegions[i];
+		if (x < region->x + region->width && x + width > region->x &&
+			  y < region->y + region->height && y + height > region->y)
+		{
+			break;
+		}
+	}
+	if (i == OLED_SpriteRegionCount && i < OLED_SPRITE_MAX * 2)
+	{
+		OLED_SpriteRegions[i].x = x;
+		OLED_SpriteRegions[i].y = y;
+		OLED_SpriteRegions[i].width = width;
+		OLED_SpriteRegions[i].height = height;
+		OLED_SpriteRegionCount++;
+		return;
+	}
+	if (i == OLED_SPRITE_MAX * 2) {i--;}
+
+	/* Merge into the union of both areas */
+	region = &OLED_SpriteRegions[i];
+	x1 = (x + width > region->x + region->width) ? x + width : region->x + region->width;
+	y1 = (y + height > region->y + region->height) ? y + height : region->y + region->height;
+	if (x < region->x) {region->x = x;}
+	if (y < region->y) {region->y = y;}
+	region->width = x1 - region->x;
+	region->height = y1 - region->y;
+}
+
+/**
+ * @brief  Get a sprite by its ID
+ * @param  id The sprite ID
+ * @retval The sprite, or NULL if the ID is not in use
+ */
+static OLED_Sprite_t *OLED_SpriteGet(int8_t id)
+{
+	if (id < 0 || id >= OLED_SPRITE_MAX || !OLED_Sprites[id].in_use)
+	{
+		return NULL;
+	}
+	return &OLED_Sprites[id];
+}
+
+/**
+ * @brief  Get 8 vertical pixels of page format data starting at a row that is not page-aligned
+ * @param  lo The column in the page containing the first row, NULL if above the data
+ * @param  hi The column in the next page, NULL if below the data or not needed
+ * @param  shift The first row within its page
+ * @retval The 8 pixels, the first row in bit 0
+ */
+static inline uint8_t OLED_SpriteGather(const uint8_t *lo, const uint8_t *hi, int16_t shift)
+{
+	uint8_t data = 0;
+
+	if (lo != NULL) {data = *lo >> shift;}
+	if (hi != NULL) {data |= *hi << (8 - shift);}
+	return data;
+}
+
+/**
+ * @brief  Composite a sprite into an area of the OLED display memory array
+ * @param  sprite The sprite
+ * @param  x The x-coordinate of the top-left corner of the area, inside the screen
+ * @param  y The y-coordinate of the top-left corner of the area, inside the screen
+ * @param  width The width of the area
+ * @param  height The height of the area
+ * @retval None
+ */
+static void OLED_SpriteDraw(const OLED_Sprite_t *sprite, int16_t x, int16_t y, int16_t width, int16_t height)
+{
+	int16_t i, x0, y0, x1, y1, page, row, src_page, shift, src_pages, offset;
+	uint8_t row_mask, mask, data;
+	const uint8_t *img_lo, *img_hi, *mask_lo, *mask_hi;
+	uint8_t *dst;
+
+	/* Intersect the area with the sprite */
+	x0 = (sprite->x > x) ? sprite->x : x;
+	y0 = (sprite->y > y) ? sprite->y : y;
+	x1 = (sprite->x + sprite->width < x + width) ? sprite->x + sprite->width : x + width;
+	y1 = (sprite->y + sprite->height < y + height) ? sprite->y + sprite->height : y + height;
+	if (x0 >= x1 || y0 >= y1) {return;}
+
+	src_pages = (sprite->height + 7) / 8;
+
+	/* Iterate through the pages of the intersection */
+	for (page = y0 / 8; page <= (y1 - 1) / 8; page++)
+	{
+		// Mask of the rows of this page inside the intersection
+		row_mask = 0xFF;
+		if (page * 8 < y0) {row_mask &= 0xFF << (y0 - page * 8);}
+		if (page * 8 + 8 > y1) {row_mask &= 0xFF >> (page * 8 + 8 - y1);}
+
+		// The first row of this page maps to this row of the sprite
+		row = page * 8 - sprite->y;
+		src_page = (row >= 0) ? row / 8 : -1;
+		shift = row - src_page * 8;
+		offset = x0 - sprite->x;
+
+		img_lo = (src_page >= 0) ? &sprite->image[src_page * sprite->width + offset] : NULL;
+		img_hi = (shift != 0 && src_page + 1 < src_pages) ? &sprite->image[(src_page + 1) * sprite->width + offset] : NULL;
+		mask_lo = mask_hi = NULL;
+		if (sprite->mask != NULL)
+		{
+			mask_lo = (src_page >= 0) ? &sprite->mask[src_page * sprite->width + offset] : NULL;
+			mask_hi = (shift != 0 && src_page + 1 < src_pages) ? &sprite->mask[(src_page + 1) * sprite->width + offset] : NULL;
+		}
+
+		dst = &OLED_Screen.buf[page * OLED_Screen.width + x0];
+
+		/* Iterate through the columns of the intersection */
+		for (i = 0; i < x1 - x0; i++)
+		{
+			data = OLED_SpriteGather(img_lo ? img_lo + i : NULL, img_hi ? img_hi + i : NULL, shift);
+			mask = row_mask;
+			if (sprite->mask != NULL)
+			{
+				mask &= OLED_SpriteGather(mask_lo ? mask_lo + i : NULL, mask_hi ? mask_hi + i : NULL, shift);
+			}
+
+			// Opaque pixels of the sprite replace the content below
+			dst[i] = (dst[i] & ~mask) | (data & mask);
+		}
+	}
+}
+
+/**
+ * @brief  Recompose an area of the screen and send it to the OLED hardware
+ * @param  region The area, inside the screen
+ * @param  order The IDs of the sprites in z-order
+ * @param  count The number of IDs in order
+ * @retval None
+ */
+static void OLED_SpriteCompose(const OLED_SpriteRegion_t *region, const int8_t *order, uint8_t count)
+{
+	uint8_t i;
+	OLED_Surface_t *target;
+	const OLED_Sprite_t *sprite;
+
+	/* Restore the background of the area */
+	target = OLED_GetTarget();
+	OLED_SetTarget(NULL);
+	if (OLED_SpriteBackground != NULL)
+	{
+		OLED_BlitSurface(region->x, region->y, region->width, region->height, OLED_SpriteBackground, region->x, region->y);
+	}
+	else
+	{
+		OLED_ClearArea(region->x, region->y, region->width, region->height);
+	}
+	OLED_SetTarget(target);
+
+	/* Composite the sprites from bottom to top */
+	for (i = 0; i < count; i++)
+	{
+		sprite = &OLED_Sprites[order[i]];
+		if (sprite->visible)
+		{
+			OLED_SpriteDraw(sprite, region->x, region->y, region->width, region->height);
+		}
+	}
+
+	OLED_UpdateArea(region->x, region->y, region->width, region->height);
+}
+
+/* OLED Sprite Functions -----------------------------------------------------*/
+
+/**
+ * @brief  Set the background the sprites are composited over
+ * @param  background The background surface with the size of the OLED_Screen, NULL: a cleared background
+ * @retval None
+ * @note   The background is not sent to the screen here, only the areas of changed sprites are restored from it.
+ */
+void OLED_SpriteSetBackground(const OLED_Surface_t *background)
+{
+	OLED_SpriteBackground = background;
+}
+
+/**
+ * @brief  Create a sprite
+ * @param  x The x-coordinate of the top-left corner of the sprite, range: [-32768,32767], screen area: [0,127]
+ * @param  y The y-coordinate of the top-left corner of the sprite, range: [-32768,32767], screen area: [0,63]
+ * @param  width The width of the sprite, range: [0,128]
+ * @param  height The height of the sprite, range: [0,64]
+ * @param  image The image data in page format
+ * @param  mask The mask data in page format with the same size, NULL: the whole box is opaque
+ * @param  z The z-order, sprites with a greater z are drawn on top
+ * @retval The sprite ID, or -1 if the pool is full
+ */
+int8_t OLED_SpriteCreate(int16_t x, int16_t y, uint8_t width, uint8_t height, const uint8_t *image, const uint8_t *mask, int8_t z)
+{
+	int8_t id;
+	OLED_Sprite_t *sprite;
+
+	/* Find a free slot of the pool */
+	for (id = 0; id < OLED_SPRITE_MAX; id++)
+	{
+		sprite = &OLED_Sprites[id];
+		if (!sprite->in_use)
+		{
+			memset(sprite, 0, sizeof(OLED_Sprite_t));
+			sprite->image = image;
+			sprite->mask = mask;
+			sprite->x = x;
+			sprite->y = y;
+			sprite->width = width;
+			sprite->height = height;
+			sprite->z = z;
+			sprite->in_use = 1;
+			sprite->visible = 1;
+			sprite->dirty = 1;
+			return id;
+		}
+	}
+	return -1;
+}
+
+/**
+ * @brief  Destroy a sprite, its area is restored at the next update
+ * @param  id The sprite ID
+ * @retval None
+ */
+void OLED_SpriteDestroy(int8_t id)
+{
+	OLED_Sprite_t *sprite = OLED_SpriteGet(id);
+
+	if (sprite != NULL)
+	{
+		if (sprite->drawn)
+		{
+			OLED_SpriteAddRegion(sprite->drawn_x, sprite->drawn_y, sprite->drawn_width, sprite->drawn_height);
+		}
+		sprite->in_use = 0;
+	}
+}
+
+/**
+ * @brief  Move a sprite
+ * @param  id The sprite ID
+ * @param  x The new x-coordinate of the top-left corner of the sprite
+ * @param  y The new y-coordinate of the top-left corner of the sprite
+ * @retval None
+ */
+void OLED_SpriteMove(int8_t id, int16_t x, int16_t y)
+{
+	OLED_Sprite_t *sprite = OLED_SpriteGet(id);
+
+	if (sprite != NULL && (sprite->x != x || sprite->y != y))
+	{
+		sprite->x = x;
+		sprite->y = y;
+		sprite->dirty = 1;
+	}
+}
+
+/**
+ * @brief  Change the image of a sprite, e.g. the next frame of an animation
+ * @param  id The sprite ID
+ * @param  image The new image data with the same size
+ * @param  mask The new mask data, NULL: the whole box is opaque
+ * @retval None
+ */
+void OLED_SpriteSetImage(int8_t id, const uint8_t *image, const uint8_t *mask)
+{
+	OLED_Sprite_t *sprite = OLED_SpriteGet(id);
+
+	if (sprite != NULL)
+	{
+		sprite->image = image;
+		sprite->mask = mask;
+		sprite->dirty = 1;
+	}
+}
+
+/**
+ * @brief  Change the z-order of a sprite
+ * @param  id The sprite ID
+ * @param  z The new z-order
+ * @retval None
+ */
+void OLED_SpriteSetZ(int8_t id, int8_t z)
+{
+	OLED_Sprite_t *sprite = OLED_SpriteGet(id);
+
+	if (sprite != NULL && sprite->z != z)
+	{
+		sprite->z = z;
+		sprite->dirty = 1;
+	}
+}
+
+/**
+ * @brief  Show or hide a sprite
+ * @param  id The sprite ID
+ * @param  visible Whether the sprite is drawn, 1: shown, 0: hidden
+ * @retval None
+ */
+void OLED_SpriteSetVisible(int8_t id, uint8_t visible)
+{
+	OLED_Sprite_t *sprite = OLED_SpriteGet(id);
+
+	if (sprite != NULL && sprite->visible != !!visible)
+	{
+		sprite->visible = !!visible;
+		sprite->dirty = 1;
+	}
+}
+
+/**
+ * @brief  Recompose the areas of the changed sprites and send them to the OLED hardware
+ * @param  None
+ * @retval None
+ * @note   Call it once per frame after moving or changing the sprites.
+ */
+void OLED_SpriteUpdate(void)
+{
+	int8_t order[OLED_SPRITE_MAX];
+	uint8_t count = 0;
+	int8_t id;
+	uint8_t i;
+	OLED_Sprite_t *sprite;
+
+	/* Collect the old and new boxes of the changed sprites, and sort the sprites in z-order */
+	for (id = 0; id < OLED_SPRITE_MAX; id++)
+	{
+		sprite = &OLED_Sprites[id];
+		if (!sprite->in_use) {continue;}
+
+		if (sprite->dirty)
+		{
+			if (sprite->drawn)
+			{
+				OLED_SpriteAddRegion(sprite->drawn_x, sprite->drawn_y, sprite->drawn_width, sprite->drawn_height);
+			}
+			if (sprite->visible)
+			{
+				OLED_SpriteAddRegion(sprite->x, sprite->y, sprite->width, sprite->height);
+			}
+			sprite->drawn = sprite->visible;
+			sprite->drawn_x = sprite->x;
+			sprite->drawn_y = sprite->y;
+			sprite->drawn_width = sprite->width;
+			sprite->drawn_height = sprite->height;
+			sprite->dirty = 0;
+		}
+
+		/* Insertion sort by z, sprites with the same z keep the order of their IDs */
+		for (i = count; i > 0 && OLED_Sprites[order[i - 1]].z > sprite->z; i--)
+		{
+			order[i] = order[i - 1];
+		}
+		order[i] = id;
+		count++;
+	}
+
+	/* Recompose each area, composing is idempotent so areas that still overlap after merging are only sent twice */
+	for (i = 0; i < OLED_SpriteRegionCount; i++)
+	{
+		OLED_SpriteCompose(&OLED_SpriteRegions[i], order, count);
+	}
+	OLED_SpriteRegionCount = 0;
+}
@@ -0,0 +1,304 @@
+/* Includes ------------------------------------------------------------------*/
+
+#include <string.h>
+#include "oled_transition.h"
+
+/* Notes ---------------------------------------------------------------------*/
+
+/**
+ * @brief  Screen transition engine
+ *
+ * @note   The old and new screens are drawn into two surfaces with the size of the screen,
+ *         every frame of the transition is then composed into the display memory array from them.
+ *         A frame always consists of two parts split at a boundary, each taken from one surface at some offset,
+ *         so that slides, pushes and wipes only differ in the boundary and the two offsets.
+ *
+ *         Horizontal transitions copy whole page rows with memcpy. Vertical transitions shift
+ *         four columns at once in a 32-bit word, the bits of each byte are moved with byte-wise masks.
+ */
+
+/* Macros --------------------------------------------------------------------*/
+
+#define OLED_TRANSITION_KIND(type)      ((type) & 0x0C)
+#define OLED_TRANSITION_SLIDE           0x00
+#define OLED_TRANSITION_PUSH            0x04
+#define OLED_TRANSITION_WIPE            0x08
+
+#define OLED_TRANSITION_VERTICAL(type)  ((type) & 0x02)
+#define OLED_TRANSITION_FORWARD(type)   (!((type) & 0x01))  // Left or up, the new screen is the second part
+
+/* OLED Easing Functions -----------------------------------------------------*/
+
+/**
+ * @brief  Linear easing
+ * @param  t The elapsed time, range: [0,OLED_EASE_ONE]
+ * @retval The progress, range: [0,OLED_EASE_ONE]
+ */
+uint16_t OLED_EaseLinear(uint16_t t)
+{
+	return t;
+}
+
+/**
+ * @brief  Quadratic easing, accelerating from zero velocity
+ * @param  t The elapsed time, range: [0,OLED_EASE_ONE]
+ * @retval The progress, range: [0,OLED_EASE_ONE]
+ */
+uint16_t OLED_EaseIn(uint16_t t)
+{
+	return (uint32_t)t * t / OLED_EASE_ONE;
+}
+
+/**
+ * @brief  Quadratic easing, decelerating to zero velocity
+ * @param  t The elapsed time, range: [0,OLED_EASE_ONE]
+ * @retval The progress, range: [0,OLED_EASE_ONE]
+ */
+uint16_t OLED_EaseOut(uint16_t t)
+{
+	uint32_t r = OLED_EASE_ONE - t;
+
+	return OLED_EASE_ONE - r * r / OLED_EASE_ONE;
+}
+
+/**
+ * @brief  Quadratic easing, accelerating until halfway, then decelerating
+ * @param  t The elapsed time, range: [0,OLED_EASE_ONE]
+ * @retval The progress, range: [0,OLED_EASE_ONE]
+ */
+uint16_t OLED_EaseInOut(uint16_t t)
+{
+	uint32_t r = OLED_EASE_ONE - t;
+
+	if (t < OLED_EASE_ONE / 2)
+	{
+		return (uint32_t)t * t * 2 / OLED_EASE_ONE;
+	}
+	return OLED_EASE_ONE - r * r * 2 / OLED_EASE_ONE;
+}
+
+/* OLED Transition Private Functions -----------------------------------------*/
+
+/**
+ * @brief  Compose a page row of the display memory array from 8 rows of a surface
+ * @param  dst The page row in the display memory array
+ * @param  src The surface, its width must be a multiple of 4
+ * @param  row The first row of the surface to take, may be outside the surface, those rows are blank
+ * @param  mask The bits of the page row to replace, the other bits are kept
+ * @retval None
+ */
+static void OLED_TransitionRow(uint8_t *dst, const OLED_Surface_t *src, int16_t row, uint8_t mask)
+{
+	int16_t pages = (src->height + 7) / 8, page, shift, x;
+	const uint8_t *lo = NULL, *hi = NULL;
+	uint32_t lo_word = 0, hi_word = 0, word, keep;
+	uint32_t lo_mask, dst_mask = 0x01010101UL * mask;
+
+	/* A negative coordinate needs an offset when calculating the page address and shift */
+	page = row / 8;
+	shift = row % 8;
+	if (shift < 0)
+	{
+		page -= 1;
+		shift += 8;
+	}
+	if (page >= 0 && page < pages) {lo = src->buf + page * src->width;}
+	if (shift > 0 && page + 1 >= 0 && page + 1 < pages) {hi = src->buf + (page + 1) * src->width;}
+	lo_mask = 0x01010101UL * (0xFF >> shift);
+
+	/* Four columns per word, the masks keep the bits of each byte apart */
+	for (x = 0; x < src->width; x += 4)
+	{
+		if (lo != NULL) {memcpy(&lo_word, lo + x, 4);}
+		if (hi != NULL) {memcpy(&hi_word, hi + x, 4);}
+
+		word = lo_word;
+		if (shift > 0)
+		{
+			word = ((lo_word >> shift) & lo_mask) | ((hi_word << (8 - shift)) & ~lo_mask);
+		}
+		if (mask != 0xFF)
+		{
+			memcpy(&keep, dst + x, 4);
+			word = (word & dst_mask) | (keep & ~dst_mask);
+		}
+		memcpy(dst + x, &word, 4);
+	}
+}
+
+/**
+ * @brief  Compose a frame of the transition into the display memory array
+ * @param  transition The transition
+ * @param  offset The distance the transition has moved, range: [0,extent]
+ * @retval None
+ */
+static void OLED_TransitionCompose(const OLED_Transition_t *transition, int16_t offset)
+{
+	const OLED_Surface_t *first, *second;
+	int16_t width = OLED_Screen.width, height = OLED_Screen.height;
+	int16_t extent, boundary, first_offset, second_offset, page;
+	uint8_t kind = OLED_TRANSITION_KIND(transition->type), mask;
+	uint8_t *dst;
+
+	extent = OLED_TRANSITION_VERTICAL(transition->type) ? height : width;
+
+	/* Split the frame at the boundary, the parts before and after it come from the two surfaces */
+	if (OLED_TRANSITION_FORWARD(transition->type))
+	{
+		boundary = extent - offset;
+		first = transition->from;
+		second = transition->to;
+		first_offset = (kind == OLED_TRANSITION_PUSH) ? offset : 0;
+		second_offset = (kind == OLED_TRANSITION_WIPE) ? 0 : -boundary;
+	}
+	else
+	{
+		boundary = offset;
+		first = transition->to;
+		second = transition->from;
+		first_offset = (kind == OLED_TRANSITION_WIPE) ? 0 : extent - offset;
+		second_offset = (kind == OLED_TRANSITION_PUSH) ? -offset : 0;
+	}
+
+	for (page = 0; page < (height + 7) / 8; page++)
+	{
+		dst = OLED_Screen.buf + page * width;
+
+		if (!OLED_TRANSITION_VERTICAL(transition->type))
+		{
+			/* Page-aligned copies of the two column ranges */
+			memcpy(dst, first->buf + page * width + first_offset, boundary);
+			memcpy(dst + boundary, second->buf + page * width + boundary + second_offset, width - boundary);
+			continue;
+		}
+
+		/* The rows of this page above the boundary come from the first surface */
+		if (boundary <= page * 8) {mask = 0x00;}
+		else if (boundary >= page * 8 + 8) {mask = 0xFF;}
+		else {mask = 0xFF >> (8 - (boundary - page * 8));}
+
+		if (mask != 0x00)
+		{
+			OLED_TransitionRow(dst, first, page * 8 + first_offset, mask);
+		}
+		if (mask != 0xFF)
+		{
+			OLED_TransitionRow(dst, second, page * 8 + second_offset, ~mask);
+		}
+	}
+}
+
+/**
+ * @brief  Compose a frame and send it to the OLED hardware
+ * @param  transition The transition
+ * @param  offset The distance the transition has moved
+ * @retval None
+ * @note   A wipe only changes the area between the old and new edge, only that area is sent.
+ */
+static void OLED_TransitionFrame(OLED_Transition_t *transition, int16_t offset)
+{
+	int16_t last = transition->offset, extent, start, end;
+	uint32_t cycles = OLED_TRANSITION_CYCLES();
+
+	OLED_TransitionCompose(transition, offset);
+
+	cycles = OLED_TRANSITION_CYCLES() - cycles;
+	transition->compose_cycles = cycles;
+	transition->compose_total += cycles;
+	if (cycles > transition->compose_max) {transition->compose_max = cycles;}
+	transition->frames++;
+	transition->offset = offset;
+
+	if (OLED_TRANSITION_KIND(transition->type) != OLED_TRANSITION_WIPE || offset <= last)
+	{
+		OLED_Update();
+		return;
+	}
+
+	/* The moved edge range in screen coordinates */
+	if (OLED_TRANSITION_FORWARD(transition->type))
+	{
+		extent = OLED_TRANSITION_VERTICAL(transition->type) ? OLED_Screen.height : OLED_Screen.width;
+		start = extent - offset;
+		end = extent - last;
+	}
+	else
+	{
+		start = last;
+		end = offset;
+	}
+
+	if (OLED_TRANSITION_VERTICAL(transition->type))
+	{
+		OLED_UpdateArea(0, start, OLED_Screen.width, end - start);
+	}
+	else
+	{
+		OLED_UpdateArea(start, 0, end - start, OLED_Screen.height);
+	}
+}
+
+/* OLED Transition Functions -------------------------------------------------*/
+
+/**
+ * @brief  Start a transition, the old screen is displayed and sent to the OLED hardware
+ * @param  transition The transition state
+ * @param  from The old screen, a surface with the size of OLED_Screen
+ * @param  to The new screen, a surface with the size of OLED_Screen
+ * @param  type The transition, OLED_TRANSITION_SLIDE_LEFT ... OLED_TRANSITION_WIPE_DOWN
+ * @param  duration The duration in milliseconds
+ * @param  ease The easing function, like OLED_EaseInOut, NULL: linear
+ * @retval None
+ * @note   The screen width must be a multiple of 4, which holds for all rotations.
+ *         Call OLED_TransitionTick until it returns 0, the display memory array then holds the new screen.
+ */
+void OLED_TransitionStart(OLED_Transition_t *transition, const OLED_Surface_t *from, const OLED_Surface_t *to,
+                          uint8_t type, uint16_t duration, OLED_Easing_t ease)
+{
+#if OLED_TRANSITION_USE_DWT
+	/* Enable the cycle counter for the compose time */
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+
+	transition->from = from;
+	transition->to = to;
+	transition->type = type;
+	transition->duration = duration;
+	transition->ease = (ease != NULL) ? ease : OLED_EaseLinear;
+	transition->start = HAL_GetTick();
+	transition->offset = 0;
+	transition->frames = 0;
+	transition->compose_cycles = 0;
+	transition->compose_max = 0;
+	transition->compose_total = 0;
+
+	OLED_TransitionFrame(transition, 0);
+}
+
+/**
+ * @brief  Advance a transition according to the HAL tick
+ * @param  transition The transition state
+ * @retval Whether the transition is still running, 1: running, 0: finished
+ * @note   Call it regularly from the main loop. A frame is only composed and sent when the offset changed.
+ */
+uint8_t OLED_TransitionTick(OLED_Transition_t *transition)
+{
+	uint32_t elapsed = HAL_GetTick() - transition->start;
+	int16_t extent, offset;
+
+	extent = OLED_TRANSITION_VERTICAL(transition->type) ? OLED_Screen.height : OLED_Screen.width;
+
+	if (elapsed >= transition->duration)
+	{
+		if (transition->offset != extent) {OLED_TransitionFrame(transition, extent);}
+		return 0;
+	}
+
+	offset = (int32_t)transition->ease(elapsed * OLED_EASE_ONE / transition->duration) * extent / OLED_EASE_ONE;
+	if (offset != transition->offset)
+	{
+		OLED_TransitionFrame(transition, offset);
+	}
+	return 1;
+}
@@ -46,6 +46,10 @@ defined in linker script */
 .word _sbss
 /* end address for the .bss section. defined in linker script */
 .word _ebss
+/* start address for the .oled_buf section. defined in linker script */
+.word _soled_buf
+/* end address for the .oled_buf section. defined in linker script */
+.word _eoled_buf
 
 .equ  BootRAM,        0xF1E0F85F
 /**
@@ -96,6 +100,19 @@ LoopFillZerobss:
   cmp r2, r4
   bcc FillZerobss
 
+/* Zero fill the OLED display memory, which is NOLOAD and outside the bss segment. */
+  ldr r2, =_soled_buf
+  ldr r4, =_eoled_buf
+  b LoopFillZeroOledBuf
+
+FillZeroOledBuf:
+  str  r3, [r2]
+  adds r2, r2, #4
+
+LoopFillZeroOledBuf:
+  cmp r2, r4
+  bcc FillZeroOledBuf
+
 /* Call static constructors */
     bl __libc_init_array
 /* Call the application's entry point.*/
@@ -0,0 +1,200 @@
+/**
+ * @file   bench_geometry.c
+ * @brief  Host benchmark of the batched geometry, OLED_DrawPolyline, OLED_DrawPlot and OLED_DrawRects against loops of single calls
+ *
+ * @note   Build: cc -std=gnu11 -O2 -ITests/host -ICore/Inc -ICore/Src -o bench_geometry Tests/bench_geometry.c -lm
+ *         (from the SSD1306 directory)
+ *
+ *         A 128-sample trace is drawn on the screen, once inside it and once scaled so that
+ *         its peaks are clipped. 16 rectangles across the screen are drawn outlined and filled, with the point loops
+ *         of the original OLED_DrawRectangle, an OLED_DrawRectangle loop and OLED_DrawRects.
+ *         The times are per trace or rectangle list, the best of several rounds of repetitions;
+ *         they only compare the variants on the host, the ratios on the target differ.
+ */
+
+#include <math.h>
+#include <time.h>
+#include "oled_test.h"
+#include "oled.c"
+#include "oled_data.c"
+
+#define SAMPLES      128
+#define REPETITIONS  2000
+#define ROUNDS       25
+
+static int16_t Sample[SAMPLES], X[SAMPLES], Y[SAMPLES];
+
+static double now(void)
+{
+	struct timespec t;
+
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+/* The trace drawn point by point, the pixels of each segment set with OLED_DrawPoint */
+static void point_line(int16_t x0, int16_t y0, int16_t x1, int16_t y1)
+{
+	int32_t x, y, dx, dy, d, temp;
+	int yflag = 0, xyflag = 0;
+
+	if (x0 > x1) {temp = x0; x0 = x1; x1 = temp; temp = y0; y0 = y1; y1 = temp;}
+	if (y0 > y1) {y0 = -y0; y1 = -y1; yflag = 1;}
+	if (y1 - y0 > x1 - x0) {temp = x0; x0 = y0; y0 = temp; temp = x1; x1 = y1; y1 = temp; xyflag = 1;}
+
+	dx = x1 - x0;
+	dy = y1 - y0;
+	d = 2 * dy - dx;
+	for (x = x0, y = y0; x <= x1; x++)
+	{
+		if (xyflag) {OLED_DrawPoint(y, yflag ? -x : x);}
+		else {OLED_DrawPoint(x, yflag ? -y : y);}
+
+		if (d < 0) {d += 2 * dy;}
+		else {d += 2 * (dy - dx); y++;}
+	}
+}
+
+static int32_t Range;
+
+static void draw_points(void)
+{
+	int i;
+
+	for (i = 1; i < SAMPLES; i++) {point_line(X[i - 1], Y[i - 1], X[i], Y[i]);}
+}
+
+static void draw_lines(void)
+{
+	int i;
+
+	for (i = 1; i < SAMPLES; i++) {OLED_DrawLine(X[i - 1], Y[i - 1], X[i], Y[i]);}
+}
+
+static void draw_polyline(void)
+{
+	OLED_DrawPolyline(X, Y, SAMPLES);
+}
+
+static void draw_plot(void)
+{
+	OLED_DrawPlot(0, 0, 64, Sample, SAMPLES, -Range, Range);
+}
+
+/* Best time of each variant in microseconds, the variants take turns to filter out the host scheduler */
+static void bench(void (*const *draw)(void), int variants, double *best)
+{
+	double t;
+	int round, variant, n;
+
+	for (variant = 0; variant < variants; variant++) {best[variant] = 1e9;}
+	for (round = 0; round < ROUNDS; round++)
+	{
+		for (variant = 0; variant < variants; variant++)
+		{
+			t = now();
+			for (n = 0; n < REPETITIONS; n++) {draw[variant]();}
+			t = (now() - t) / REPETITIONS * 1e6;
+			if (t < best[variant]) {best[variant] = t;}
+		}
+	}
+}
+
+static void bench_trace(const char *name, int32_t range)
+{
+	static void (*const draw[4])(void) = {draw_points, draw_lines, draw_polyline, draw_plot};
+	double best[4];
+	int i;
+
+	Range = range;
+	for (i = 0; i < SAMPLES; i++)
+	{
+		X[i] = i;
+		Y[i] = 63 - (int32_t)(Sample[i] + range) * 63 / (2 * range);
+	}
+
+	bench(draw, 4, best);
+
+	printf("%s:\n", name);
+	printf("  127 x OLED_DrawPoint lines  %6.2f us\n", best[0]);
+	printf("  127 x OLED_DrawLine         %6.2f us\n", best[1]);
+	printf("  OLED_DrawPolyline           %6.2f us  (speed-up %.2fx over the OLED_DrawLine loop)\n", best[2], best[1] / best[2]);
+	printf("  OLED_DrawPlot               %6.2f us  (speed-up %.2fx over the OLED_DrawLine loop)\n", best[3], best[1] / best[3]);
+}
+
+#define RECTS  16
+
+static OLED_Rect_t Rects[RECTS];
+static uint8_t Filled;
+
+/* The original OLED_DrawRectangle, point by point */
+static void draw_point_rects(void)
+{
+	int16_t i, j, k;
+
+	for (k = 0; k < RECTS; k++)
+	{
+		const OLED_Rect_t *r = &Rects[k];
+
+		if (!Filled)
+		{
+			for (i = r->x; i < r->x + r->width; i++) {OLED_DrawPoint(i, r->y); OLED_DrawPoint(i, r->y + r->height - 1);}
+			for (i = r->y; i < r->y + r->height; i++) {OLED_DrawPoint(r->x, i); OLED_DrawPoint(r->x + r->width - 1, i);}
+		}
+		else
+		{
+			for (i = r->x; i < r->x + r->width; i++)
+			{
+				for (j = r->y; j < r->y + r->height; j++) {OLED_DrawPoint(i, j);}
+			}
+		}
+	}
+}
+
+static void draw_rectangles(void)
+{
+	int k;
+
+	for (k = 0; k < RECTS; k++) {OLED_DrawRectangle(Rects[k].x, Rects[k].y, Rects[k].width, Rects[k].height, Filled);}
+}
+
+static void draw_rects(void)
+{
+	OLED_DrawRects(Rects, RECTS, Filled);
+}
+
+static void bench_rects(const char *name, uint8_t is_filled)
+{
+	static void (*const draw[3])(void) = {draw_point_rects, draw_rectangles, draw_rects};
+	double best[3];
+
+	Filled = is_filled;
+	bench(draw, 3, best);
+
+	printf("%s:\n", name);
+	printf("  16 x point loop rectangle   %6.2f us\n", best[0]);
+	printf("  16 x OLED_DrawRectangle     %6.2f us  (speed-up %.2fx over the point loops)\n", best[1], best[0] / best[1]);
+	printf("  OLED_DrawRects              %6.2f us  (speed-up %.2fx over the OLED_DrawRectangle loop)\n", best[2], best[1] / best[2]);
+}
+
+int main(void)
+{
+	int i;
+
+	for (i = 0; i < SAMPLES; i++) {Sample[i] = (int16_t)(1000 * sin(i * 0.15) + 300 * sin(i * 1.3));}
+
+	bench_trace("trace inside the screen", 1300);
+	bench_trace("trace with clipped peaks", 900);
+
+	/* Rectangles of 8*6 to 38*21 pixels, some of them partly outside the screen */
+	for (i = 0; i < RECTS; i++)
+	{
+		Rects[i].x = (int16_t)(i * 9 - 8);
+		Rects[i].y = (int16_t)((i * 23) % 60 - 4);
+		Rects[i].width = (uint8_t)(8 + (i * 7) % 31);
+		Rects[i].height = (uint8_t)(6 + (i * 5) % 16);
+	}
+	bench_rects("16 rectangles outlined", OLED_UNFILLED);
+	bench_rects("16 rectangles filled", OLED_FILLED);
+	return 0;
+}
@@ -0,0 +1,36 @@
+/**
+ * @file   main.h
+ * @brief  Host stand-in for the CubeMX main.h, only the HAL parts used by the OLED driver
+ *
+ * @note   The host tests put this directory before Core/Inc on the include path,
+ *         the HAL functions are implemented in oled_test.h.
+ */
+
+#ifndef __MAIN_H
+#define __MAIN_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef enum
+{
+  GPIO_PIN_RESET = 0,
+  GPIO_PIN_SET
+} GPIO_PinState;
+
+typedef struct
+{
+  uint32_t ODR;
+} GPIO_TypeDef;
+
+extern GPIO_TypeDef TEST_GPIOB;
+
+#define GPIOB       (&TEST_GPIOB)
+#define GPIO_PIN_8  ((uint16_t)0x0100)
+#define GPIO_PIN_9  ((uint16_t)0x0200)
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState);
+void HAL_Delay(uint32_t Delay);
+uint32_t HAL_GetTick(void);
+
+#endif /* __MAIN_H */
@@ -0,0 +1,233 @@
+/**
+ * @file   oled_test.h
+ * @brief  Host test harness of the OLED driver: HAL stubs, an SSD1306 emulator on the I2C pins and checks
+ *
+ * @note   Header-only, every test is a single translation unit that includes this file first
+ *         and then the driver sources it tests, like #include "oled.c".
+ *
+ *         HAL_GPIO_WritePin decodes the software I2C of oled.c and applies the commands and data
+ *         to TEST_GDDRAM, the display RAM of the SSD1306, and to the segment re-map and COM scan direction.
+ *
+ *         A test that defines OLED_USE_BITBAND to 1 before including this file gets an emulation of the
+ *         Cortex-M3 bit-band region: OLED_DisplayBuf is at OLED_DISPLAYBUF_ADDR, other buffers at their
+ *         distance from it, and every alias word store or load sets or reads the bit it maps to.
+ */
+
+#ifndef __OLED_TEST_H__
+#define __OLED_TEST_H__
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "main.h"
+
+#if defined(OLED_USE_BITBAND) && OLED_USE_BITBAND
+#define OLED_BITBAND_SRAM_ADDR(ptr)     test_sram_addr(ptr)
+#define OLED_BITBAND_STORE(alias, bit)  test_bitband_store(alias, bit)
+#define OLED_BITBAND_LOAD(alias)        test_bitband_load(alias)
+static uint32_t test_sram_addr(const void *ptr);
+static void test_bitband_store(uint32_t alias, uint32_t bit);
+static uint32_t test_bitband_load(uint32_t alias);
+#endif
+
+#include "oled.h"
+
+/* Checks ----------------------------------------------------------------------*/
+
+static unsigned test_checks, test_failures;
+
+#define TEST_CHECK(cond, ...) \
+  do { \
+    test_checks++; \
+    if (!(cond)) \
+    { \
+      if (test_failures++ < 10) {printf("%s:%d: ", __FILE__, __LINE__); printf(__VA_ARGS__); printf("\n");} \
+    } \
+  } while (0)
+
+/* Print the result, returns the exit status of the test */
+static inline int test_report(const char *name)
+{
+	printf("%s: %u checks, %u failures\n", name, test_checks, test_failures);
+	return test_failures != 0;
+}
+
+/* Deterministic pseudo-random numbers, the same sequence on every host */
+static uint32_t test_seed = 1;
+
+static inline uint32_t test_rand(void)
+{
+	test_seed ^= test_seed << 13;
+	test_seed ^= test_seed >> 17;
+	test_seed ^= test_seed << 5;
+	return test_seed;
+}
+
+/* Random integer in [low,high] */
+static inline int32_t test_range(int32_t low, int32_t high)
+{
+	return low + (int32_t)(test_rand() % (uint32_t)(high - low + 1));
+}
+
+/* CRC-32 of a buffer, to compare frames with stored values */
+static inline uint32_t test_crc32(const void *data, size_t size)
+{
+	const uint8_t *p = (const uint8_t *)data;
+	uint32_t crc = 0xFFFFFFFF;
+	int k;
+
+	while (size--)
+	{
+		crc ^= *p++;
+		for (k = 0; k < 8; k++) {crc = (crc >> 1) ^ (0xEDB88320 & (0U - (crc & 1)));}
+	}
+	return ~crc;
+}
+
+/* HAL Stubs and SSD1306 Emulator ----------------------------------------------*/
+
+GPIO_TypeDef TEST_GPIOB;
+uint32_t TEST_Tick;
+
+uint8_t TEST_GDDRAM[8][128];   // Display RAM of the SSD1306, [page][column]
+uint8_t TEST_SegRemap = 0;     // 0xA1: column 127 is driven by SEG0
+uint8_t TEST_ComRemap = 0;     // 0xC8: COM scan from COM63 to COM0
+uint8_t TEST_Written[8][128];  // Set for every byte of TEST_GDDRAM written, cleared by the test
+unsigned long TEST_I2CBytes;   // Bytes sent on the I2C bus
+
+/* A byte of a transfer after the start condition: the address, the control byte, then commands or data */
+static void test_i2c_byte(uint8_t byte, unsigned index)
+{
+	static uint8_t control, page, column, arguments;
+
+	TEST_I2CBytes++;
+	if (index == 0) {return;}  // Slave address
+	if (index == 1)
+	{
+		control = byte;
+		return;
+	}
+
+	if (control == 0x40)  // Data, the column address advances in page addressing mode
+	{
+		TEST_GDDRAM[page & 7][column & 127] = byte;
+		TEST_Written[page & 7][column & 127] = 1;
+		column++;
+		return;
+	}
+
+	if (arguments > 0) {arguments--;}
+	else if (byte >= 0xB0 && byte <= 0xB7) {page = byte & 0x07;}
+	else if (byte <= 0x0F) {column = (column & 0xF0) | byte;}
+	else if (byte >= 0x10 && byte <= 0x1F) {column = (column & 0x0F) | ((byte & 0x0F) << 4);}
+	else if (byte == 0xA0 || byte == 0xA1) {TEST_SegRemap = byte & 0x01;}
+	else if (byte == 0xC0 || byte == 0xC8) {TEST_ComRemap = (byte == 0xC8);}
+	else if (byte == 0x81 || byte == 0x8D || byte == 0xA8 || byte == 0xD3 ||
+	         byte == 0xD5 || byte == 0xD9 || byte == 0xDA || byte == 0xDB || byte == 0x20) {arguments = 1;}
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState)
+{
+	static uint8_t scl = 1, sda = 1, byte;
+	static int bits = -1;
+	static unsigned index;
+	uint8_t level = (PinState != GPIO_PIN_RESET);
+
+	(void)GPIOx;
+	if (GPIO_Pin == GPIO_PIN_9)  // SDA, falling while SCL is high is a start condition
+	{
+		if (scl && sda && !level)
+		{
+			bits = 0;
+			index = 0;
+		}
+		sda = level;
+		return;
+	}
+
+	if (!scl && level && bits >= 0)  // Rising SCL, 8 data bits and the acknowledge clock
+	{
+		if (bits < 8)
+		{
+			byte = (uint8_t)((byte << 1) | sda);
+			if (++bits == 8) {test_i2c_byte(byte, index++);}
+		}
+		else
+		{
+			bits = 0;
+		}
+	}
+	scl = level;
+}
+
+void HAL_Delay(uint32_t Delay)
+{
+	TEST_Tick += Delay;
+}
+
+uint32_t HAL_GetTick(void)
+{
+	return TEST_Tick;
+}
+
+/* The panel as seen in the normal orientation (0xA1, 0xC8), 1: lit, x range: [0,127], y range: [0,63] */
+static inline uint8_t test_panel_pixel(int x, int y)
+{
+	int column = TEST_SegRemap ? x : 127 - x;
+	int row = TEST_ComRemap ? y : 63 - y;
+
+	return (TEST_GDDRAM[row / 8][column] >> (row % 8)) & 0x01;
+}
+
+/* Whether the byte of the panel pixel (x, y) was written since TEST_Written was cleared */
+static inline uint8_t test_panel_written(int x, int y)
+{
+	int column = TEST_SegRemap ? x : 127 - x;
+	int row = TEST_ComRemap ? y : 63 - y;
+
+	return TEST_Written[row / 8][column];
+}
+
+/* Bit-band Emulation ----------------------------------------------------------*/
+
+#if defined(OLED_USE_BITBAND) && OLED_USE_BITBAND
+/* The SRAM address of a host buffer, OLED_DisplayBuf is at OLED_DISPLAYBUF_ADDR */
+static uint32_t test_sram_addr(const void *ptr)
+{
+	return (uint32_t)(OLED_DISPLAYBUF_ADDR + ((const uint8_t *)ptr - (const uint8_t *)OLED_DisplayBuf));
+}
+
+/* The host byte of an alias word, buffers must be within 64 MB of OLED_DisplayBuf */
+static uint8_t *test_bitband_byte(uint32_t alias, uint8_t *bit)
+{
+	uint32_t offset = (alias - 0x22000000UL - ((OLED_DISPLAYBUF_ADDR - 0x20000000UL) << 5)) & 0xFFFFFFFFUL;
+	int32_t delta = (int32_t)((offset >> 5) & 0x07FFFFFF);
+
+	if (delta & 0x04000000) {delta -= 0x08000000;}  // Buffers before OLED_DisplayBuf
+	if ((alias & 0x03) != 0)
+	{
+		printf("bit-band: unaligned alias word 0x%08lX\n", (unsigned long)alias);
+		abort();
+	}
+	*bit = (alias >> 2) & 0x07;
+	return (uint8_t *)OLED_DisplayBuf + delta;
+}
+
+static void test_bitband_store(uint32_t alias, uint32_t bit)
+{
+	uint8_t n, *byte = test_bitband_byte(alias, &n);
+
+	if (bit & 0x01) {*byte |= 0x01 << n;}
+	else {*byte &= ~(0x01 << n);}
+}
+
+static uint32_t test_bitband_load(uint32_t alias)
+{
+	uint8_t n, *byte = test_bitband_byte(alias, &n);
+
+	return (*byte >> n) & 0x01;
+}
+#endif
+
+#endif /* __OLED_TEST_H__ */
@@ -0,0 +1,45 @@
+#!/bin/sh
+# Build and run the host tests of the OLED driver, from any directory.
+# Each test is built as listed in the Build: line of its header, CC and CFLAGS may be overridden.
+# BENCH=1 also runs the host benchmarks.
+set -e
+cd "$(dirname "$0")/.."
+
+CC=${CC:-cc}
+CFLAGS=${CFLAGS:--std=gnu11 -O2 -Wall -Wno-missing-braces}
+OUT=${OUT:-Tests/build}
+mkdir -p "$OUT"
+
+run() {
+	name=$1; shift
+	$CC $CFLAGS -ITests/host -ICore/Inc -ICore/Src "$@" -o "$OUT/$name" "Tests/$name.c" -lm
+	"$OUT/$name"
+}
+
+run test_bitband -DOLED_USE_BITBAND=0
+run test_bitband -DOLED_USE_BITBAND=1
+run test_rotation
+run test_image
+run test_transition
+run test_geometry
+run test_golden -DOLED_USE_BITBAND=0
+run test_golden -DOLED_USE_BITBAND=1
+run test_printf
+run test_fixed
+run test_layout
+run test_fill
+run test_text
+run test_text -DOLED_GLYPH_CACHE_SLOTS=1
+run test_text -DOLED_GLYPH_CACHE_SLOTS=0
+run test_scene
+run test_scene -DOLED_SCENE_MAX_ITEMS=4
+run test_sprite
+run test_sprite -DOLED_SPRITE_MAX=2
+run test_anim
+run test_rle
+run test_packed
+run test_scaled
+
+if [ -n "$BENCH" ]; then
+	run bench_geometry
+fi
@@ -0,0 +1,224 @@
+/**
+ * @file   test_anim.c
+ * @brief  Host round-trip test of the XOR-delta animations, from the Tools/oled_anim.c encoder to OLED_AnimTick
+ *
+ * @note   Build: cc -std=gnu11 -O2 -ITests/host -ICore/Inc -ICore/Src -o test_anim Tests/test_anim.c -lm
+ *         (from the SSD1306 directory)
+ *
+ *         Random frames are encoded with encode_delta of the tool, the way its main function does, and played with
+ *         OLED_AnimStart and OLED_AnimTick while the HAL tick of the emulator advances by whole frames, by less than
+ *         a frame, by several frames and by a stall longer than the animation. After every tick the screen and the
+ *         emulated panel must show the expected frame drawn with OLED_ShowImage. The frames change by boxes XORed
+ *         with one byte, so PackBits runs cross the page wraps of the box, and the animations are placed at
+ *         negative page-aligned y-coordinates, where the shift of a byte is 8, and across every edge of the screen.
+ *         A hand-made record checks that a run longer than its box stops at the end of the box.
+ */
+
+#include "oled_test.h"
+#include "oled.c"
+#include "oled_data.c"
+#include "oled_anim.c"
+
+/* The encoder of the tool, its main function is not used */
+#define main oled_anim_main
+#include "../Tools/oled_anim.c"
+#undef main
+
+#define FRAMES  12
+
+static uint8_t Frames[FRAMES][1024];
+static uint8_t Deltas[FRAMES * (4 + 1024 + 8)];
+static uint8_t XorBuf[1024], RefBuf[1024];
+
+/* The panel position of the screen pixel (x, y), the content is rotated clockwise */
+static void rotate_ref(uint8_t rotation, int x, int y, int *panel_x, int *panel_y)
+{
+	switch (rotation)
+	{
+		case OLED_ROTATION_90:  *panel_x = 127 - y; *panel_y = x;      break;
+		case OLED_ROTATION_180: *panel_x = 127 - x; *panel_y = 63 - y; break;
+		case OLED_ROTATION_270: *panel_x = y;       *panel_y = 63 - x; break;
+		default:                *panel_x = x;       *panel_y = y;      break;
+	}
+}
+
+/* Random frames, each one changes a box of the previous one */
+static void random_frames(int count, int width, int pages)
+{
+	int i, k, x, p, x0, x1, p0, p1;
+	uint8_t value;
+
+	for (k = 0; k < width * pages; k++) {Frames[0][k] = (uint8_t)(test_rand() & test_rand());}
+	for (i = 1; i < count; i++)
+	{
+		memcpy(Frames[i], Frames[i - 1], width * pages);
+		x0 = test_range(0, width - 1);
+		x1 = test_range(x0, width - 1);
+		p0 = test_range(0, pages - 1);
+		p1 = test_range(p0, pages - 1);
+		value = (uint8_t)test_rand();
+
+		switch (test_rand() % 4)
+		{
+			case 0:  // No change, an empty record
+				break;
+			case 1:  // A box XORed with one byte, a single run across the pages of the box
+				for (p = p0; p <= p1; p++) {for (x = x0; x <= x1; x++) {Frames[i][p * width + x] ^= value;}}
+				break;
+			case 2:  // Random bytes in a box
+				for (p = p0; p <= p1; p++) {for (x = x0; x <= x1; x++) {Frames[i][p * width + x] = (uint8_t)test_rand();}}
+				break;
+			default:  // A new frame
+				for (k = 0; k < width * pages; k++) {Frames[i][k] = (uint8_t)test_rand();}
+				break;
+		}
+	}
+}
+
+/* Compare the screen with the frame drawn by OLED_ShowImage, and the panel with the screen */
+static void check_frame(const OLED_Animation_t *anim, uint8_t rotation, int16_t x, int16_t y, int frame, const char *what)
+{
+	OLED_Surface_t ref;
+	int px, py, panel_x, panel_y;
+
+	OLED_SurfaceInit(&ref, RefBuf, OLED_Screen.width, OLED_Screen.height);
+	OLED_SetTarget(&ref);
+	OLED_Clear();
+	OLED_ShowImage(x, y, anim->width, anim->height, Frames[frame]);
+	OLED_SetTarget(NULL);
+	TEST_CHECK(memcmp(RefBuf, OLED_DisplayBuf, 1024) == 0, "rotation %u, %ux%u, %u frames at (%d, %d), %s: the screen is not frame %d",
+	           rotation, anim->width, anim->height, anim->frame_count, x, y, what, frame);
+
+	for (py = 0; py < OLED_Screen.height && !test_failures; py++)
+	{
+		for (px = 0; px < OLED_Screen.width && !test_failures; px++)
+		{
+			rotate_ref(rotation, px, py, &panel_x, &panel_y);
+			TEST_CHECK(test_panel_pixel(panel_x, panel_y) == OLED_GetPoint(px, py), "rotation %u, %ux%u at (%d, %d), %s: pixel (%d, %d) not sent",
+			           rotation, anim->width, anim->height, x, y, what, px, py);
+		}
+	}
+}
+
+static void test_anim(uint8_t rotation)
+{
+	OLED_AnimPlayer_t player;
+	OLED_Animation_t anim;
+	int n, step, count, width, height, pages, i, frame, due;
+	size_t size;
+	uint32_t tick, elapsed, advance;
+	int16_t x, y;
+	uint8_t changed;
+	const char *what;
+
+	OLED_SetRotation(rotation);
+	for (n = 0; n < 600 && !test_failures; n++)
+	{
+		count = test_range(2, FRAMES);
+		width = test_range(1, 128);
+		height = test_range(1, 64);
+		pages = (height + 7) / 8;
+		random_frames(count, width, pages);
+
+		/* Encode like the tool */
+		size = 0;
+		for (i = 0; i < count; i++)
+		{
+			size += encode_delta(Frames[i], Frames[(i + 1) % count], width, pages, Deltas + size, XorBuf);
+		}
+		TEST_CHECK(size <= sizeof(Deltas), "%d deltas of %dx%d need %zu bytes", count, width, height, size);
+
+		anim.width = width;
+		anim.height = height;
+		anim.frame_count = count;
+		anim.frame_time = test_range(1, 500);
+		anim.keyframe = Frames[0];
+		anim.deltas = Deltas;
+
+		x = test_range(-width - 4, OLED_Screen.width + 4);
+		y = (test_rand() % 3 == 0) ? -8 * test_range(1, pages) : test_range(-height - 4, OLED_Screen.height + 4);
+
+		/* The keyframe, with the tick close to its wrap-around */
+		OLED_Clear();
+		OLED_Update();
+		TEST_Tick = (test_rand() & 1) ? test_rand() : 0xFFFFFFFF - test_range(0, 2000);
+		OLED_AnimStart(&player, &anim, x, y);
+		frame = 0;
+		tick = TEST_Tick;
+		check_frame(&anim, rotation, x, y, frame, "start");
+
+		for (step = 0; step < 4 * count && !test_failures; step++)
+		{
+			switch (test_rand() % 8)
+			{
+				case 0:  advance = test_range(0, anim.frame_time - 1); what = "less than a frame"; break;
+				case 1:  advance = anim.frame_time * test_range(2, count) + test_range(0, anim.frame_time - 1); what = "several frames"; break;
+				case 2:  advance = anim.frame_time * (count + test_range(1, 3)) + test_range(1, anim.frame_time); what = "a stall"; break;
+				default: advance = anim.frame_time; what = "one frame"; break;
+			}
+			TEST_Tick += advance;
+
+			/* Every frame that is due, only the next one after a stall */
+			elapsed = TEST_Tick - tick;
+			due = elapsed / anim.frame_time;
+			if (elapsed > (uint32_t)anim.frame_time * count)
+			{
+				due = 1;
+				tick = TEST_Tick;
+			}
+			else
+			{
+				tick += due * anim.frame_time;
+			}
+			frame = (frame + due) % count;
+
+			changed = OLED_AnimTick(&player);
+			TEST_CHECK(changed == (due > 0), "%ux%u, %u ms, %s: OLED_AnimTick returned %u", width, height, anim.frame_time, what, changed);
+			TEST_CHECK(player.frame == frame, "%ux%u, %s: frame %u, expected %d", width, height, what, player.frame, frame);
+			check_frame(&anim, rotation, x, y, frame, what);
+		}
+
+		/* The last delta returns to the keyframe */
+		while (frame != 0 && !test_failures)
+		{
+			TEST_Tick += anim.frame_time;
+			OLED_AnimTick(&player);
+			frame = (frame + 1) % count;
+		}
+		check_frame(&anim, rotation, x, y, 0, "back at the keyframe");
+		TEST_CHECK(player.next == anim.deltas, "%ux%u, %u frames: the next record is not the first one", width, height, count);
+	}
+	OLED_SetRotation(OLED_ROTATION_0);
+}
+
+/* Hand-made records: a no-operation header, and a repeat run longer than the box that must stop at its end */
+static void test_records(void)
+{
+	static const uint8_t keyframe[3] = {0x00, 0x00, 0x00};
+	static const uint8_t deltas[] = {0, 0, 2, 1, 128, 252, 0xFF,  0, 0, 2, 1, 252, 0xFF};
+	static const OLED_Animation_t anim = {3, 8, 2, 10, keyframe, deltas};
+	OLED_AnimPlayer_t player;
+
+	OLED_Clear();
+	TEST_Tick = 0;
+	OLED_AnimStart(&player, &anim, 5, 8);
+	TEST_Tick = 10;
+	OLED_AnimTick(&player);
+	TEST_CHECK(OLED_DisplayBuf[1][5] == 0xFF && OLED_DisplayBuf[1][6] == 0xFF && OLED_DisplayBuf[1][7] == 0x00,
+	           "over-long run: %02X %02X %02X", OLED_DisplayBuf[1][5], OLED_DisplayBuf[1][6], OLED_DisplayBuf[1][7]);
+	TEST_CHECK(player.next == deltas + 7, "over-long run: the next record is at %d", (int)(player.next - deltas));
+	TEST_Tick = 20;
+	OLED_AnimTick(&player);
+	TEST_CHECK(OLED_DisplayBuf[1][5] == 0x00 && OLED_DisplayBuf[1][6] == 0x00 && OLED_DisplayBuf[1][7] == 0x00,
+	           "back at the keyframe: %02X %02X %02X", OLED_DisplayBuf[1][5], OLED_DisplayBuf[1][6], OLED_DisplayBuf[1][7]);
+}
+
+int main(void)
+{
+	OLED_Init();
+	test_records();
+	test_anim(OLED_ROTATION_0);
+	test_anim(OLED_ROTATION_90);
+
+	return test_report("test_anim");
+}
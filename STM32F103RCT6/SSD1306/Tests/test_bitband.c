@@ -0,0 +1,98 @@
+/**
+ * @file   test_bitband.c
+ * @brief  Host test of the pixel access paths, bit-band alias words against page bytes
+ *
+ * @note   Build: cc -std=gnu11 -O2 -ITests/host -ICore/Inc -ICore/Src -DOLED_USE_BITBAND=1 -o test_bitband Tests/test_bitband.c -lm
+ *                cc -std=gnu11 -O2 -ITests/host -ICore/Inc -ICore/Src -DOLED_USE_BITBAND=0 -o test_bitband Tests/test_bitband.c -lm
+ *         (from the SSD1306 directory)
+ *
+ *         Random points and cleared areas are drawn on the screen in every rotation and on off-screen surfaces,
+ *         after each call the drawing target must equal a page byte model, and OLED_GetPoint must read it back.
+ *         Both builds must pass, so both paths set the same pixels.
+ */
+
+#include "oled_test.h"
+#include "oled.c"
+#include "oled_data.c"
+
+static uint8_t SurfaceBuf1[5 * 40];   // 40*37, the last page is partly used
+static uint8_t SurfaceBuf2[4 * 100];  // 100*32
+static uint8_t Model[1024];
+
+/* Set or clear a pixel of the model of the drawing target */
+static void model_pixel(const OLED_Surface_t *surface, int x, int y, int value)
+{
+	if (x < 0 || x >= surface->width || y < 0 || y >= surface->height) {return;}
+	if (value) {Model[y / 8 * surface->width + x] |= 0x01 << (y % 8);}
+	else {Model[y / 8 * surface->width + x] &= ~(0x01 << (y % 8));}
+}
+
+static void test_surface(OLED_Surface_t *surface, const char *name)
+{
+	size_t size = OLED_SURFACE_SIZE(surface->width, surface->height);
+	int n, x, y, width, height, i, j;
+
+	OLED_SetTarget(surface);
+	memset(surface->buf, 0x00, size);
+	memset(Model, 0x00, sizeof(Model));
+
+	for (n = 0; n < 4000; n++)
+	{
+		x = test_range(-8, surface->width + 8);
+		y = test_range(-8, surface->height + 8);
+
+		if (test_range(0, 9) != 0)
+		{
+			OLED_DrawPoint(x, y);
+			model_pixel(surface, x, y, 1);
+		}
+		else
+		{
+			width = test_range(0, 24);
+			height = test_range(0, 24);
+			OLED_ClearArea(x, y, width, height);
+			for (j = y; j < y + height; j++)
+			{
+				for (i = x; i < x + width; i++) {model_pixel(surface, i, j, 0);}
+			}
+		}
+
+		TEST_CHECK(memcmp(surface->buf, Model, size) == 0, "%s: target differs after call %d", name, n);
+		if (test_failures) {break;}
+
+		x = test_range(-8, surface->width + 8);
+		y = test_range(-8, surface->height + 8);
+		i = (x >= 0 && x < surface->width && y >= 0 && y < surface->height) ? (Model[y / 8 * surface->width + x] >> (y % 8)) & 0x01 : 0;
+		TEST_CHECK(OLED_GetPoint(x, y) == i, "%s: OLED_GetPoint(%d, %d) != %d", name, x, y, i);
+	}
+	OLED_SetTarget(NULL);
+}
+
+int main(void)
+{
+	OLED_Surface_t surface1, surface2;
+	uint8_t rotation;
+	char name[32];
+
+	OLED_Init();
+
+	for (rotation = OLED_ROTATION_0; rotation <= OLED_ROTATION_270; rotation++)
+	{
+		OLED_SetRotation(rotation);
+		snprintf(name, sizeof(name), "screen rotation %u", rotation);
+		test_surface(&OLED_Screen, name);
+	}
+	OLED_SetRotation(OLED_ROTATION_0);
+
+	OLED_SurfaceInit(&surface1, SurfaceBuf1, 40, 37);
+	OLED_SurfaceInit(&surface2, SurfaceBuf2, 100, 32);
+	test_surface(&surface1, "surface 40*37");
+	test_surface(&surface2, "surface 100*32");
+
+	/* The screen must still be drawn at its own address after the surfaces */
+	OLED_Clear();
+	OLED_DrawPoint(127, 63);
+	TEST_CHECK(OLED_DisplayBuf[7][127] == 0x80, "screen pixel after OLED_SetTarget(NULL)");
+
+	return test_report(OLED_USE_BITBAND ? "test_bitband (bit-band)" : "test_bitband (page bytes)");
+}
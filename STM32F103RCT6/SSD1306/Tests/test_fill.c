@@ -0,0 +1,182 @@
+/**
+ * @file   test_fill.c
+ * @brief  Host test of OLED_FloodFill against a per-pixel 4-connected fill
+ *
+ * @note   Build: cc -std=gnu11 -O2 -ITests/host -ICore/Inc -ICore/Src -o test_fill Tests/test_fill.c -lm
+ *         (from the SSD1306 directory)
+ *
+ *         Random masks of lit pixels, noise and outlines, are filled from a random point on the screen,
+ *         on a surface whose height is not a multiple of 8 and on the screen rotated by 90 degrees.
+ *         With a large stack the result must equal the reference fill at once. With a stack of 1 or 2 seeds,
+ *         every call may only set pixels of the reference area, a call that drops no seed must complete it,
+ *         and calling OLED_FloodFill again at pixels of the area that are still unlit must complete it.
+ */
+
+#include "oled_test.h"
+#include "oled.c"
+#include "oled_data.c"
+
+static uint8_t SurfaceBuf[3 * 50];  // 50*21
+static uint8_t Model[1024];
+static int16_t QueueX[128 * 64], QueueY[128 * 64];
+static OLED_FillSeed_t Stack[128 * 64];  // One seed per pixel
+
+static uint8_t get_pixel(const uint8_t *buf, const OLED_Surface_t *surface, int x, int y)
+{
+	return (buf[y / 8 * surface->width + x] >> (y % 8)) & 0x01;
+}
+
+static void set_pixel(uint8_t *buf, const OLED_Surface_t *surface, int x, int y)
+{
+	buf[y / 8 * surface->width + x] |= 0x01 << (y % 8);
+}
+
+/* Breadth-first fill of the model, one pixel at a time */
+static void ref_fill(const OLED_Surface_t *surface, int x, int y)
+{
+	static const int dx[4] = {1, -1, 0, 0}, dy[4] = {0, 0, 1, -1};
+	int head = 0, tail = 0, k, nx, ny;
+
+	if (x < 0 || x >= surface->width || y < 0 || y >= surface->height || get_pixel(Model, surface, x, y)) {return;}
+	set_pixel(Model, surface, x, y);
+	QueueX[tail] = x;
+	QueueY[tail++] = y;
+	while (head < tail)
+	{
+		x = QueueX[head];
+		y = QueueY[head++];
+		for (k = 0; k < 4; k++)
+		{
+			nx = x + dx[k];
+			ny = y + dy[k];
+			if (nx < 0 || nx >= surface->width || ny < 0 || ny >= surface->height || get_pixel(Model, surface, nx, ny)) {continue;}
+			set_pixel(Model, surface, nx, ny);
+			QueueX[tail] = nx;
+			QueueY[tail++] = ny;
+		}
+	}
+}
+
+/* Random noise with rectangle and circle outlines, the padding rows of the last page are random as well */
+static void random_mask(OLED_Surface_t *surface, size_t size)
+{
+	int i, density = test_range(0, 6);
+
+	for (i = 0; i < (int)size; i++)
+	{
+		surface->buf[i] = (uint8_t)(test_rand() & test_rand() & test_rand());
+		if (density < 3) {surface->buf[i] &= (uint8_t)test_rand();}
+		if (density == 0) {surface->buf[i] = 0x00;}
+	}
+	for (i = test_range(0, 6); i > 0; i--)
+	{
+		if (test_rand() & 1)
+		{
+			OLED_DrawRectangle(test_range(-10, surface->width), test_range(-10, surface->height),
+			                   test_range(1, surface->width), test_range(1, surface->height), OLED_UNFILLED);
+		}
+		else
+		{
+			OLED_DrawCircle(test_range(0, surface->width), test_range(0, surface->height), test_range(1, 40), OLED_UNFILLED);
+		}
+	}
+}
+
+/* The pixels that are lit in buf must be lit in the model, inside the target */
+static int subset_of_model(const OLED_Surface_t *surface)
+{
+	int x, y;
+
+	for (y = 0; y < surface->height; y++)
+	{
+		for (x = 0; x < surface->width; x++)
+		{
+			if (get_pixel(surface->buf, surface, x, y) && !get_pixel(Model, surface, x, y)) {return 0;}
+		}
+	}
+	return 1;
+}
+
+/* Compare the pixels inside the target, the padding rows of the last page are not part of it */
+static int equal_to_model(const OLED_Surface_t *surface)
+{
+	int x, y;
+
+	for (y = 0; y < surface->height; y++)
+	{
+		for (x = 0; x < surface->width; x++)
+		{
+			if (get_pixel(surface->buf, surface, x, y) != get_pixel(Model, surface, x, y)) {return 0;}
+		}
+	}
+	return 1;
+}
+
+static void test_fill(OLED_Surface_t *surface, const char *name)
+{
+	OLED_FillSeed_t *stack = Stack;
+	size_t size = OLED_SURFACE_SIZE(surface->width, surface->height);
+	int n, x, y, calls, sx, sy, found;
+	uint16_t capacity, dropped;
+
+	OLED_SetTarget(surface);
+	for (n = 0; n < 1200 && !test_failures; n++)
+	{
+		random_mask(surface, size);
+		memcpy(Model, surface->buf, size);
+		x = test_range(-2, surface->width + 1);
+		y = test_range(-2, surface->height + 1);
+		ref_fill(surface, x, y);
+
+		if (n % 3 != 0)  // Enough seeds
+		{
+			dropped = OLED_FloodFill(x, y, stack, 128 * 64);
+			TEST_CHECK(dropped == 0, "%s: %u seeds dropped with a stack of one seed per pixel", name, dropped);
+			TEST_CHECK(equal_to_model(surface), "%s: fill from (%d, %d)", name, x, y);
+			continue;
+		}
+
+		/* A tiny stack, filled in several calls */
+		capacity = test_range(1, 2);
+		dropped = OLED_FloodFill(x, y, stack, capacity);
+		if (dropped == 0) {TEST_CHECK(equal_to_model(surface), "%s: stack of %u, nothing dropped from (%d, %d)", name, capacity, x, y);}
+		for (calls = 1; calls < 2000 && !test_failures; calls++)
+		{
+			TEST_CHECK(subset_of_model(surface), "%s: stack of %u, call %d from (%d, %d) filled outside the area",
+			           name, capacity, calls, x, y);
+
+			/* Continue at an unlit pixel of the area, until there is none */
+			found = 0;
+			for (sy = 0; sy < surface->height && !found; sy++)
+			{
+				for (sx = 0; sx < surface->width && !found; sx++)
+				{
+					found = get_pixel(Model, surface, sx, sy) && !get_pixel(surface->buf, surface, sx, sy);
+				}
+			}
+			if (!found) {break;}
+			OLED_FloodFill(sx - 1, sy - 1, stack, capacity);
+		}
+		TEST_CHECK(calls < 2000, "%s: stack of %u, not complete after %d calls", name, capacity, calls);
+		TEST_CHECK(equal_to_model(surface), "%s: stack of %u, %d calls from (%d, %d)", name, capacity, calls, x, y);
+	}
+
+	/* An empty stack fills nothing */
+	memset(surface->buf, 0x00, size);
+	TEST_CHECK(OLED_FloodFill(0, 0, stack, 0) == 0 && surface->buf[0] == 0x00, "%s: stack of 0", name);
+	OLED_SetTarget(NULL);
+}
+
+int main(void)
+{
+	OLED_Surface_t surface;
+
+	OLED_SurfaceInit(&surface, SurfaceBuf, 50, 21);
+	test_fill(&OLED_Screen, "screen");
+	test_fill(&surface, "surface 50*21");
+	OLED_SetRotation(OLED_ROTATION_90);
+	test_fill(&OLED_Screen, "screen rotated by 90 degrees");
+	OLED_SetRotation(OLED_ROTATION_0);
+
+	return test_report("test_fill");
+}
@@ -0,0 +1,142 @@
+/**
+ * @file   test_fixed.c
+ * @brief  Host test of OLED_ShowFixed against the C library printf of the exact value
+ *
+ * @note   Build: cc -std=gnu11 -O2 -ITests/host -ICore/Inc -ICore/Src -o test_fixed Tests/test_fixed.c -lm
+ *         (from the SSD1306 directory)
+ *
+ *         Random numbers with decimal and Q format points, in and out of range, are shown with OLED_ShowFixed and
+ *         compared with the text that snprintf("%.*Lf") gives for number / 10^scale or number / 2^q, signed,
+ *         with the integer part padded or cut to int_length digits. The long double holds the exact value or is
+ *         close enough to round like it; at an exact half it is nudged away from zero, the rounding the driver
+ *         documents, where printf rounds to even or by the binary value. Lengths of 255 give the longest text,
+ *         a sign, 32 integer digits, the point and 9 fractional digits, which must fit the buffer of the driver.
+ */
+
+#include "oled_test.h"
+#include "oled.c"
+#include "oled_data.c"
+
+static uint8_t ExpectedBuf[2 * 360], ActualBuf[2 * 360];  // 45 characters of OLED_8X16
+static OLED_Surface_t Expected, Actual;
+
+/* The text OLED_ShowFixed should show, from printf of the exact value */
+static void ref_text(char *text, int32_t number, uint8_t point, uint8_t int_length, uint8_t fra_length)
+{
+	uint64_t magnitude = (number < 0) ? (uint64_t)(-(int64_t)number) : (uint64_t)number;
+	uint64_t pow_num, product, half;
+	uint8_t scale = point & 0x3F;
+	long double value;
+	char digits[64], *dot;
+	int tie, n, i;
+
+	if (fra_length > 9) {fra_length = 9;}
+	if (int_length > 32) {int_length = 32;}
+	for (pow_num = 1, i = 0; i < fra_length; i++) {pow_num *= 10;}
+
+	if (point & OLED_FIXED_Q(0))
+	{
+		if (scale > 31) {scale = 31;}
+		value = ldexpl((long double)magnitude, -scale);  // Exact
+		product = (magnitude & (((uint64_t)1 << scale) - 1)) * pow_num * 2;  // Less than 2^62
+		tie = (product % ((uint64_t)1 << scale) == 0) && ((product >> scale) & 1);
+	}
+	else
+	{
+		if (scale > 9) {scale = 9;}
+		for (half = 1, i = 0; i < scale; i++) {half *= 10;}
+		value = (long double)magnitude / half;  // Within 2^-64 relative, far closer than the decimal digits
+		half = half / pow_num / 2;
+		tie = (scale > fra_length) && (magnitude % (half * 2) == half);
+	}
+	if (tie) {value = nextafterl(value, INFINITY);}
+	snprintf(digits, sizeof(digits), "%.*Lf", fra_length, value);
+
+	dot = strchr(digits, '.');
+	n = (dot != NULL) ? (int)(dot - digits) : (int)strlen(digits);
+	text[0] = (number < 0) ? '-' : '+';
+	for (i = 0; i < int_length; i++)  // The lowest int_length digits, padded with zeros
+	{
+		text[1 + i] = (n - int_length + i >= 0) ? digits[n - int_length + i] : '0';
+	}
+	sprintf(text + 1 + int_length, ".%s", (dot != NULL) ? dot + 1 : "");
+}
+
+/* Show the number and compare it with the reference text, x and y cover a 360*16 surface */
+static void check_fixed(int32_t number, uint8_t point, uint8_t int_length, uint8_t fra_length, uint8_t font_size)
+{
+	char text[64];
+
+	ref_text(text, number, point, int_length, fra_length);
+	memset(ExpectedBuf, 0x00, sizeof(ExpectedBuf));
+	memset(ActualBuf, 0x00, sizeof(ActualBuf));
+	OLED_SetTarget(&Expected);
+	OLED_ShowString(0, 0, text, font_size);
+	OLED_SetTarget(&Actual);
+	OLED_ShowFixed(0, 0, number, point, int_length, fra_length, font_size);
+	OLED_SetTarget(NULL);
+	TEST_CHECK(memcmp(ExpectedBuf, ActualBuf, sizeof(ActualBuf)) == 0, "OLED_ShowFixed(%ld, %s(%u), %u, %u) should show \"%s\"",
+	           (long)number, (point & OLED_FIXED_Q(0)) ? "OLED_FIXED_Q" : "OLED_FIXED_DEC", point & 0x3F, int_length, fra_length, text);
+}
+
+/* The examples of the documentation, halves, the extremes and the longest text */
+static void test_cases(void)
+{
+	char text[64];
+
+	ref_text(text, 12345, OLED_FIXED_DEC(2), 3, 2);
+	TEST_CHECK(strcmp(text, "+123.45") == 0, "12345 at OLED_FIXED_DEC(2): \"%s\"", text);
+	ref_text(text, 64015, OLED_FIXED_DEC(2), 3, 1);
+	TEST_CHECK(strcmp(text, "+640.2") == 0, "64015 at OLED_FIXED_DEC(2): \"%s\"", text);
+	ref_text(text, -5, OLED_FIXED_Q(3), 1, 2);
+	TEST_CHECK(strcmp(text, "-0.63") == 0, "-5 at OLED_FIXED_Q(3): \"%s\"", text);
+
+	check_fixed(12345, OLED_FIXED_DEC(2), 3, 2, OLED_6X8);
+	check_fixed(64015, OLED_FIXED_DEC(2), 3, 1, OLED_6X8);
+	check_fixed(-64015, OLED_FIXED_DEC(2), 3, 1, OLED_8X16);
+	check_fixed(1, OLED_FIXED_Q(1), 1, 0, OLED_6X8);    // 0.5 rounds to 1
+	check_fixed(-3, OLED_FIXED_Q(3), 1, 2, OLED_6X8);   // -0.375
+	check_fixed(-1, OLED_FIXED_DEC(3), 2, 2, OLED_6X8);  // -0.001 keeps its sign
+	check_fixed(INT32_MIN, OLED_FIXED_Q(31), 2, 9, OLED_6X8);
+	check_fixed(INT32_MAX, OLED_FIXED_Q(31), 1, 9, OLED_6X8);
+	check_fixed(INT32_MAX, OLED_FIXED_DEC(9), 1, 9, OLED_6X8);
+	check_fixed(999999999, OLED_FIXED_DEC(9), 1, 3, OLED_6X8);  // Carries into the integer part
+	check_fixed(INT32_MIN, OLED_FIXED_DEC(0), 255, 255, OLED_8X16);
+	check_fixed(INT32_MIN, OLED_FIXED_Q(31), 255, 255, OLED_8X16);
+	check_fixed(-7, OLED_FIXED_Q(63), 255, 255, OLED_6X8);  // q is limited to 31
+	check_fixed(-7, OLED_FIXED_DEC(63), 255, 255, OLED_6X8);  // scale is limited to 9
+}
+
+static void test_random(void)
+{
+	int32_t number;
+	uint8_t point, int_length, fra_length;
+	int n;
+
+	for (n = 0; n < 200000 && !test_failures; n++)
+	{
+		switch (test_rand() % 4)
+		{
+			case 0:  number = (int32_t)test_rand(); break;
+			case 1:  number = test_range(-1000, 1000); break;
+			case 2:  number = test_range(-100000000, 100000000); break;
+			default: number = (int32_t)(test_rand() >> test_range(0, 31)) * ((test_rand() & 1) ? 1 : -1); break;
+		}
+		if (n % 16 == 0) {point = (test_rand() & 0x80) | test_range(0, 63);}  // Out of range too
+		else {point = (test_rand() & 1) ? OLED_FIXED_Q(test_range(0, 31)) : OLED_FIXED_DEC(test_range(0, 9));}
+		int_length = (n % 32 == 0) ? 255 : test_range(0, 12);
+		fra_length = (n % 32 == 16) ? 255 : test_range(0, 10);
+
+		check_fixed(number, point, int_length, fra_length, (test_rand() & 1) ? OLED_8X16 : OLED_6X8);
+	}
+}
+
+int main(void)
+{
+	OLED_SurfaceInit(&Expected, ExpectedBuf, 360, 16);
+	OLED_SurfaceInit(&Actual, ActualBuf, 360, 16);
+	test_cases();
+	test_random();
+
+	return test_report("test_fixed");
+}
@@ -0,0 +1,369 @@
+/**
+ * @file   test_geometry.c
+ * @brief  Host test of the line rasteriser and the batched geometry against per-pixel references
+ *
+ * @note   Build: cc -std=gnu11 -O2 -ITests/host -ICore/Inc -ICore/Src -o test_geometry Tests/test_geometry.c -lm
+ *         (from the SSD1306 directory)
+ *
+ *         The reference walks every point of the line like the original OLED_DrawLine did and sets the ones
+ *         inside the drawing target, so the clipping must not move any pixel. Lines and polylines are drawn
+ *         inside, across and far outside the screen and an off-screen surface, and from end to end of the coordinate range.
+ *         OLED_DrawPlot must equal the reference polyline through its scaled samples, OLED_DrawPoints the single
+ *         points, and OLED_DrawRectangle and OLED_DrawRects the point loops of the original OLED_DrawRectangle.
+ *         The Bezier curves must equal the reference polyline through their points, computed from the Bernstein
+ *         polynomials at the documented number of steps, at most 128, and always reach both end points;
+ *         control points at the far ends of the coordinate range must not overflow the forward differences.
+ *         A straight control polygon must draw the same pixels as OLED_DrawLine.
+ */
+
+#include "oled_test.h"
+#include "oled.c"
+#include "oled_data.c"
+
+static uint8_t SurfaceBuf[3 * 50];  // 50*20
+static uint8_t Model[1024];
+
+static void model_pixel(const OLED_Surface_t *surface, int32_t x, int32_t y)
+{
+	if (x < 0 || x >= surface->width || y < 0 || y >= surface->height) {return;}
+	Model[y / 8 * surface->width + x] |= 0x01 << (y % 8);
+}
+
+/* Bresenham's algorithm in the 0~45 degrees range of the first quadrant, point by point */
+static void ref_line(const OLED_Surface_t *surface, int32_t x0, int32_t y0, int32_t x1, int32_t y1)
+{
+	int32_t x, y, dx, dy, d, temp;
+	int yflag = 0, xyflag = 0;
+
+	if (x0 > x1) {temp = x0; x0 = x1; x1 = temp; temp = y0; y0 = y1; y1 = temp;}
+	if (y0 > y1) {y0 = -y0; y1 = -y1; yflag = 1;}
+	if (y1 - y0 > x1 - x0) {temp = x0; x0 = y0; y0 = temp; temp = x1; x1 = y1; y1 = temp; xyflag = 1;}
+
+	dx = x1 - x0;
+	dy = y1 - y0;
+	d = 2 * dy - dx;
+	for (x = x0, y = y0; x <= x1; x++)
+	{
+		if (xyflag) {model_pixel(surface, y, yflag ? -x : x);}
+		else {model_pixel(surface, x, yflag ? -y : y);}
+
+		if (d < 0) {d += 2 * dy;}
+		else {d += 2 * (dy - dx); y++;}
+	}
+}
+
+/* A random coordinate, mostly near the drawing target and sometimes far outside */
+static int16_t random_coordinate(int16_t size)
+{
+	switch (test_rand() % 8)
+	{
+		case 0:  return (int16_t)test_range(-32768, 32767);
+		case 1:  return (int16_t)test_range(-1000, 1000);
+		default: return (int16_t)test_range(-size / 2, size + size / 2);
+	}
+}
+
+static void test_lines(OLED_Surface_t *surface, const char *name)
+{
+	size_t size = OLED_SURFACE_SIZE(surface->width, surface->height);
+	int16_t x[16], y[16];
+	int n, i, count;
+
+	OLED_SetTarget(surface);
+	for (n = 0; n < 20000 && !test_failures; n++)
+	{
+		x[0] = random_coordinate(surface->width);
+		y[0] = random_coordinate(surface->height);
+		x[1] = (n % 5 == 0) ? x[0] : random_coordinate(surface->width);
+		y[1] = (n % 7 == 0) ? y[0] : random_coordinate(surface->height);
+		if (n % 16 == 1)  // From end to end of the coordinate range, across the drawing target
+		{
+			x[0] = (n & 32) ? -32768 : (int16_t)test_range(-surface->width, 2 * surface->width);
+			x[1] = (n & 32) ? 32767 : (int16_t)test_range(-surface->width, 2 * surface->width);
+			y[0] = (n & 32) ? (int16_t)test_range(-surface->height, 2 * surface->height) : -32768;
+			y[1] = (n & 32) ? (int16_t)test_range(-surface->height, 2 * surface->height) : 32767;
+		}
+
+		memset(surface->buf, 0x00, size);
+		memset(Model, 0x00, sizeof(Model));
+		OLED_DrawLine(x[0], y[0], x[1], y[1]);
+		ref_line(surface, x[0], y[0], x[1], y[1]);
+		TEST_CHECK(memcmp(surface->buf, Model, size) == 0, "%s: OLED_DrawLine(%d, %d, %d, %d)", name, x[0], y[0], x[1], y[1]);
+	}
+
+	for (n = 0; n < 5000 && !test_failures; n++)
+	{
+		count = test_range(0, 16);
+		for (i = 0; i < count; i++)
+		{
+			x[i] = (n & 1) ? (int16_t)test_range(0, surface->width - 1) : random_coordinate(surface->width);
+			y[i] = (n & 1) ? (int16_t)test_range(0, surface->height - 1) : random_coordinate(surface->height);
+		}
+
+		memset(surface->buf, 0x00, size);
+		memset(Model, 0x00, sizeof(Model));
+		OLED_DrawPolyline(x, y, count);
+		if (count == 1) {model_pixel(surface, x[0], y[0]);}
+		for (i = 1; i < count; i++) {ref_line(surface, x[i - 1], y[i - 1], x[i], y[i]);}
+		TEST_CHECK(memcmp(surface->buf, Model, size) == 0, "%s: OLED_DrawPolyline of %d points from (%d, %d)", name, count, x[0], y[0]);
+	}
+	OLED_SetTarget(NULL);
+}
+
+static void test_points(OLED_Surface_t *surface, const char *name)
+{
+	size_t size = OLED_SURFACE_SIZE(surface->width, surface->height);
+	int16_t x[64], y[64];
+	int n, i, count;
+
+	OLED_SetTarget(surface);
+	for (n = 0; n < 2000 && !test_failures; n++)
+	{
+		count = test_range(0, 64);
+		memset(surface->buf, 0x00, size);
+		memset(Model, 0x00, sizeof(Model));
+		for (i = 0; i < count; i++)
+		{
+			x[i] = random_coordinate(surface->width);
+			y[i] = random_coordinate(surface->height);
+			model_pixel(surface, x[i], y[i]);
+		}
+		OLED_DrawPoints(x, y, count);
+		TEST_CHECK(memcmp(surface->buf, Model, size) == 0, "%s: OLED_DrawPoints of %d points", name, count);
+	}
+	OLED_SetTarget(NULL);
+}
+
+static void test_plot(OLED_Surface_t *surface, const char *name)
+{
+	size_t size = OLED_SURFACE_SIZE(surface->width, surface->height);
+	int16_t samples[255], row[255], x, y, min, max;
+	int32_t value;
+	int n, i, count, height;
+
+	OLED_SetTarget(surface);
+	for (n = 0; n < 5000 && !test_failures; n++)
+	{
+		count = (n % 10 == 0) ? test_range(0, 2) : test_range(3, 255);
+		height = test_range(1, 64);
+		x = (int16_t)test_range(-count - 4, surface->width + 4);
+		y = (int16_t)test_range(-height - 4, surface->height + 4);
+		min = (int16_t)test_range(-2000, 2000);
+		max = (n % 13 == 0) ? min - test_range(0, 10) : (int16_t)test_range(min, 4000);  // Also an empty range
+		for (i = 0; i < count; i++)
+		{
+			/* A random walk with jumps, partly beyond min and max so that it is clamped */
+			value = (i == 0 || test_rand() % 8 == 0) ? test_range(min - 200, max + 200) : samples[i - 1] + test_range(-300, 300);
+			samples[i] = (int16_t)((value < -32768) ? -32768 : (value > 32767) ? 32767 : value);
+		}
+
+		/* The samples scaled to rows the way the function documents it */
+		memset(Model, 0x00, sizeof(Model));
+		for (i = 0; i < count; i++)
+		{
+			value = samples[i];
+			if (value < min) {value = min;}
+			if (value > max) {value = max;}
+			row[i] = y + height - 1;
+			if (max > min) {row[i] -= (value - min) * (height - 1) / ((int32_t)max - min);}
+			if (i == 0) {model_pixel(surface, x, row[0]);}
+			else {ref_line(surface, x + i - 1, row[i - 1], x + i, row[i]);}
+		}
+
+		memset(surface->buf, 0x00, size);
+		OLED_DrawPlot(x, y, height, samples, count, min, max);
+		TEST_CHECK(memcmp(surface->buf, Model, size) == 0, "%s: OLED_DrawPlot of %d samples at (%d, %d), height %d, range [%d,%d]",
+		           name, count, x, y, height, min, max);
+	}
+	OLED_SetTarget(NULL);
+}
+
+/* The original OLED_DrawRectangle, point by point */
+static void ref_rectangle(const OLED_Surface_t *surface, int32_t x, int32_t y, int32_t width, int32_t height, uint8_t is_filled)
+{
+	int32_t i, j;
+
+	if (!is_filled)
+	{
+		for (i = x; i < x + width; i++)
+		{
+			model_pixel(surface, i, y);
+			model_pixel(surface, i, y + height - 1);
+		}
+		for (i = y; i < y + height; i++)
+		{
+			model_pixel(surface, x, i);
+			model_pixel(surface, x + width - 1, i);
+		}
+	}
+	else
+	{
+		for (i = x; i < x + width; i++)
+		{
+			for (j = y; j < y + height; j++) {model_pixel(surface, i, j);}
+		}
+	}
+}
+
+static void test_rects(OLED_Surface_t *surface, const char *name)
+{
+	size_t size = OLED_SURFACE_SIZE(surface->width, surface->height);
+	OLED_Rect_t rects[8];
+	int n, i, count;
+	uint8_t is_filled;
+
+	OLED_SetTarget(surface);
+	for (n = 0; n < 10000 && !test_failures; n++)
+	{
+		count = (n & 1) ? 1 : test_range(0, 8);
+		is_filled = (test_rand() & 1) ? OLED_FILLED : OLED_UNFILLED;
+		memset(Model, 0x00, sizeof(Model));
+		for (i = 0; i < count; i++)
+		{
+			rects[i].width = (test_rand() % 4 == 0) ? test_range(0, 2) : test_range(0, 255);
+			rects[i].height = (test_rand() % 4 == 0) ? test_range(0, 2) : test_range(0, 255);
+			rects[i].x = (test_rand() % 8 == 0) ? (int16_t)test_range(-32768, 32767 - 256) : (int16_t)test_range(-rects[i].width - 4, surface->width + 4);
+			rects[i].y = (test_rand() % 8 == 0) ? (int16_t)test_range(-32768, 32767 - 256) : (int16_t)test_range(-rects[i].height - 4, surface->height + 4);
+			ref_rectangle(surface, rects[i].x, rects[i].y, rects[i].width, rects[i].height, is_filled);
+		}
+
+		memset(surface->buf, 0x00, size);
+		if (n & 1) {OLED_DrawRectangle(rects[0].x, rects[0].y, rects[0].width, rects[0].height, is_filled);}
+		else {OLED_DrawRects(rects, count, is_filled);}
+		TEST_CHECK(memcmp(surface->buf, Model, size) == 0, "%s: %s of %d rectangles from (%d, %d) %d*%d, filled %d", name,
+		           (n & 1) ? "OLED_DrawRectangle" : "OLED_DrawRects", count, rects[0].x, rects[0].y, rects[0].width, rects[0].height, is_filled);
+	}
+	OLED_SetTarget(NULL);
+}
+
+/* Whether the control points lie on the line between the end points */
+static int ref_straight(const int32_t *x, const int32_t *y, int count)
+{
+	int32_t dx = x[count - 1] - x[0], dy = y[count - 1] - y[0];
+	int i;
+
+	for (i = 1; i < count - 1; i++)
+	{
+		if ((int64_t)(x[i] - x[0]) * dy != (int64_t)(y[i] - y[0]) * dx) {return 0;}
+		if (x[i] < (x[0] < x[count - 1] ? x[0] : x[count - 1]) || x[i] > (x[0] > x[count - 1] ? x[0] : x[count - 1])) {return 0;}
+		if (y[i] < (y[0] < y[count - 1] ? y[0] : y[count - 1]) || y[i] > (y[0] > y[count - 1] ? y[0] : y[count - 1])) {return 0;}
+	}
+	return 1;
+}
+
+/* The Bezier curve through its points P(i / n), with n = 2^shift halving the control polygon length down to 4 */
+static void ref_bezier(const OLED_Surface_t *surface, const int32_t *x, const int32_t *y, int count)
+{
+	static const int64_t binomial[4][4] = {{1}, {1, 1}, {1, 2, 1}, {1, 3, 3, 1}};
+	int64_t n, px, py, weight, half;
+	int32_t length = 0, last_x = 0, last_y = 0, next_x, next_y;
+	int i, k, shift = 0, order = count - 1;
+
+	if (ref_straight(x, y, count))
+	{
+		ref_line(surface, x[0], y[0], x[order], y[order]);
+		return;
+	}
+
+	for (i = 1; i < count; i++) {length += (abs(x[i] - x[i - 1]) > abs(y[i] - y[i - 1])) ? abs(x[i] - x[i - 1]) : abs(y[i] - y[i - 1]);}
+	while (shift < 7 && (length >> shift) > 4) {shift++;}
+	n = (int64_t)1 << shift;
+	half = (order * shift > 0) ? (int64_t)1 << (order * shift - 1) : 0;
+
+	for (i = 0; i <= n; i++)
+	{
+		px = py = 0;
+		for (k = 0; k <= order; k++)
+		{
+			weight = binomial[order][k];
+			for (int j = 0; j < order - k; j++) {weight *= n - i;}
+			for (int j = 0; j < k; j++) {weight *= i;}
+			px += weight * x[k];
+			py += weight * y[k];
+		}
+		next_x = (int32_t)((px + half) >> (order * shift));
+		next_y = (int32_t)((py + half) >> (order * shift));
+		if (i > 0) {ref_line(surface, last_x, last_y, next_x, next_y);}
+		last_x = next_x;
+		last_y = next_y;
+	}
+}
+
+static uint8_t target_pixel(const OLED_Surface_t *surface, int32_t x, int32_t y)
+{
+	if (x < 0 || x >= surface->width || y < 0 || y >= surface->height) {return 1;}  // Not visible, nothing to check
+	return (surface->buf[y / 8 * surface->width + x] >> (y % 8)) & 0x01;
+}
+
+static void test_bezier(OLED_Surface_t *surface, const char *name)
+{
+	size_t size = OLED_SURFACE_SIZE(surface->width, surface->height);
+	int32_t x[4] = {0}, y[4] = {0}, dx, dy, steps;
+	int n, i, count;
+
+	OLED_SetTarget(surface);
+	for (n = 0; n < 20000 && !test_failures; n++)
+	{
+		count = (n & 1) ? 4 : 3;
+		for (i = 0; i < count; i++)
+		{
+			/* End points mostly near the target, control points anywhere, sometimes at the ends of the range */
+			if (n % 10 == 0 && i > 0 && i < count - 1) {x[i] = (test_rand() & 1) ? -32768 : 32767; y[i] = (test_rand() & 1) ? -32768 : 32767;}
+			else if (i == 0 || i == count - 1) {x[i] = test_range(-20, surface->width + 20); y[i] = test_range(-20, surface->height + 20);}
+			else {x[i] = random_coordinate(surface->width); y[i] = random_coordinate(surface->height);}
+		}
+		if (n % 7 == 0)  // A straight control polygon, the control points in order between the end points
+		{
+			dx = x[count - 1] - x[0];
+			dy = y[count - 1] - y[0];
+			steps = test_range(0, 6);
+			x[count - 1] = x[0] + dx / 6 * 6;
+			y[count - 1] = y[0] + dy / 6 * 6;
+			for (i = 1; i < count - 1; i++)
+			{
+				steps = test_range(steps, 6);
+				x[i] = x[0] + dx / 6 * steps;
+				y[i] = y[0] + dy / 6 * steps;
+			}
+		}
+
+		memset(surface->buf, 0x00, size);
+		memset(Model, 0x00, sizeof(Model));
+		if (count == 3) {OLED_DrawQuadBezier(x[0], y[0], x[1], y[1], x[2], y[2]);}
+		else {OLED_DrawCubicBezier(x[0], y[0], x[1], y[1], x[2], y[2], x[3], y[3]);}
+		ref_bezier(surface, x, y, count);
+		TEST_CHECK(memcmp(surface->buf, Model, size) == 0, "%s: %s Bezier (%d, %d) (%d, %d) (%d, %d) (%d, %d)", name,
+		           (count == 3) ? "quadratic" : "cubic", x[0], y[0], x[1], y[1], x[2], y[2], x[3], y[3]);
+		TEST_CHECK(target_pixel(surface, x[0], y[0]) && target_pixel(surface, x[count - 1], y[count - 1]),
+		           "%s: Bezier end point (%d, %d) or (%d, %d) not set", name, x[0], y[0], x[count - 1], y[count - 1]);
+
+		if (ref_straight(x, y, count))
+		{
+			memcpy(Model, surface->buf, size);
+			memset(surface->buf, 0x00, size);
+			OLED_DrawLine(x[0], y[0], x[count - 1], y[count - 1]);
+			TEST_CHECK(memcmp(surface->buf, Model, size) == 0, "%s: straight Bezier from (%d, %d) to (%d, %d) is not OLED_DrawLine",
+			           name, x[0], y[0], x[count - 1], y[count - 1]);
+		}
+	}
+	OLED_SetTarget(NULL);
+}
+
+int main(void)
+{
+	OLED_Surface_t surface;
+
+	OLED_SurfaceInit(&surface, SurfaceBuf, 50, 20);
+	test_lines(&OLED_Screen, "screen");
+	test_lines(&surface, "surface 50*20");
+	test_points(&OLED_Screen, "screen");
+	test_points(&surface, "surface 50*20");
+	test_plot(&OLED_Screen, "screen");
+	test_plot(&surface, "surface 50*20");
+	test_rects(&OLED_Screen, "screen");
+	test_rects(&surface, "surface 50*20");
+	test_bezier(&OLED_Screen, "screen");
+	test_bezier(&surface, "surface 50*20");
+
+	return test_report("test_geometry");
+}
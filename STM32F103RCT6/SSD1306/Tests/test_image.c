@@ -0,0 +1,172 @@
+/**
+ * @file   test_image.c
+ * @brief  Host test of the images converted strip by strip, images wider than the strip buffer included
+ *
+ * @note   Build: cc -std=gnu11 -O2 -ITests/host -ICore/Inc -ICore/Src -o test_image Tests/test_image.c -lm
+ *         (from the SSD1306 directory)
+ *
+ *         Random bitmaps and grayscale images of up to 255*255 pixels are drawn at random positions on the screen,
+ *         on a surface wider than 128 pixels and on the planes of a temporal gray display. The target must equal
+ *         a per-pixel model: the image inside its area, the previous content outside of it.
+ */
+
+#include "oled_test.h"
+#include "oled.c"
+#include "oled_data.c"
+#include "oled_gray.c"
+
+static uint8_t SurfaceBuf[5 * 300];  // 300*40
+static uint8_t Image[255 * 255];
+static uint8_t Model[5 * 300];
+static uint8_t GrayBuf[OLED_GRAY_BUF_SIZE(OLED_GRAY_PLANES_MAX)];
+static uint8_t GrayModel[OLED_GRAY_BUF_SIZE(OLED_GRAY_PLANES_MAX)];
+
+/* Fill the drawing target and the model with random content */
+static void fill_random(OLED_Surface_t *surface)
+{
+	size_t k, size = OLED_SURFACE_SIZE(surface->width, surface->height);
+
+	for (k = 0; k < size; k++) {surface->buf[k] = (uint8_t)test_rand();}
+	memcpy(Model, surface->buf, size);
+}
+
+/* Set a pixel of the model, value is 0 or 1 */
+static void model_pixel(const OLED_Surface_t *surface, int x, int y, int value)
+{
+	if (x < 0 || x >= surface->width || y < 0 || y >= surface->height) {return;}
+	Model[y / 8 * surface->width + x] = (Model[y / 8 * surface->width + x] & ~(0x01 << (y % 8))) | (value << (y % 8));
+}
+
+static void test_bitmap(OLED_Surface_t *surface, const char *name)
+{
+	int n, x, y, width, height, i, j, stride, bit, format;
+
+	OLED_SetTarget(surface);
+	for (n = 0; n < 300 && !test_failures; n++)
+	{
+		width = (n < 8) ? 255 - n : test_range(0, 255);
+		height = test_range(0, (n & 1) ? 255 : 24);
+		x = test_range(-width - 8, surface->width + 8);
+		y = test_range(-height - 8, surface->height + 8);
+		format = (test_rand() & 1) ? OLED_BITMAP_PBM : OLED_BITMAP_XBM;
+		stride = (width + 7) / 8;
+		for (i = 0; i < stride * height; i++) {Image[i] = (uint8_t)test_rand();}
+
+		fill_random(surface);
+		OLED_ShowBitmap(x, y, width, height, Image, format);
+
+		for (j = 0; j < height; j++)
+		{
+			for (i = 0; i < width; i++)
+			{
+				bit = (format == OLED_BITMAP_PBM) ? 7 - i % 8 : i % 8;
+				model_pixel(surface, x + i, y + j, (Image[j * stride + i / 8] >> bit) & 0x01);
+			}
+		}
+		TEST_CHECK(memcmp(surface->buf, Model, OLED_SURFACE_SIZE(surface->width, surface->height)) == 0,
+		           "%s: OLED_ShowBitmap(%d, %d, %d, %d, format %d)", name, x, y, width, height, format);
+	}
+	OLED_SetTarget(NULL);
+}
+
+/* Random gray image, gray_level reads its pixels */
+static void random_gray(int width, int height, int bits)
+{
+	int i, size = (bits == OLED_GRAY_4BIT) ? (width + 1) / 2 * height : width * height;
+
+	for (i = 0; i < size; i++) {Image[i] = (uint8_t)test_rand();}
+}
+
+static int gray_level(int width, int bits, int c, int r)
+{
+	if (bits == OLED_GRAY_4BIT)
+	{
+		uint8_t byte = Image[r * ((width + 1) / 2) + c / 2];
+		return ((c & 1) ? byte & 0x0F : byte >> 4) * 0x11;
+	}
+	return Image[r * width + c];
+}
+
+static void test_gray_image(OLED_Surface_t *surface, const char *name)
+{
+	int n, x, y, width, height, i, j, bits;
+
+	OLED_SetTarget(surface);
+	for (n = 0; n < 300 && !test_failures; n++)
+	{
+		width = (n < 8) ? 255 - n : test_range(0, 255);
+		height = test_range(0, (n & 1) ? 255 : 24);
+		x = test_range(-width - 8, surface->width + 8);
+		y = test_range(-height - 8, surface->height + 8);
+		bits = (test_rand() & 1) ? OLED_GRAY_4BIT : OLED_GRAY_8BIT;
+		random_gray(width, height, bits);
+
+		fill_random(surface);
+		OLED_ShowGrayImage(x, y, width, height, Image, bits);
+
+		for (j = 0; j < height; j++)
+		{
+			for (i = 0; i < width; i++)
+			{
+				model_pixel(surface, x + i, y + j, gray_level(width, bits, i, j) > OLED_Bayer8[(y + j) & 0x07][(x + i) & 0x07]);
+			}
+		}
+		TEST_CHECK(memcmp(surface->buf, Model, OLED_SURFACE_SIZE(surface->width, surface->height)) == 0,
+		           "%s: OLED_ShowGrayImage(%d, %d, %d, %d, %d bits)", name, x, y, width, height, bits);
+	}
+	OLED_SetTarget(NULL);
+}
+
+static void test_gray_planes(void)
+{
+	OLED_Gray_t gray;
+	size_t k, plane_size = OLED_SURFACE_SIZE(128, 64);
+	int n, x, y, width, height, i, j, p, bits, level, levels;
+
+	OLED_GrayInit(&gray, GrayBuf, OLED_GRAY_PLANES_MAX);
+	levels = (1 << gray.planes) - 1;
+	for (n = 0; n < 300 && !test_failures; n++)
+	{
+		width = (n < 8) ? 255 - n : test_range(0, 255);
+		height = test_range(0, (n & 1) ? 255 : 24);
+		x = test_range(-width - 8, 128 + 8);
+		y = test_range(-height - 8, 64 + 8);
+		bits = (test_rand() & 1) ? OLED_GRAY_4BIT : OLED_GRAY_8BIT;
+		random_gray(width, height, bits);
+
+		for (k = 0; k < sizeof(GrayBuf); k++) {GrayBuf[k] = (uint8_t)test_rand();}
+		memcpy(GrayModel, GrayBuf, sizeof(GrayBuf));
+		OLED_GrayShowImage(&gray, x, y, width, height, Image, bits);
+		TEST_CHECK(OLED_GetTarget() == &OLED_Screen, "OLED_GrayShowImage does not restore the drawing target");
+
+		for (j = 0; j < height; j++)
+		{
+			for (i = 0; i < width; i++)
+			{
+				if (x + i < 0 || x + i >= 128 || y + j < 0 || y + j >= 64) {continue;}
+				level = (gray_level(width, bits, i, j) * levels + 127) / 255;
+				for (p = 0; p < gray.planes; p++)
+				{
+					uint8_t *byte = &GrayModel[p * plane_size + (y + j) / 8 * 128 + x + i];
+					*byte = (*byte & ~(0x01 << ((y + j) % 8))) | (((level >> p) & 0x01) << ((y + j) % 8));
+				}
+			}
+		}
+		TEST_CHECK(memcmp(GrayBuf, GrayModel, sizeof(GrayBuf)) == 0,
+		           "OLED_GrayShowImage(%d, %d, %d, %d, %d bits)", x, y, width, height, bits);
+	}
+}
+
+int main(void)
+{
+	OLED_Surface_t surface;
+
+	OLED_SurfaceInit(&surface, SurfaceBuf, 300, 40);
+	test_bitmap(&OLED_Screen, "screen");
+	test_bitmap(&surface, "surface 300*40");
+	test_gray_image(&OLED_Screen, "screen");
+	test_gray_image(&surface, "surface 300*40");
+	test_gray_planes();
+
+	return test_report("test_image");
+}
@@ -0,0 +1,131 @@
+/**
+ * @file   test_layout.c
+ * @brief  Host test of OLED_LayoutText
+ *
+ * @note   Build: cc -std=gnu11 -O2 -ITests/host -ICore/Inc -ICore/Src -o test_layout Tests/test_layout.c -lm
+ *         (from the SSD1306 directory)
+ *
+ *         Random strings of words, spaces, line feeds and Chinese characters are laid out with both wrap modes;
+ *         the lines must keep every character other than a space in order, measure as reported, fit into the
+ *         width unless they hold a single character, and only be empty for an empty line of the string.
+ *         The edge cases of no lines at all and a line starting with a space are checked directly.
+ */
+
+#include "oled_test.h"
+#include "oled.c"
+#include "oled_data.c"
+
+#define MAX_LINES  64
+
+static const char *const Words[] = {"a", "to", "word", "pixels", "wrapping", "display", "你好", "世界。", " ", "  ", "\n"};
+
+/* Width of a line measured by itself */
+static int16_t line_width(const char *str, const OLED_TextLine_t *line, uint8_t font_size)
+{
+	char text[256];
+
+	memcpy(text, str + line->start, line->length);
+	text[line->length] = '\0';
+	return OLED_MeasureString(text, font_size);
+}
+
+/* Number of characters of a line, a UTF-8 character counts once */
+static int line_chars(const char *str, const OLED_TextLine_t *line)
+{
+	int i, chars = 0;
+
+	for (i = 0; i < line->length; i++)
+	{
+		if ((str[line->start + i] & 0xC0) != 0x80) {chars++;}
+	}
+	return chars;
+}
+
+static void test_random(void)
+{
+	OLED_TextLine_t lines[MAX_LINES];
+	char str[256], kept[256], laid[256];
+	int n, i, j, k, length;
+	int16_t width;
+	uint8_t count, font_size, flags;
+
+	for (n = 0; n < 20000 && !test_failures; n++)
+	{
+		str[0] = '\0';
+		length = test_range(1, 12);
+		for (i = 0; i < length; i++) {strcat(str, Words[test_rand() % (sizeof(Words) / sizeof(Words[0]))]);}
+		font_size = (test_rand() & 1) ? OLED_8X16 : OLED_6X8;
+		width = test_range(24, 128);
+		flags = (test_rand() & 1) ? OLED_TEXT_WRAP_WORD : OLED_TEXT_WRAP_CHAR;
+
+		count = OLED_LayoutText(str, width, MAX_LINES * 16, font_size, flags, lines, MAX_LINES);
+		TEST_CHECK(count > 0 && count < MAX_LINES, "\"%s\": %u lines", str, count);
+
+		for (i = 0, k = 0; i < count; i++)
+		{
+			const OLED_TextLine_t *line = &lines[i];
+			char first = str[line->start];
+
+			TEST_CHECK(line->width == line_width(str, line, font_size),
+			           "\"%s\" width %d: line %d measures %d, reported %d",
+			           str, width, i, line_width(str, line, font_size), line->width);
+			TEST_CHECK(line->width <= width || line_chars(str, line) == 1,
+			           "\"%s\" width %d: line %d is %d pixels wide", str, width, i, line->width);
+			TEST_CHECK(line->length > 0 || first == '\n' || first == '\0',
+			           "\"%s\" width %d flags 0x%02X: line %d is empty", str, width, flags, i);
+			TEST_CHECK(!line->ellipsis, "\"%s\": line %d has an ellipsis", str, i);
+			if (i > 0) {TEST_CHECK(line->start >= lines[i - 1].start + lines[i - 1].length, "\"%s\": line %d overlaps", str, i);}
+
+			for (j = 0; j < line->length; j++)
+			{
+				if (str[line->start + j] != ' ') {laid[k++] = str[line->start + j];}
+			}
+		}
+		laid[k] = '\0';
+
+		for (i = 0, k = 0; str[i] != '\0'; i++)
+		{
+			if (str[i] != ' ' && str[i] != '\n') {kept[k++] = str[i];}
+		}
+		kept[k] = '\0';
+		TEST_CHECK(strcmp(kept, laid) == 0, "\"%s\" width %d flags 0x%02X: lost characters", str, width, flags);
+	}
+}
+
+static void test_edges(void)
+{
+	OLED_TextLine_t lines[4];
+	uint8_t count;
+
+	/* No lines, the ellipsis must not reach before the array */
+	memset(lines, 0xA5, sizeof(lines));
+	count = OLED_LayoutText("more text than lines", 30, 8, OLED_6X8, OLED_TEXT_WRAP_WORD | OLED_TEXT_ELLIPSIS, &lines[1], 0);
+	TEST_CHECK(count == 0, "0 lines: %u laid out", count);
+	TEST_CHECK(lines[0].start == 0xA5A5 && lines[0].width == (int16_t)0xA5A5, "0 lines: written before the lines");
+	TEST_CHECK(lines[1].start == 0xA5A5, "0 lines: a line was written");
+
+	/* A leading space is no break, the long word is broken between characters on that line */
+	count = OLED_LayoutText("ab\n verylongword", 48, 64, OLED_6X8, OLED_TEXT_WRAP_WORD, lines, 4);
+	TEST_CHECK(count == 3, "leading space after a line feed: %u lines", count);
+	TEST_CHECK(lines[1].start == 3 && lines[1].length == 8, "leading space after a line feed: line 1 is %u+%u",
+	           lines[1].start, lines[1].length);
+	TEST_CHECK(lines[2].start == 11 && lines[2].length == 5, "leading space after a line feed: line 2 is %u+%u",
+	           lines[2].start, lines[2].length);
+
+	count = OLED_LayoutText("  verylongword", 48, 64, OLED_6X8, OLED_TEXT_WRAP_WORD, lines, 4);
+	TEST_CHECK(count == 2 && lines[0].start == 0 && lines[0].length == 8 && lines[1].start == 8,
+	           "leading spaces: %u lines, line 0 is %u+%u", count, lines[0].start, lines[0].length);
+
+	/* Spaces after the first word still break */
+	count = OLED_LayoutText(" ab cdefgh", 48, 64, OLED_6X8, OLED_TEXT_WRAP_WORD, lines, 4);
+	TEST_CHECK(count == 2 && lines[0].length == 3 && lines[1].start == 4 && lines[1].length == 6,
+	           "break after the first word: %u lines, line 0 is %u+%u", count, lines[0].start, lines[0].length);
+}
+
+int main(void)
+{
+	test_edges();
+	test_random();
+
+	return test_report("test_layout");
+}
@@ -0,0 +1,127 @@
+/**
+ * @file   test_packed.c
+ * @brief  Host golden test of the packed fonts against the original OLED_F8x16 and OLED_F6x8 tables
+ *
+ * @note   Build: cc -std=gnu11 -O2 -ITests/host -ICore/Inc -ICore/Src -o test_packed Tests/test_packed.c -lm
+ *         (from the SSD1306 directory)
+ *
+ *         Every printable ASCII glyph of OLED_PackedFont8x16 and OLED_PackedFont6x8 is drawn with OLED_ShowPackedChar
+ *         at every y % 8, including negative y-coordinates and cells cut by every edge, on the screen and on a surface
+ *         whose height is not a multiple of 8, both filled with random content. It must equal the glyph of the original
+ *         table drawn with OLED_ShowImage, and advance by the width of the original cell.
+ *         OLED_ShowPackedString of all glyphs must equal the glyphs drawn one after another.
+ */
+
+#include "oled_test.h"
+#include "oled.c"
+#include "oled_data.c"
+
+static uint8_t ExpectedBuf[1024], ActualBuf[1024];
+
+/* The original glyph of a character and its cell */
+static const uint8_t *original_glyph(const OLED_PackedFont_t *font, char c, uint8_t *width, uint8_t *height)
+{
+	*width = (font == &OLED_PackedFont8x16) ? 8 : 6;
+	*height = (font == &OLED_PackedFont8x16) ? 16 : 8;
+	return (font == &OLED_PackedFont8x16) ? OLED_F8x16[c - ' '] : OLED_F6x8[c - ' '];
+}
+
+/* Compare the pixels inside the drawing target, the padding rows of the last page are not part of it */
+static int equal_pixels(const OLED_Surface_t *expected, const OLED_Surface_t *actual)
+{
+	int x, y;
+
+	for (y = 0; y < actual->height; y++)
+	{
+		for (x = 0; x < actual->width; x++)
+		{
+			if (((expected->buf[y / 8 * expected->width + x] ^ actual->buf[y / 8 * actual->width + x]) >> (y % 8)) & 0x01) {return 0;}
+		}
+	}
+	return 1;
+}
+
+static void test_glyphs(const OLED_PackedFont_t *font, int16_t target_width, int16_t target_height, const char *name)
+{
+	OLED_Surface_t expected, actual;
+	const uint8_t *glyph;
+	int16_t x, y, xs[] = {-7, -3, 0, 1, 37, 0, 0};
+	uint8_t width, height, advance;
+	int c, k, i, size;
+
+	OLED_SurfaceInit(&expected, ExpectedBuf, target_width, target_height);
+	OLED_SurfaceInit(&actual, ActualBuf, target_width, target_height);
+	size = OLED_SURFACE_SIZE(target_width, target_height);
+	xs[5] = target_width - 6;
+	xs[6] = target_width - 1;
+
+	for (c = ' '; c <= '~' && !test_failures; c++)
+	{
+		glyph = original_glyph(font, (char)c, &width, &height);
+		for (y = -17; y <= target_height + 1 && !test_failures; y++)  // Every y % 8, and cells cut by the top and bottom edges
+		{
+			for (k = 0; k < (int)(sizeof(xs) / sizeof(xs[0])); k++)
+			{
+				x = xs[k];
+				for (i = 0; i < size; i++) {ExpectedBuf[i] = ActualBuf[i] = (uint8_t)test_rand();}
+
+				OLED_SetTarget(&expected);
+				OLED_ShowImage(x, y, width, height, glyph);
+				OLED_SetTarget(&actual);
+				advance = OLED_ShowPackedChar(x, y, (uint32_t)c, font);
+
+				TEST_CHECK(advance == width, "%s, '%c': advance %u, the original cell is %u wide", name, c, advance, width);
+				TEST_CHECK(equal_pixels(&expected, &actual), "%s, '%c' at (%d, %d)", name, c, x, y);
+			}
+		}
+	}
+	OLED_SetTarget(NULL);
+}
+
+/* All glyphs as one string, at every y % 8 */
+static void test_string(const OLED_PackedFont_t *font, const char *name)
+{
+	OLED_Surface_t expected, actual;
+	char str[96];
+	const uint8_t *glyph;
+	uint8_t width, height;
+	int16_t x, y, start;
+	int c;
+
+	for (c = ' '; c <= '~'; c++) {str[c - ' '] = (char)c;}
+	str[95] = '\0';
+	OLED_SurfaceInit(&expected, ExpectedBuf, 128, 64);
+	OLED_SurfaceInit(&actual, ActualBuf, 128, 64);
+
+	for (y = -3; y < 8 && !test_failures; y++)
+	{
+		for (start = -60 * 8; start < 128; start += 61)
+		{
+			memset(ExpectedBuf, 0x5A, sizeof(ExpectedBuf));
+			memset(ActualBuf, 0x5A, sizeof(ActualBuf));
+
+			OLED_SetTarget(&expected);
+			for (c = ' ', x = start; c <= '~'; c++, x += width)
+			{
+				glyph = original_glyph(font, (char)c, &width, &height);
+				OLED_ShowImage(x, y * 7, width, height, glyph);
+			}
+			OLED_SetTarget(&actual);
+			OLED_ShowPackedString(start, y * 7, str, font);
+			TEST_CHECK(memcmp(ExpectedBuf, ActualBuf, sizeof(ActualBuf)) == 0, "%s, the string at (%d, %d)", name, start, y * 7);
+		}
+	}
+	OLED_SetTarget(NULL);
+}
+
+int main(void)
+{
+	test_glyphs(&OLED_PackedFont8x16, 128, 64, "OLED_PackedFont8x16 on the screen");
+	test_glyphs(&OLED_PackedFont6x8, 128, 64, "OLED_PackedFont6x8 on the screen");
+	test_glyphs(&OLED_PackedFont8x16, 50, 21, "OLED_PackedFont8x16 on a 50*21 surface");
+	test_glyphs(&OLED_PackedFont6x8, 50, 21, "OLED_PackedFont6x8 on a 50*21 surface");
+	test_string(&OLED_PackedFont8x16, "OLED_PackedFont8x16");
+	test_string(&OLED_PackedFont6x8, "OLED_PackedFont6x8");
+
+	return test_report("test_packed");
+}
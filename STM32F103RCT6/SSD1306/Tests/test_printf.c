@@ -0,0 +1,143 @@
+/**
+ * @file   test_printf.c
+ * @brief  Host test of OLED_Printf against the C library printf
+ *
+ * @note   Build: cc -std=gnu11 -O2 -ITests/host -ICore/Inc -ICore/Src -o test_printf Tests/test_printf.c -lm
+ *         (from the SSD1306 directory)
+ *
+ *         Random conversion specifications with flags, widths and precisions, given directly or with '*',
+ *         are formatted by snprintf and shown with OLED_ShowString, and by OLED_Printf; the pixels must match.
+ *         The length modifiers hh, h, z and t are mixed in, the arguments of z and t are passed with their own type.
+ *         %k has no C library counterpart and is compared with fixed strings, and so are the unsupported conversions,
+ *         which must skip their arguments so that the following conversions still show the right values.
+ */
+
+#include "oled_test.h"
+#include "oled.c"
+#include "oled_data.c"
+
+static uint8_t ExpectedBuf[2 * 256], ActualBuf[2 * 256];
+static OLED_Surface_t Expected, Actual;
+
+/* Draw the expected text and prepare the drawing of OLED_Printf, both on a cleared 256*16 surface */
+static void expect(int16_t x, int16_t y, const char *text, uint8_t font_size)
+{
+	memset(ExpectedBuf, 0x00, sizeof(ExpectedBuf));
+	memset(ActualBuf, 0x00, sizeof(ActualBuf));
+	OLED_SetTarget(&Expected);
+	OLED_ShowString(x, y, (char *)text, font_size);
+	OLED_SetTarget(&Actual);
+}
+
+#define CHECK_PRINTF(x, y, font_size, format, ...) \
+  do { \
+    char text_[512]; \
+    snprintf(text_, sizeof(text_), format, __VA_ARGS__); \
+    expect(x, y, text_, font_size); \
+    OLED_Printf(x, y, font_size, format, __VA_ARGS__); \
+    TEST_CHECK(memcmp(ExpectedBuf, ActualBuf, sizeof(ActualBuf)) == 0, "\"%s\" should show \"%s\"", format, text_); \
+  } while (0)
+
+/* A random integer conversion specification like "%-#08.3hx", with '*' for the width or precision if star is set,
+   wide is set for the z and t length modifiers */
+static char random_spec(char *format, uint8_t star, uint8_t *wide)
+{
+	static const char conversions[] = "diuxX";
+	static const char *const sizes[] = {"", "", "hh", "h", "z", "t"};
+	char conversion = conversions[test_rand() % 5], *p = format;
+	const char *size = sizes[test_rand() % 6];
+
+	*p++ = '%';
+	if (test_rand() % 3 == 0) {*p++ = '-';}
+	if (test_rand() % 3 == 0) {*p++ = '0';}
+	if (conversion == 'd' || conversion == 'i')
+	{
+		if (test_rand() % 3 == 0) {*p++ = '+';}
+		if (test_rand() % 3 == 0) {*p++ = ' ';}
+	}
+	if ((conversion == 'x' || conversion == 'X') && test_rand() % 2 == 0) {*p++ = '#';}
+	if (star) {*p++ = '*';}
+	else if (test_rand() % 2 == 0) {p += sprintf(p, "%d", test_range(1, 14));}
+	if (star) {p += sprintf(p, ".*");}
+	else if (test_rand() % 2 == 0) {p += sprintf(p, ".%d", test_range(0, 12));}
+	p += sprintf(p, "%s", size);
+	*wide = (*size == 'z' || *size == 't');
+	*p++ = conversion;
+	*p = '\0';
+	return conversion;
+}
+
+static void test_integers(void)
+{
+	char format[32];
+	int n, value, width, precision;
+	int16_t x, y;
+	uint8_t font_size, wide;
+	char conversion;
+
+	for (n = 0; n < 40000 && !test_failures; n++)
+	{
+		x = test_range(-10, 200);
+		y = test_range(-4, 8);
+		font_size = (test_rand() & 1) ? OLED_8X16 : OLED_6X8;
+		value = (int)test_rand();
+		if (n % 3 == 0) {value %= 1000;}
+		if (n % 17 == 0) {value = 0;}
+
+		if (n % 4 == 0)  // Width and precision from the arguments, negative ones included
+		{
+			conversion = random_spec(format, 1, &wide);
+			width = test_range(-12, 12);
+			precision = test_range(-2, 12);
+			if (!wide) {CHECK_PRINTF(x, y, font_size, format, width, precision, value);}
+			else if (conversion == 'd' || conversion == 'i') {CHECK_PRINTF(x, y, font_size, format, width, precision, (ptrdiff_t)value);}
+			else {CHECK_PRINTF(x, y, font_size, format, width, precision, (size_t)(unsigned)value);}
+		}
+		else
+		{
+			conversion = random_spec(format, 0, &wide);
+			if (!wide) {CHECK_PRINTF(x, y, font_size, format, value);}
+			else if (conversion == 'd' || conversion == 'i') {CHECK_PRINTF(x, y, font_size, format, (ptrdiff_t)value);}
+			else {CHECK_PRINTF(x, y, font_size, format, (size_t)(unsigned)value);}
+		}
+	}
+
+	/* Mixed with text, the long modifier and the other conversions */
+	CHECK_PRINTF(0, 0, OLED_6X8, "[%.3d|%5.3d|%-6.4u|%#x|%#X]", 7, -42, 9u, 255u, 0xABCu);
+	CHECK_PRINTF(0, 0, OLED_6X8, "%#010x %#.6lx %.0d|%.0x|%#.0x|", 0x1Fu, 0xBEEFUL, 0, 0u, 0u);
+	CHECK_PRINTF(0, 0, OLED_6X8, "%ld %lu %.12ld", -2147483647L - 1, 4294967295UL, -5L);
+	CHECK_PRINTF(0, 0, OLED_8X16, "%3c|%-3c|%s|%.2s|%%", 'A', 'b', "text", "cut");
+}
+
+/* Unsupported conversions show their character and skip their argument, whatever its size */
+static void test_unsupported(void)
+{
+	long double big = 1.25;
+	int count;
+
+	expect(0, 0, "f|7|e|8|p|d|9|f|10|s|-3|G|200|d|n|-4|x|5|A|y|6", OLED_6X8);
+	OLED_Printf(0, 0, OLED_6X8, "%f|%d|%e|%d|%p|%lld|%d|%Lf|%d|%ls|%hd|%G|%hhu|%jd|%n|%zd|%llx|%d|%-8.3A|%y|%d",
+	            1.5, 7, 2.5e10, 8, (void *)&count, 1LL << 40, 9, big, 10, L"wide", -3, 0.5, 200 + 256,
+	            (intmax_t)-1, &count, (ptrdiff_t)-4, 0x123456789ULL, 5, -0.75, 6);
+	TEST_CHECK(memcmp(ExpectedBuf, ActualBuf, sizeof(ActualBuf)) == 0, "unsupported conversions");
+}
+
+static void test_fixed(void)
+{
+	expect(0, 0, "[ -0.05|+123.45|7.5   |  12|123.45|-0.001]", OLED_6X8);
+	OLED_Printf(0, 0, OLED_6X8, "[%6.2k|%+.2k|%-06.1k|%4.0k|%.2lk|%.3k]", -5, 12345, 75, 12, 12345L, -1);
+	TEST_CHECK(memcmp(ExpectedBuf, ActualBuf, sizeof(ActualBuf)) == 0, "%%k conversions");
+}
+
+int main(void)
+{
+	OLED_SurfaceInit(&Expected, ExpectedBuf, 256, 16);
+	OLED_SurfaceInit(&Actual, ActualBuf, 256, 16);
+
+	test_integers();
+	test_unsupported();
+	test_fixed();
+	OLED_SetTarget(NULL);
+
+	return test_report("test_printf");
+}
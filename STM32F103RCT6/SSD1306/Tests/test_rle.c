@@ -0,0 +1,135 @@
+/**
+ * @file   test_rle.c
+ * @brief  Host round-trip test of the run-length compressed images, from the Tools/oled_rle.c encoder to OLED_ShowImageRLE
+ *
+ * @note   Build: cc -std=gnu11 -O2 -ITests/host -ICore/Inc -ICore/Src -o test_rle Tests/test_rle.c -lm
+ *         (from the SSD1306 directory)
+ *
+ *         Random images with repeated and literal stretches are encoded with packbits of the tool, like its main
+ *         function does, with no-operation headers inserted between the runs. OLED_ShowImageRLE must draw them like
+ *         OLED_ShowImage draws the raw data, at unaligned positions across every edge of surfaces of several sizes
+ *         filled with random content. Streams that encode more bytes than the image, so that the last repeat
+ *         or literal run is longer than what is left of the image, must stop at the end of the image.
+ */
+
+#include "oled_test.h"
+#include "oled.c"
+#include "oled_data.c"
+
+/* The encoder of the tool, its main function is not used */
+#define main oled_rle_main
+#include "../Tools/oled_rle.c"
+#undef main
+
+static uint8_t Image[1024 + 256];
+static uint8_t Encoded[2 * (1024 + 256)], Stream[4 * (1024 + 256)];
+static uint8_t ExpectedBuf[5 * 300], ActualBuf[5 * 300];  // 300*40
+
+/* A random image of stretches of random bytes, one repeated byte and two alternating bytes */
+static void random_image(uint8_t *image, int size)
+{
+	int k = 0, n;
+	uint8_t a, b;
+
+	while (k < size)
+	{
+		n = test_range(1, 200);
+		a = (uint8_t)test_rand();
+		b = (uint8_t)test_rand();
+		switch (test_rand() % 3)
+		{
+			case 0:  while (n-- && k < size) {image[k++] = (uint8_t)test_rand();} break;
+			case 1:  while (n-- && k < size) {image[k++] = a;} break;
+			default: while (n-- && k < size) {image[k] = (k & 1) ? a : b; k++;} break;
+		}
+	}
+}
+
+/* Copy a PackBits stream, inserting no-operation headers before random runs */
+static size_t insert_nops(const uint8_t *src, size_t size, uint8_t *dst)
+{
+	size_t i = 0, out = 0;
+	uint8_t header;
+
+	while (i < size)
+	{
+		while (test_rand() % 4 == 0) {dst[out++] = 128;}
+		header = src[i];
+		dst[out++] = src[i++];
+		if (header < 128)
+		{
+			memcpy(&dst[out], &src[i], header + 1);
+			out += header + 1;
+			i += header + 1;
+		}
+		else
+		{
+			dst[out++] = src[i++];
+		}
+	}
+	return out;
+}
+
+static void test_random(void)
+{
+	static const int16_t sizes[][2] = {{128, 64}, {100, 37}, {300, 20}, {64, 128}};
+	OLED_Surface_t expected, actual;
+	int n, k, size, image_size, extra;
+	size_t encoded_size;
+	int16_t x, y;
+	uint8_t width, height;
+
+	for (n = 0; n < 20000 && !test_failures; n++)
+	{
+		k = test_rand() % (sizeof(sizes) / sizeof(sizes[0]));
+		OLED_SurfaceInit(&expected, ExpectedBuf, sizes[k][0], sizes[k][1]);
+		OLED_SurfaceInit(&actual, ActualBuf, sizes[k][0], sizes[k][1]);
+		size = OLED_SURFACE_SIZE(sizes[k][0], sizes[k][1]);
+
+		width = test_range(0, 128);
+		height = test_range(1, 64);
+		image_size = (height + 7) / 8 * width;
+		extra = (n % 4 == 0) ? test_range(1, 256) : 0;  // Runs past the end of the image
+		random_image(Image, image_size + extra);
+		encoded_size = packbits(Image, image_size + extra, Encoded);
+		encoded_size = insert_nops(Encoded, encoded_size, Stream);
+
+		x = test_range(-width - 4, sizes[k][0] + 4);
+		y = test_range(-height - 12, sizes[k][1] + 4);
+
+		for (k = 0; k < size; k++) {ExpectedBuf[k] = ActualBuf[k] = (uint8_t)test_rand();}
+		OLED_SetTarget(&expected);
+		OLED_ShowImage(x, y, width, height, Image);
+		OLED_SetTarget(&actual);
+		OLED_ShowImageRLE(x, y, width, height, Stream);
+		TEST_CHECK(memcmp(ExpectedBuf, ActualBuf, size) == 0, "%ux%u image at (%d, %d) on %d*%d, %d bytes past the image",
+		           width, height, x, y, actual.width, actual.height, extra);
+	}
+	OLED_SetTarget(NULL);
+}
+
+/* A single run covering more than the image, nothing below the image is drawn */
+static void test_long_runs(void)
+{
+	static const uint8_t repeat[] = {129, 0xFF};  // 128 times 0xFF
+	static const uint8_t literal[] = {5, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+	static const uint8_t raw[3] = {0xFF, 0xFF, 0xFF};
+
+	OLED_Clear();
+	OLED_ShowImageRLE(10, 4, 3, 8, repeat);
+	OLED_ShowImageRLE(20, 4, 3, 8, literal);
+	memcpy(ExpectedBuf, OLED_DisplayBuf, 1024);
+
+	OLED_Clear();
+	OLED_ShowImage(10, 4, 3, 8, raw);
+	OLED_ShowImage(20, 4, 3, 8, raw);
+	TEST_CHECK(memcmp(ExpectedBuf, OLED_DisplayBuf, 1024) == 0, "runs longer than a 3x8 image");
+}
+
+int main(void)
+{
+	test_long_runs();
+	test_random();
+
+	return test_report("test_rle");
+}
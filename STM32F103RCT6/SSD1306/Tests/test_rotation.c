@@ -0,0 +1,147 @@
+/**
+ * @file   test_rotation.c
+ * @brief  Host test of the display rotation, OLED_Transpose8 and the transposed update path
+ *
+ * @note   Build: cc -std=gnu11 -O2 -ITests/host -ICore/Inc -ICore/Src -o test_rotation Tests/test_rotation.c -lm
+ *         (from the SSD1306 directory)
+ *
+ *         OLED_Transpose8 is compared with a bit by bit transpose. For every rotation random pixels are drawn
+ *         and sent by OLED_Update and OLED_UpdateArea, and the emulated panel must show each pixel (x, y)
+ *         of the OLED_Screen where a per-pixel clockwise rotation of the content puts it.
+ *         A rotation set before OLED_Init must not reach the I2C pins and must be sent by OLED_Init.
+ */
+
+#include "oled_test.h"
+#include "oled.c"
+#include "oled_data.c"
+
+/* Reference transpose, the element (i, j) is bit j of byte i */
+static void transpose_ref(const uint8_t *src, uint8_t *dst)
+{
+	int i, j;
+
+	memset(dst, 0x00, 8);
+	for (i = 0; i < 8; i++)
+	{
+		for (j = 0; j < 8; j++)
+		{
+			if (src[i] & (0x01 << j)) {dst[j] |= 0x01 << i;}
+		}
+	}
+}
+
+/* The panel position of the screen pixel (x, y), the content is rotated clockwise */
+static void rotate_ref(uint8_t rotation, int x, int y, int *panel_x, int *panel_y)
+{
+	switch (rotation)
+	{
+		case OLED_ROTATION_90:  *panel_x = 127 - y; *panel_y = x;      break;
+		case OLED_ROTATION_180: *panel_x = 127 - x; *panel_y = 63 - y; break;
+		case OLED_ROTATION_270: *panel_x = y;       *panel_y = 63 - x; break;
+		default:                *panel_x = x;       *panel_y = y;      break;
+	}
+}
+
+static void test_transpose(void)
+{
+	uint8_t src[8], dst[8], ref[8];
+	int n, i;
+
+	for (n = 0; n < 20000; n++)
+	{
+		for (i = 0; i < 8; i++) {src[i] = (n < 64) ? (uint8_t)((n >> 3) == i ? 0x01 << (n & 7) : 0) : (uint8_t)test_rand();}
+		OLED_Transpose8(src, dst);
+		transpose_ref(src, ref);
+		TEST_CHECK(memcmp(dst, ref, 8) == 0, "OLED_Transpose8 of %02X %02X %02X %02X %02X %02X %02X %02X",
+		           src[0], src[1], src[2], src[3], src[4], src[5], src[6], src[7]);
+	}
+}
+
+/* Compare the panel with the screen, pixels outside [x0,x1)*[y0,y1) may also show old, the previous screen content */
+static void check_panel(uint8_t rotation, const uint8_t *old, int x0, int y0, int x1, int y1, const char *what)
+{
+	int x, y, panel_x, panel_y, expected, shown, stale;
+
+	for (y = 0; y < OLED_Screen.height; y++)
+	{
+		for (x = 0; x < OLED_Screen.width; x++)
+		{
+			rotate_ref(rotation, x, y, &panel_x, &panel_y);
+			expected = OLED_GetPoint(x, y);
+			shown = test_panel_pixel(panel_x, panel_y);
+			stale = (old != NULL && !(x >= x0 && x < x1 && y >= y0 && y < y1)) ? (old[y / 8 * OLED_Screen.width + x] >> (y % 8)) & 0x01 : expected;
+			TEST_CHECK(shown == expected || shown == stale, "rotation %u, %s: pixel (%d, %d) shown as %d at (%d, %d)",
+			           rotation, what, x, y, shown, panel_x, panel_y);
+			if (test_failures) {return;}
+		}
+	}
+}
+
+static void test_rotation(uint8_t rotation)
+{
+	static uint8_t old[1024];
+	int n, i, x, y, width, height;
+
+	OLED_SetRotation(rotation);
+	for (i = 0; i < 600; i++) {OLED_DrawPoint(test_range(0, OLED_Screen.width - 1), test_range(0, OLED_Screen.height - 1));}
+	OLED_DrawRectangle(0, 0, OLED_Screen.width, OLED_Screen.height, OLED_UNFILLED);
+	OLED_ShowString(2, 2, "Rot", OLED_8X16);
+	OLED_Update();
+	check_panel(rotation, NULL, 0, 0, 0, 0, "OLED_Update");
+
+	/* Partial updates, only the area is guaranteed to be sent */
+	for (n = 0; n < 200 && !test_failures; n++)
+	{
+		memcpy(old, OLED_DisplayBuf, sizeof(old));
+		for (i = 0; i < 40; i++)
+		{
+			x = test_range(0, OLED_Screen.width - 1);
+			y = test_range(0, OLED_Screen.height - 1);
+			if (test_rand() & 1) {OLED_DrawPoint(x, y);}
+			else {OLED_ClearArea(x, y, 1, 1);}
+		}
+
+		x = test_range(-10, OLED_Screen.width);
+		y = test_range(-10, OLED_Screen.height);
+		width = test_range(0, OLED_Screen.width);
+		height = test_range(0, OLED_Screen.height);
+		OLED_UpdateArea(x, y, width, height);
+		check_panel(rotation, old, x, y, x + width, y + height, "OLED_UpdateArea");
+
+		/* Bring the panel up to date for the next round */
+		OLED_Update();
+	}
+}
+
+/* Before OLED_Init the rotation is only recorded, OLED_Init sends it; invalid rotations are ignored */
+static void test_before_init(void)
+{
+	OLED_SetRotation(OLED_ROTATION_90);
+	TEST_CHECK(TEST_I2CBytes == 0, "OLED_SetRotation before OLED_Init sent %lu bytes", TEST_I2CBytes);
+	TEST_CHECK(OLED_Screen.width == 64 && OLED_Screen.height == 128, "rotation 90 before OLED_Init: %dx%d",
+	           OLED_Screen.width, OLED_Screen.height);
+
+	OLED_Init();
+	TEST_CHECK(TEST_SegRemap == 0 && TEST_ComRemap == 1, "OLED_Init after rotation 90: re-map %u, COM scan %u",
+	           TEST_SegRemap, TEST_ComRemap);
+
+	OLED_SetRotation(OLED_ROTATION_270 + 1);
+	OLED_SetRotation(0xFF);
+	TEST_CHECK(OLED_Rotation == OLED_ROTATION_90 && OLED_Screen.width == 64 && TEST_SegRemap == 0 && TEST_ComRemap == 1,
+	           "invalid rotations changed the rotation to %u", OLED_Rotation);
+
+	OLED_SetRotation(OLED_ROTATION_0);
+	TEST_CHECK(TEST_SegRemap == 1 && TEST_ComRemap == 1 && OLED_Screen.width == 128, "rotation 0 after OLED_Init: re-map %u, COM scan %u",
+	           TEST_SegRemap, TEST_ComRemap);
+}
+
+int main(void)
+{
+	uint8_t rotation;
+
+	test_before_init();
+	test_transpose();
+	for (rotation = OLED_ROTATION_0; rotation <= OLED_ROTATION_270; rotation++) {test_rotation(rotation);}
+
+	return test_report("test_rotation");
+}
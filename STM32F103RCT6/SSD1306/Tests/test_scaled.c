@@ -0,0 +1,150 @@
+/**
+ * @file   test_scaled.c
+ * @brief  Host test of OLED_ShowImageScaled and OLED_ShowStringScaled against per-pixel nearest-neighbour scaling
+ *
+ * @note   Build: cc -std=gnu11 -O2 -ITests/host -ICore/Inc -ICore/Src -o test_scaled Tests/test_scaled.c -lm
+ *         (from the SSD1306 directory)
+ *
+ *         Random images and strings are drawn enlarged by 2 to 4, and by 1, images also by the clamped factors 0 and 5,
+ *         at positions clipped by every edge of surfaces of several sizes filled with random content.
+ *         The reference clears the enlarged area and repeats every pixel that OLED_ShowImage draws,
+ *         the padding bits of the last page included, as a scale * scale block, one pixel at a time.
+ */
+
+#include "oled_test.h"
+#include "oled.c"
+#include "oled_data.c"
+
+static uint8_t Image[9 * 136];  // Up to 136*72 with the factors 0 and 1
+static uint8_t ExpectedBuf[5 * 300], ActualBuf[5 * 300];  // 300*40
+
+static const char *const Chars[] = {"，", "你", "好", "世", "界", "中"};  // "中" is not in the font
+
+/* Set or clear a pixel inside the drawing target */
+static void ref_point(int x, int y, int lit)
+{
+	uint8_t *p;
+
+	if (x < 0 || x >= OLED_Target->width || y < 0 || y >= OLED_Target->height) {return;}
+	p = &OLED_Target->buf[y / 8 * OLED_Target->width + x];
+	*p = lit ? (*p | (0x01 << (y % 8))) : (*p & ~(0x01 << (y % 8)));
+}
+
+/* Nearest-neighbour scaling of what OLED_ShowImage draws, one pixel at a time */
+static void ref_scaled(int x, int y, int width, int height, const uint8_t *image, int scale)
+{
+	int i, r, k, c, pages = (height + 7) / 8;
+
+	if (scale < 1) {scale = 1;}
+	if (scale > 4) {scale = 4;}
+
+	for (r = 0; r < height * scale; r++)
+	{
+		for (i = 0; i < width * scale; i++) {ref_point(x + i, y + r, 0);}
+	}
+	for (r = 0; r < pages * 8; r++)  // OLED_ShowImage also draws the padding bits of the last page
+	{
+		for (i = 0; i < width; i++)
+		{
+			if (!((image[r / 8 * width + i] >> (r % 8)) & 0x01)) {continue;}
+			for (k = 0; k < scale; k++)
+			{
+				for (c = 0; c < scale; c++) {ref_point(x + i * scale + c, y + r * scale + k, 1);}
+			}
+		}
+	}
+}
+
+/* Compare the pixels inside the drawing target, the padding rows of the last page are not part of it */
+static int equal_pixels(const OLED_Surface_t *expected, const OLED_Surface_t *actual)
+{
+	int x, y;
+
+	for (y = 0; y < actual->height; y++)
+	{
+		for (x = 0; x < actual->width; x++)
+		{
+			if (((expected->buf[y / 8 * expected->width + x] ^ actual->buf[y / 8 * actual->width + x]) >> (y % 8)) & 0x01) {return 0;}
+		}
+	}
+	return 1;
+}
+
+/* A random string of ASCII and Chinese characters */
+static void random_text(char *str, int length)
+{
+	int i;
+
+	str[0] = '\0';
+	for (i = 0; i < length; i++)
+	{
+		if (test_rand() % 4 == 0) {strcat(str, Chars[test_rand() % (sizeof(Chars) / sizeof(Chars[0]))]);}
+		else {str[strlen(str) + 1] = '\0'; str[strlen(str)] = (char)test_range(' ', '~');}
+	}
+}
+
+static void test_random(void)
+{
+	static const int16_t sizes[][2] = {{128, 64}, {100, 37}, {300, 20}, {64, 128}};
+	OLED_Surface_t expected, actual;
+	const char *p;
+	const uint8_t *glyph;
+	char str[64];
+	int n, k, size, scale, cx;
+	int16_t x, y;
+	uint8_t width, height, font_size;
+	uint32_t code;
+
+	for (n = 0; n < 40000 && !test_failures; n++)
+	{
+		k = test_rand() % (sizeof(sizes) / sizeof(sizes[0]));
+		OLED_SurfaceInit(&expected, ExpectedBuf, sizes[k][0], sizes[k][1]);
+		OLED_SurfaceInit(&actual, ActualBuf, sizes[k][0], sizes[k][1]);
+		size = OLED_SURFACE_SIZE(sizes[k][0], sizes[k][1]);
+		for (k = 0; k < size; k++) {ExpectedBuf[k] = ActualBuf[k] = (uint8_t)test_rand();}
+		scale = (n % 8 < 2) ? test_range(0, 5) : test_range(2, 4);
+
+		if (n & 1)  // An image
+		{
+			width = test_range(0, 128 / (scale + 1) + 8);
+			height = test_range(1, 64 / (scale + 1) + 8);
+			for (k = 0; k < (height + 7) / 8 * width; k++) {Image[k] = (uint8_t)(test_rand() & test_rand());}
+			x = test_range(-width * scale - 4, actual.width + 4);
+			y = test_range(-height * scale - 12, actual.height + 4);
+
+			OLED_SetTarget(&expected);
+			ref_scaled(x, y, width, height, Image, scale);
+			OLED_SetTarget(&actual);
+			OLED_ShowImageScaled(x, y, width, height, Image, scale);
+			TEST_CHECK(equal_pixels(&expected, &actual), "%ux%u image enlarged by %d at (%d, %d) on %d*%d",
+			           width, height, scale, x, y, actual.width, actual.height);
+		}
+		else  // A string
+		{
+			if (scale < 1 || scale > 4) {scale = 1;}  // Not a valid factor of OLED_ShowStringScaled
+			random_text(str, test_range(0, 8));
+			font_size = (test_rand() & 1) ? OLED_8X16 : OLED_6X8;
+			x = test_range(-100, actual.width + 4);
+			y = test_range(-16 * scale - 4, actual.height + 4);
+
+			OLED_SetTarget(&expected);
+			for (p = str, cx = x; (code = OLED_DecodeChar(&p)) != 0; cx += width * scale)
+			{
+				glyph = OLED_GetGlyph(font_size, code, &width, &height);
+				ref_scaled(cx, y, width, height, glyph, scale);
+			}
+			OLED_SetTarget(&actual);
+			OLED_ShowStringScaled(x, y, str, font_size, scale);
+			TEST_CHECK(equal_pixels(&expected, &actual), "\"%s\" enlarged by %d at (%d, %d) on %d*%d",
+			           str, scale, x, y, actual.width, actual.height);
+		}
+	}
+	OLED_SetTarget(NULL);
+}
+
+int main(void)
+{
+	test_random();
+
+	return test_report("test_scaled");
+}
@@ -0,0 +1,294 @@
+/**
+ * @file   test_scene.c
+ * @brief  Host test of the retained scene and its dirty-tile rendering
+ *
+ * @note   Build: cc -std=gnu11 -O2 -ITests/host -ICore/Inc -ICore/Src -o test_scene Tests/test_scene.c -lm
+ *         (from the SSD1306 directory), -DOLED_SCENE_MAX_ITEMS=n tests other scene sizes
+ *
+ *         Random sequences of adding, moving, changing, hiding and removing texts, rectangles, lines and images
+ *         are rendered with OLED_SceneRender, unrotated and rotated by 90 degrees. After each render the screen
+ *         and the emulated panel must equal a full redraw of the visible items in slot order, and the panel may only
+ *         have received the 8*8 tiles under the old and new bounding boxes of the items changed since the last render.
+ */
+
+#include "oled_test.h"
+#include "oled.c"
+#include "oled_data.c"
+#include "oled_scene.c"
+
+/* The test's copy of a scene item */
+typedef struct
+{
+  uint8_t type, visible, style;
+  int16_t x0, y0, x1, y1;
+  const void *data;
+} Item_t;
+
+static Item_t Items[OLED_SCENE_MAX_ITEMS];
+static uint16_t Expected[16];  // Tiles that may be sent, like OLED_SceneDirty
+static uint8_t RefBuf[1024];
+static uint8_t Images[3][128 * 8];
+static char Numbers[OLED_SCENE_MAX_ITEMS][16];  // A string changed in place by each slot
+
+static const char *const Strings[] = {"", "a", "Scene", "你好，世界。", "x = 12345", "A string wider than the screen of 128 pixels"};
+
+/* The panel position of the screen pixel (x, y), the content is rotated clockwise */
+static void rotate_ref(uint8_t rotation, int x, int y, int *panel_x, int *panel_y)
+{
+	switch (rotation)
+	{
+		case OLED_ROTATION_90:  *panel_x = 127 - y; *panel_y = x;      break;
+		case OLED_ROTATION_180: *panel_x = 127 - x; *panel_y = 63 - y; break;
+		case OLED_ROTATION_270: *panel_x = y;       *panel_y = 63 - x; break;
+		default:                *panel_x = x;       *panel_y = y;      break;
+	}
+}
+
+/* Allow the tiles under the bounding box of an item to be sent */
+static void expect_item(const Item_t *item)
+{
+	int16_t x, y, width, height;
+	int tx, page;
+
+	if (item->type == OLED_SCENE_NONE || !item->visible) {return;}
+	switch (item->type)
+	{
+		case OLED_SCENE_TEXT:
+			x = item->x0;
+			y = item->y0;
+			width = OLED_MeasureString((const char *)item->data, item->style);
+			height = (item->style == OLED_8X16) ? 16 : 8;
+			break;
+		case OLED_SCENE_LINE:
+			x = (item->x0 < item->x1) ? item->x0 : item->x1;
+			y = (item->y0 < item->y1) ? item->y0 : item->y1;
+			width = abs(item->x1 - item->x0) + 1;
+			height = abs(item->y1 - item->y0) + 1;
+			break;
+		case OLED_SCENE_IMAGE:  // The padding bits of the last page are drawn as well
+			x = item->x0;
+			y = item->y0;
+			width = item->x1;
+			height = (item->y1 + 7) / 8 * 8;
+			break;
+		default:
+			x = item->x0;
+			y = item->y0;
+			width = item->x1;
+			height = item->y1;
+			break;
+	}
+	if (width <= 0 || height <= 0) {return;}
+
+	for (page = 0; page < OLED_Screen.height / 8; page++)
+	{
+		for (tx = 0; tx < OLED_Screen.width / 8; tx++)
+		{
+			if (tx * 8 < x + width && tx * 8 + 8 > x && page * 8 < y + height && page * 8 + 8 > y) {Expected[page] |= 0x01 << tx;}
+		}
+	}
+}
+
+/* Draw an item like a full redraw of the screen would */
+static void ref_draw(const Item_t *item)
+{
+	switch (item->type)
+	{
+		case OLED_SCENE_TEXT:  OLED_ShowString(item->x0, item->y0, (char *)item->data, item->style); break;
+		case OLED_SCENE_RECT:  if (item->x1 > 0 && item->y1 > 0) {OLED_DrawRectangle(item->x0, item->y0, item->x1, item->y1, item->style);} break;
+		case OLED_SCENE_LINE:  OLED_DrawLine(item->x0, item->y0, item->x1, item->y1); break;
+		case OLED_SCENE_IMAGE: if (item->x1 > 0 && item->y1 > 0) {OLED_ShowImage(item->x0, item->y0, item->x1, item->y1, item->data);} break;
+		default: break;
+	}
+}
+
+/* A random item, not in the scene yet */
+static void random_item(Item_t *item)
+{
+	memset(item, 0, sizeof(*item));
+	item->type = test_range(OLED_SCENE_TEXT, OLED_SCENE_IMAGE);
+	item->visible = 1;
+	item->x0 = test_range(-40, OLED_Screen.width + 8);
+	item->y0 = test_range(-40, OLED_Screen.height + 8);
+	switch (item->type)
+	{
+		case OLED_SCENE_TEXT:
+			item->style = (test_rand() & 1) ? OLED_8X16 : OLED_6X8;
+			item->data = Strings[test_rand() % (sizeof(Strings) / sizeof(Strings[0]))];
+			break;
+		case OLED_SCENE_RECT:
+			item->style = test_rand() & 1;
+			item->x1 = test_range(0, 60);
+			item->y1 = test_range(0, 40);
+			break;
+		case OLED_SCENE_LINE:
+			item->x1 = test_range(-40, OLED_Screen.width + 8);
+			item->y1 = test_range(-40, OLED_Screen.height + 8);
+			break;
+		default:
+			item->x1 = test_range(0, 60);
+			item->y1 = test_range(0, 40);
+			item->data = Images[test_rand() % 3];
+			break;
+	}
+}
+
+/* Apply a random change to the scene and to the copy, and expect the tiles it touches */
+static void random_change(void)
+{
+	Item_t item, *old;
+	int8_t id = test_range(0, OLED_SCENE_MAX_ITEMS - 1), free_id;
+	int16_t x, y;
+
+	old = &Items[id];
+	switch (test_rand() % 8)
+	{
+		case 0:
+		case 1:  // Add
+			random_item(&item);
+			for (free_id = 0; free_id < OLED_SCENE_MAX_ITEMS && Items[free_id].type != OLED_SCENE_NONE; free_id++) {}
+			switch (item.type)
+			{
+				case OLED_SCENE_TEXT: id = OLED_SceneAddText(item.x0, item.y0, item.data, item.style); break;
+				case OLED_SCENE_RECT: id = OLED_SceneAddRect(item.x0, item.y0, item.x1, item.y1, item.style); break;
+				case OLED_SCENE_LINE: id = OLED_SceneAddLine(item.x0, item.y0, item.x1, item.y1); break;
+				default:              id = OLED_SceneAddImage(item.x0, item.y0, item.x1, item.y1, item.data); break;
+			}
+			TEST_CHECK(id == (free_id < OLED_SCENE_MAX_ITEMS ? free_id : -1), "add: ID %d, the first free slot is %d", id, free_id);
+			if (id >= 0)
+			{
+				Items[id] = item;
+				expect_item(&item);
+			}
+			break;
+
+		case 2:
+		case 3:  // Move
+			expect_item(old);
+			x = test_range(-40, OLED_Screen.width + 8);
+			y = test_range(-40, OLED_Screen.height + 8);
+			OLED_SceneMove(id, x, y);
+			if (old->type == OLED_SCENE_LINE)
+			{
+				old->x1 += x - old->x0;
+				old->y1 += y - old->y0;
+			}
+			if (old->type != OLED_SCENE_NONE)
+			{
+				old->x0 = x;
+				old->y0 = y;
+			}
+			expect_item(old);
+			break;
+
+		case 4:  // Show or hide
+			item = *old;
+			item.visible = 1;
+			x = test_rand() & 1;
+			if (old->visible != x) {expect_item(&item);}
+			old->visible = x;
+			OLED_SceneSetVisible(id, x);
+			break;
+
+		case 5:  // Change the content
+			expect_item(old);
+			if (old->type == OLED_SCENE_TEXT)
+			{
+				if (test_rand() & 1) {old->data = Strings[test_rand() % (sizeof(Strings) / sizeof(Strings[0]))];}
+				else {sprintf(Numbers[id], "%ld", (long)test_range(-100000, 100000)); old->data = Numbers[id];}
+				OLED_SceneSetText(id, old->data);
+			}
+			else
+			{
+				if (old->type == OLED_SCENE_IMAGE) {old->data = Images[test_rand() % 3];}
+				OLED_SceneSetImage(id, old->data);
+			}
+			expect_item(old);
+			break;
+
+		default:  // Remove
+			expect_item(old);
+			OLED_SceneRemove(id);
+			old->type = OLED_SCENE_NONE;
+			break;
+	}
+}
+
+/* Compare the screen and the panel with a full redraw, and the tiles sent with the expected ones */
+static void check_screen(uint8_t rotation, int step)
+{
+	OLED_Surface_t ref;
+	int id, x, y, panel_x, panel_y, expected;
+
+	OLED_SurfaceInit(&ref, RefBuf, OLED_Screen.width, OLED_Screen.height);
+	OLED_SetTarget(&ref);
+	OLED_Clear();
+	for (id = 0; id < OLED_SCENE_MAX_ITEMS; id++)
+	{
+		if (Items[id].type != OLED_SCENE_NONE && Items[id].visible) {ref_draw(&Items[id]);}
+	}
+	OLED_SetTarget(NULL);
+
+	for (y = 0; y < OLED_Screen.height && !test_failures; y++)
+	{
+		for (x = 0; x < OLED_Screen.width && !test_failures; x++)
+		{
+			rotate_ref(rotation, x, y, &panel_x, &panel_y);
+			expected = (RefBuf[y / 8 * OLED_Screen.width + x] >> (y % 8)) & 0x01;
+			TEST_CHECK(OLED_GetPoint(x, y) == expected, "rotation %u, step %d: pixel (%d, %d) of the screen is %d",
+			           rotation, step, x, y, !expected);
+			TEST_CHECK(test_panel_pixel(panel_x, panel_y) == expected, "rotation %u, step %d: pixel (%d, %d) of the panel is %d",
+			           rotation, step, x, y, !expected);
+			TEST_CHECK(!test_panel_written(panel_x, panel_y) || (Expected[y / 8] & (0x01 << (x / 8))),
+			           "rotation %u, step %d: tile (%d, %d) was sent, nothing changed under it", rotation, step, x / 8, y / 8);
+		}
+	}
+}
+
+static void test_scene(uint8_t rotation)
+{
+	int step, n, i;
+
+	OLED_SetRotation(rotation);
+	OLED_SceneClear();
+	memset(Items, 0, sizeof(Items));
+	OLED_SceneRender();
+
+	for (step = 0; step < 3000 && !test_failures; step++)
+	{
+		memset(Expected, 0, sizeof(Expected));
+		for (n = test_range(1, 4); n > 0; n--) {random_change();}
+
+		/* Content drawn outside the scene is overwritten in dirty tiles only */
+		if (step % 50 == 0)
+		{
+			for (i = 0; i < 1024; i++) {((uint8_t *)OLED_DisplayBuf)[i] = (uint8_t)test_rand();}
+			OLED_Update();
+			OLED_SceneMarkDirty(0, 0, OLED_Screen.width, OLED_Screen.height);
+			memset(Expected, 0xFF, sizeof(Expected));
+		}
+
+		memset(TEST_Written, 0, sizeof(TEST_Written));
+		OLED_SceneRender();
+		check_screen(rotation, step);
+
+		/* Nothing changed, nothing is sent */
+		memset(TEST_Written, 0, sizeof(TEST_Written));
+		memset(Expected, 0, sizeof(Expected));
+		OLED_SceneRender();
+		check_screen(rotation, step);
+	}
+	OLED_SetRotation(OLED_ROTATION_0);
+}
+
+int main(void)
+{
+	int i;
+
+	for (i = 0; i < (int)sizeof(Images); i++) {((uint8_t *)Images)[i] = (uint8_t)test_rand();}
+	OLED_Init();
+	test_scene(OLED_ROTATION_0);
+	test_scene(OLED_ROTATION_90);
+
+	return test_report("test_scene");
+}
@@ -0,0 +1,226 @@
+/**
+ * @file   test_sprite.c
+ * @brief  Host test of the sprite compositor against a per-pixel composition
+ *
+ * @note   Build: cc -std=gnu11 -O2 -ITests/host -ICore/Inc -ICore/Src -o test_sprite Tests/test_sprite.c -lm
+ *         (from the SSD1306 directory), -DOLED_SPRITE_MAX=n tests other pool sizes
+ *
+ *         Random sequences of creating, moving, re-imaging, re-ordering, hiding and destroying overlapping sprites,
+ *         with and without masks and at positions off every edge, are sent with OLED_SpriteUpdate over a random
+ *         background and over no background (OLED_ClearArea), unrotated and rotated by 90 degrees.
+ *         After each update the screen and the emulated panel must equal every pixel composited on its own:
+ *         the background, then the opaque pixels of the visible sprites by z and by ID.
+ */
+
+#include "oled_test.h"
+#include "oled.c"
+#include "oled_data.c"
+#include "oled_sprite.c"
+
+/* The test's copy of a sprite */
+typedef struct
+{
+  uint8_t in_use, visible, width, height;
+  int16_t x, y;
+  int8_t z;
+  const uint8_t *image, *mask;
+} Sprite_t;
+
+static Sprite_t Sprites[OLED_SPRITE_MAX];
+static uint8_t BackgroundBuf[1024];
+static uint8_t Images[4][40 * 4], Masks[4][40 * 4];
+
+/* The panel position of the screen pixel (x, y), the content is rotated clockwise */
+static void rotate_ref(uint8_t rotation, int x, int y, int *panel_x, int *panel_y)
+{
+	switch (rotation)
+	{
+		case OLED_ROTATION_90:  *panel_x = 127 - y; *panel_y = x;      break;
+		case OLED_ROTATION_180: *panel_x = 127 - x; *panel_y = 63 - y; break;
+		case OLED_ROTATION_270: *panel_x = y;       *panel_y = 63 - x; break;
+		default:                *panel_x = x;       *panel_y = y;      break;
+	}
+}
+
+/* Bit (x, y) of page format data of the given width */
+static int data_pixel(const uint8_t *data, int width, int x, int y)
+{
+	return (data[y / 8 * width + x] >> (y % 8)) & 0x01;
+}
+
+/* The IDs of the sprites in use, by z and then by ID */
+static int sort_sprites(int8_t *order)
+{
+	int z, id, count = 0;
+
+	for (z = -128; z <= 127; z++)
+	{
+		for (id = 0; id < OLED_SPRITE_MAX; id++)
+		{
+			if (Sprites[id].in_use && Sprites[id].z == z) {order[count++] = id;}
+		}
+	}
+	return count;
+}
+
+/* The pixel (x, y) of the screen composited on its own */
+static int ref_pixel(const OLED_Surface_t *background, const int8_t *order, int count, int x, int y)
+{
+	int pixel = (background != NULL) ? data_pixel(background->buf, background->width, x, y) : 0;
+	int i, sx, sy;
+
+	for (i = 0; i < count; i++)
+	{
+		const Sprite_t *sprite = &Sprites[order[i]];
+
+		sx = x - sprite->x;
+		sy = y - sprite->y;
+		if (!sprite->visible || sx < 0 || sx >= sprite->width || sy < 0 || sy >= sprite->height) {continue;}
+		if (sprite->mask == NULL || data_pixel(sprite->mask, sprite->width, sx, sy))
+		{
+			pixel = data_pixel(sprite->image, sprite->width, sx, sy);
+		}
+	}
+	return pixel;
+}
+
+/* Apply a random change to the compositor and to the copy */
+static void random_change(void)
+{
+	int8_t id = test_range(0, OLED_SPRITE_MAX - 1), free_id;
+	Sprite_t *sprite = &Sprites[id];
+	int k = test_rand() % 4;
+	const uint8_t *mask = (test_rand() % 3) ? Masks[k] : NULL;
+	int16_t x = test_range(-45, OLED_Screen.width + 5), y = test_range(-35, OLED_Screen.height + 5);
+	int8_t z = test_range(-2, 2);
+
+	switch (test_rand() % 7)
+	{
+		case 0:
+		case 1:  // Create
+		{
+			uint8_t width = test_range(0, 40), height = test_range(0, 30);
+
+			for (free_id = 0; free_id < OLED_SPRITE_MAX && Sprites[free_id].in_use; free_id++) {}
+			id = OLED_SpriteCreate(x, y, width, height, Images[k], mask, z);
+			TEST_CHECK(id == (free_id < OLED_SPRITE_MAX ? free_id : -1), "create: ID %d, the first free slot is %d", id, free_id);
+			if (id >= 0)
+			{
+				Sprite_t created = {1, 1, width, height, x, y, z, Images[k], mask};
+
+				Sprites[id] = created;
+			}
+			break;
+		}
+
+		case 2:
+		case 3:  // Move
+			OLED_SpriteMove(id, x, y);
+			sprite->x = x;
+			sprite->y = y;
+			break;
+
+		case 4:  // Next frame
+			OLED_SpriteSetImage(id, Images[k], mask);
+			sprite->image = Images[k];
+			sprite->mask = mask;
+			break;
+
+		case 5:  // Z-order, or show and hide
+			if (test_rand() & 1)
+			{
+				OLED_SpriteSetZ(id, z);
+				sprite->z = z;
+			}
+			else
+			{
+				sprite->visible = test_rand() & 1;
+				OLED_SpriteSetVisible(id, sprite->visible ? 2 : 0);
+			}
+			break;
+
+		default:  // Destroy
+			OLED_SpriteDestroy(id);
+			sprite->in_use = 0;
+			break;
+	}
+}
+
+/* Compare the screen and the panel with the per-pixel composition */
+static void check_screen(const OLED_Surface_t *background, uint8_t rotation, int step)
+{
+	int8_t order[OLED_SPRITE_MAX];
+	int count = sort_sprites(order);
+	int x, y, panel_x, panel_y, expected;
+
+	for (y = 0; y < OLED_Screen.height && !test_failures; y++)
+	{
+		for (x = 0; x < OLED_Screen.width && !test_failures; x++)
+		{
+			rotate_ref(rotation, x, y, &panel_x, &panel_y);
+			expected = ref_pixel(background, order, count, x, y);
+			TEST_CHECK(OLED_GetPoint(x, y) == expected, "rotation %u, %s background, step %d: pixel (%d, %d) of the screen is %d",
+			           rotation, background ? "random" : "no", step, x, y, !expected);
+			TEST_CHECK(test_panel_pixel(panel_x, panel_y) == expected, "rotation %u, %s background, step %d: pixel (%d, %d) of the panel is %d",
+			           rotation, background ? "random" : "no", step, x, y, !expected);
+		}
+	}
+}
+
+static void test_sprites(const OLED_Surface_t *background, uint8_t rotation)
+{
+	int step, n, i;
+
+	/* The application shows the background once, the compositor only restores areas from it */
+	OLED_SpriteSetBackground(background);
+	if (background != NULL) {memcpy(OLED_DisplayBuf, background->buf, 1024);}
+	else {OLED_Clear();}
+	OLED_Update();
+
+	for (step = 0; step < 4000 && !test_failures; step++)
+	{
+		for (n = test_range(1, 4); n > 0; n--) {random_change();}
+		OLED_SpriteUpdate();
+		check_screen(background, rotation, step);
+	}
+
+	/* Destroying every sprite restores the background */
+	for (i = 0; i < OLED_SPRITE_MAX; i++)
+	{
+		OLED_SpriteDestroy(i);
+		Sprites[i].in_use = 0;
+	}
+	OLED_SpriteUpdate();
+	check_screen(background, rotation, step);
+
+	/* Nothing changed, nothing is sent */
+	memset(TEST_Written, 0, sizeof(TEST_Written));
+	OLED_SpriteUpdate();
+	for (i = 0; i < 1024; i++) {TEST_CHECK(((uint8_t *)TEST_Written)[i] == 0, "rotation %u: update without a change sent data", rotation);}
+}
+
+int main(void)
+{
+	static const uint8_t rotations[] = {OLED_ROTATION_0, OLED_ROTATION_90};
+	OLED_Surface_t background;
+	int i, k;
+
+	for (i = 0; i < (int)sizeof(Images); i++)
+	{
+		((uint8_t *)Images)[i] = (uint8_t)test_rand();
+		((uint8_t *)Masks)[i] = (uint8_t)(test_rand() | test_rand());
+	}
+	OLED_Init();
+
+	for (k = 0; k < 2; k++)
+	{
+		OLED_SetRotation(rotations[k]);
+		OLED_SurfaceInit(&background, BackgroundBuf, OLED_Screen.width, OLED_Screen.height);
+		for (i = 0; i < 1024; i++) {BackgroundBuf[i] = (uint8_t)test_rand();}
+		test_sprites(&background, rotations[k]);
+		test_sprites(NULL, rotations[k]);
+	}
+	OLED_SetRotation(OLED_ROTATION_0);
+
+	return test_report("test_sprite");
+}
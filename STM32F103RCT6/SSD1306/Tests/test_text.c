@@ -0,0 +1,107 @@
+/**
+ * @file   test_text.c
+ * @brief  Host test of the text run renderer behind OLED_ShowString and OLED_Printf, with the glyph cache
+ *
+ * @note   Build: cc -std=gnu11 -O2 -ITests/host -ICore/Inc -ICore/Src -o test_text Tests/test_text.c -lm
+ *         (from the SSD1306 directory), -DOLED_GLYPH_CACHE_SLOTS=n tests other cache sizes
+ *
+ *         Random strings of more distinct characters than cache slots are drawn at random positions on surfaces
+ *         of several sizes filled with random content. Both functions must equal the glyphs drawn one by one with
+ *         OLED_ShowImage, so a cache slot replaced while a batch still uses it shows up as a wrong glyph.
+ */
+
+#include "oled_test.h"
+#include "oled.c"
+#include "oled_data.c"
+
+static uint8_t ExpectedBuf[5 * 300], ActualBuf[5 * 300];  // 300*40
+
+static const char *const Chars[] = {"，", "。", "你", "好", "世", "界", "中"};  // "中" is not in the font
+
+/* A random string of ASCII and Chinese characters */
+static void random_text(char *str, int length)
+{
+	int i;
+
+	str[0] = '\0';
+	for (i = 0; i < length; i++)
+	{
+		if (test_rand() % 4 == 0) {strcat(str, Chars[test_rand() % (sizeof(Chars) / sizeof(Chars[0]))]);}
+		else {str[strlen(str) + 1] = '\0'; str[strlen(str)] = (char)test_range(' ', '~');}
+	}
+}
+
+/* Draw the glyphs one by one like the original OLED_ShowString, until the right edge of the drawing target */
+static void ref_string(int16_t x, int16_t y, const char *str, uint8_t font_size)
+{
+	const char *p = str;
+	const uint8_t *glyph;
+	uint8_t width, height;
+	uint32_t code;
+
+	while (x < OLED_Target->width && (code = OLED_DecodeChar(&p)) != 0)
+	{
+		glyph = OLED_GetGlyph(font_size, code, &width, &height);
+		OLED_ShowImage(x, y, width, height, glyph);
+		x += width;
+	}
+}
+
+static void test_random(void)
+{
+	static const int16_t sizes[][2] = {{128, 64}, {100, 37}, {300, 20}, {64, 128 / 4}};
+	OLED_Surface_t expected, actual;
+	char str[256];
+	int n, k, size;
+	int16_t x, y;
+	uint8_t font_size;
+
+	for (n = 0; n < 6000 && !test_failures; n++)
+	{
+		k = test_rand() % (sizeof(sizes) / sizeof(sizes[0]));
+		OLED_SurfaceInit(&expected, ExpectedBuf, sizes[k][0], sizes[k][1]);
+		OLED_SurfaceInit(&actual, ActualBuf, sizes[k][0], sizes[k][1]);
+		size = OLED_SURFACE_SIZE(sizes[k][0], sizes[k][1]);
+
+		random_text(str, test_range(0, 50));
+		font_size = (test_rand() & 1) ? OLED_8X16 : OLED_6X8;
+		x = test_range(-60, sizes[k][0] + 4);
+		y = test_range(-20, sizes[k][1] + 4);
+
+		for (k = 0; k < size; k++) {ExpectedBuf[k] = ActualBuf[k] = (uint8_t)test_rand();}
+		OLED_SetTarget(&expected);
+		ref_string(x, y, str, font_size);
+
+		OLED_SetTarget(&actual);
+		if (n & 1) {OLED_ShowString(x, y, str, font_size);}
+		else {OLED_Printf(x, y, font_size, "%s", str);}
+		TEST_CHECK(memcmp(ExpectedBuf, ActualBuf, size) == 0, "%s \"%s\" at (%d, %d) on %d*%d",
+		           (n & 1) ? "OLED_ShowString" : "OLED_Printf", str, x, y, actual.width, actual.height);
+	}
+	OLED_SetTarget(NULL);
+}
+
+/* The run takes shifted glyphs from the cache: a repeated string misses each glyph once */
+static void test_cache(void)
+{
+	uint32_t hits, misses;
+
+	OLED_GlyphCacheClear();
+	OLED_ShowString(0, 3, "abab", OLED_8X16);
+	OLED_Printf(0, 19, OLED_8X16, "%s", "ba");  // The same shift
+	OLED_ShowString(0, 40, "abab", OLED_8X16);  // Page-aligned, not cached
+	OLED_GlyphCacheStats(&hits, &misses);
+#if OLED_GLYPH_CACHE_SLOTS >= 2
+	TEST_CHECK(hits == 4 && misses == 2, "glyph cache: %u hits and %u misses", (unsigned)hits, (unsigned)misses);
+#else
+	TEST_CHECK(hits + misses == (OLED_GLYPH_CACHE_SLOTS > 0 ? 6 : 0), "glyph cache: %u lookups", (unsigned)(hits + misses));
+#endif
+}
+
+int main(void)
+{
+	test_random();
+	test_cache();
+
+	return test_report("test_text");
+}
@@ -0,0 +1,104 @@
+/**
+ * @file   test_transition.c
+ * @brief  Host test of the screen transitions, built with the debug registers declared like the CMSIS headers do
+ *
+ * @note   Build: cc -std=gnu11 -O2 -ITests/host -ICore/Inc -ICore/Src -o test_transition Tests/test_transition.c -lm
+ *         (from the SSD1306 directory)
+ *
+ *         DWT and CoreDebug point to the Cortex-M3 addresses, which are not mapped on the host,
+ *         so the test crashes if a host build touches the cycle counter.
+ *         Every transition is run in the normal and a rotated orientation until it ends,
+ *         the display memory array and the emulated panel must then show the new screen.
+ */
+
+#include "oled_test.h"
+
+/* The debug registers as core_cm3.h declares them, main.h includes it in target builds */
+typedef struct
+{
+  volatile uint32_t CTRL;
+  volatile uint32_t CYCCNT;
+} DWT_Type;
+
+typedef struct
+{
+  volatile uint32_t DHCSR;
+  volatile uint32_t DCRSR;
+  volatile uint32_t DCRDR;
+  volatile uint32_t DEMCR;
+} CoreDebug_Type;
+
+#define DWT                         ((DWT_Type *)0xE0001000UL)
+#define CoreDebug                   ((CoreDebug_Type *)0xE000EDF0UL)
+#define DWT_CTRL_CYCCNTENA_Msk      (1UL << 0)
+#define CoreDebug_DEMCR_TRCENA_Msk  (1UL << 24)
+
+#include "oled.c"
+#include "oled_data.c"
+#include "oled_transition.c"
+
+static uint8_t FromBuf[1024], ToBuf[1024];
+
+/* The panel position of the screen pixel (x, y), the content is rotated clockwise */
+static void rotate_ref(uint8_t rotation, int x, int y, int *panel_x, int *panel_y)
+{
+	*panel_x = (rotation == OLED_ROTATION_90) ? 127 - y : x;
+	*panel_y = (rotation == OLED_ROTATION_90) ? x : y;
+}
+
+static void test_transition(uint8_t rotation, uint8_t type)
+{
+	OLED_Transition_t transition;
+	OLED_Surface_t from, to;
+	int k, x, y, panel_x, panel_y, ticks = 0;
+
+	OLED_SetRotation(rotation);
+	OLED_SurfaceInit(&from, FromBuf, OLED_Screen.width, OLED_Screen.height);
+	OLED_SurfaceInit(&to, ToBuf, OLED_Screen.width, OLED_Screen.height);
+	for (k = 0; k < 1024; k++)
+	{
+		FromBuf[k] = (uint8_t)test_rand();
+		ToBuf[k] = (uint8_t)test_rand();
+	}
+
+	OLED_TransitionStart(&transition, &from, &to, type, 300, (type & 1) ? OLED_EaseInOut : NULL);
+	do
+	{
+		TEST_Tick += 7;
+		ticks++;
+	} while (OLED_TransitionTick(&transition) && ticks < 1000);
+
+	TEST_CHECK(ticks < 1000, "rotation %u, type %u: the transition does not end", rotation, type);
+	TEST_CHECK(transition.frames > 1, "rotation %u, type %u: %u frames", rotation, type, transition.frames);
+	TEST_CHECK(memcmp(OLED_DisplayBuf, ToBuf, sizeof(ToBuf)) == 0, "rotation %u, type %u: the last frame is not the new screen", rotation, type);
+
+	OLED_SetTarget(&to);
+	for (y = 0; y < OLED_Screen.height; y++)
+	{
+		for (x = 0; x < OLED_Screen.width; x++)
+		{
+			rotate_ref(rotation, x, y, &panel_x, &panel_y);
+			if (test_panel_pixel(panel_x, panel_y) != OLED_GetPoint(x, y))
+			{
+				TEST_CHECK(0, "rotation %u, type %u: the panel differs at (%d, %d)", rotation, type, x, y);
+				y = OLED_Screen.height;
+				break;
+			}
+		}
+	}
+	OLED_SetTarget(NULL);
+}
+
+int main(void)
+{
+	uint8_t type;
+
+	OLED_Init();
+	for (type = OLED_TRANSITION_SLIDE_LEFT; type <= OLED_TRANSITION_WIPE_DOWN; type++)
+	{
+		test_transition(OLED_ROTATION_0, type);
+		test_transition(OLED_ROTATION_90, type);
+	}
+
+	return test_report("test_transition");
+}
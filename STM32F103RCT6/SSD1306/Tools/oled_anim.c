@@ -0,0 +1,145 @@
+/**
+ * @file   oled_anim.c
+ * @brief  Host-side encoder for the XOR-delta animations of OLED_AnimStart/OLED_AnimTick
+ *
+ * @note   Build: cc -O2 -o oled_anim oled_anim.c
+ *         Usage: oled_anim [-n name] [-t milliseconds] frame0.pbm frame1.pbm ...
+ *
+ *         All frames are binary PBM (P4) images of the same size. The keyframe, the delta records
+ *         and the OLED_Animation_t are written to stdout in the style of oled_data.c.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "oled_tool.h"
+
+#define MAX_FRAMES 255
+
+/* Print a byte array in the style of oled_data.c */
+static void print_array(const char *name, const char *suffix, const uint8_t *data, size_t size)
+{
+	size_t k;
+
+	printf("static const uint8_t %s%s[] = {", name, suffix);
+	for (k = 0; k < size; k++)
+	{
+		printf("%s0x%02X,", (k % 16 == 0) ? "\n\t" : "", data[k]);
+	}
+	printf("\n};\n\n");
+}
+
+/* Append the delta record that turns frame a into frame b, returns the record size */
+static size_t encode_delta(const uint8_t *a, const uint8_t *b, int width, int pages, uint8_t *dst, uint8_t *xor_buf)
+{
+	int x0 = width, x1 = -1, p0 = pages, p1 = -1, x, p;
+	size_t n = 0;
+
+	/* Bounding box of the changed page bytes */
+	for (p = 0; p < pages; p++)
+	{
+		for (x = 0; x < width; x++)
+		{
+			if (a[p * width + x] != b[p * width + x])
+			{
+				if (x < x0) {x0 = x;}
+				if (x > x1) {x1 = x;}
+				if (p < p0) {p0 = p;}
+				if (p > p1) {p1 = p;}
+			}
+		}
+	}
+
+	if (x1 < 0)
+	{
+		memset(dst, 0, 4);
+		return 4;
+	}
+
+	for (p = p0; p <= p1; p++)
+	{
+		for (x = x0; x <= x1; x++)
+		{
+			xor_buf[n++] = a[p * width + x] ^ b[p * width + x];
+		}
+	}
+
+	dst[0] = (uint8_t)x0;
+	dst[1] = (uint8_t)p0;
+	dst[2] = (uint8_t)(x1 - x0 + 1);
+	dst[3] = (uint8_t)(p1 - p0 + 1);
+	return 4 + packbits(xor_buf, n, dst + 4);
+}
+
+int main(int argc, char **argv)
+{
+	const char *name = "Anim";
+	int frame_time = 100, count = 0, width = 0, height = 0, w, h, pages, i;
+	uint8_t *frames[MAX_FRAMES], *deltas, *xor_buf;
+	size_t size, deltas_size = 0;
+	FILE *fp;
+
+	for (i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {name = argv[++i];}
+		else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {frame_time = atoi(argv[++i]);}
+		else if (count < MAX_FRAMES)
+		{
+			fp = fopen(argv[i], "rb");
+			if (fp == NULL)
+			{
+				perror(argv[i]);
+				return 1;
+			}
+			frames[count] = load_pbm(fp, &w, &h);
+			fclose(fp);
+			if (frames[count] == NULL)
+			{
+				fprintf(stderr, "%s: not a binary PBM (P4) image\n", argv[i]);
+				return 1;
+			}
+			if (count > 0 && (w != width || h != height))
+			{
+				fprintf(stderr, "%s: %dx%d does not match the first frame (%dx%d)\n", argv[i], w, h, width, height);
+				return 1;
+			}
+			width = w;
+			height = h;
+			count++;
+		}
+	}
+	if (count < 2 || frame_time <= 0 || frame_time > 65535)
+	{
+		fprintf(stderr, "usage: %s [-n name] [-t milliseconds] frame0.pbm frame1.pbm ...\n", argv[0]);
+		return 1;
+	}
+	if (width > 128 || height > 64)
+	{
+		fprintf(stderr, "%dx%d is larger than the screen\n", width, height);
+		return 1;
+	}
+
+	pages = (height + 7) / 8;
+	size = (size_t)pages * width;
+	deltas = malloc(count * (4 + size + (size + 127) / 128));
+	xor_buf = malloc(size);
+
+	/* The last record leads back to the keyframe so that the animation loops */
+	for (i = 0; i < count; i++)
+	{
+		deltas_size += encode_delta(frames[i], frames[(i + 1) % count], width, pages, deltas + deltas_size, xor_buf);
+	}
+
+	printf("/* %s, %d pixels wide, %d pixels high, %d frames (%zu -> %zu bytes) */\n",
+		name, width, height, count, size * count, size + deltas_size);
+	print_array(name, "_Keyframe", frames[0], size);
+	print_array(name, "_Deltas", deltas, deltas_size);
+	printf("const OLED_Animation_t %s = {%d, %d, %d, %d, %s_Keyframe, %s_Deltas};\n",
+		name, width, height, count, frame_time, name, name);
+
+	for (i = 0; i < count; i++) {free(frames[i]);}
+	free(deltas);
+	free(xor_buf);
+	return 0;
+}
@@ -0,0 +1,141 @@
+/**
+ * @file   oled_cjk_index.c
+ * @brief  Host-side generator of the sorted index of the Chinese font library OLED_CF16x16
+ *
+ * @note   Build: cc -O2 -o oled_cjk_index oled_cjk_index.c
+ *         Usage: oled_cjk_index [-g] Core/Src/oled_data.c
+ *
+ *         The character strings of OLED_CF16x16 are read from oled_data.c in the order they are defined
+ *         and decoded like OLED_DecodeChar: UTF-8 to the Unicode codepoint, or with -g GB2312 to the 2-byte code.
+ *         The index sorted by codepoint is written to stdout, it replaces OLED_CF16x16_Index in oled_data.c.
+ *         Run it again whenever characters are added to or removed from the font library.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_CELLS 65535
+
+typedef struct
+{
+	uint32_t code;
+	unsigned cell;
+	char text[8];
+} entry_t;
+
+/* Sort by codepoint */
+static int compare(const void *a, const void *b)
+{
+	uint32_t ka = ((const entry_t *)a)->code, kb = ((const entry_t *)b)->code;
+
+	return (ka > kb) - (ka < kb);
+}
+
+/* Decode a character like OLED_DecodeUTF8/OLED_DecodeGB2312, returns 0 if the bytes are not exactly one character */
+static uint32_t decode(const uint8_t *p, size_t size, int gb2312)
+{
+	uint32_t code;
+	size_t length, k;
+
+	if (gb2312)
+	{
+		if (size == 2 && p[0] >= 0x80) {return ((uint32_t)p[0] << 8) | p[1];}
+		return 0;
+	}
+
+	if ((p[0] & 0xE0) == 0xC0) {length = 2; code = p[0] & 0x1F;}
+	else if ((p[0] & 0xF0) == 0xE0) {length = 3; code = p[0] & 0x0F;}
+	else if ((p[0] & 0xF8) == 0xF0) {length = 4; code = p[0] & 0x07;}
+	else {return 0;}
+	if (size != length) {return 0;}
+
+	for (k = 1; k < length; k++)
+	{
+		if ((p[k] & 0xC0) != 0x80) {return 0;}
+		code = (code << 6) | (p[k] & 0x3F);
+	}
+	return code;
+}
+
+int main(int argc, char **argv)
+{
+	static entry_t entries[MAX_CELLS];
+	char line[1024], *p, *end;
+	unsigned count = 0, cells = 0, i, k;
+	int inside = 0, gb2312 = 0;
+	const char *path;
+	FILE *fp;
+
+	if (argc == 3 && strcmp(argv[1], "-g") == 0) {gb2312 = 1;}
+	else if (argc != 2)
+	{
+		fprintf(stderr, "usage: %s [-g] oled_data.c\n", argv[0]);
+		return 1;
+	}
+	path = argv[argc - 1];
+
+	fp = fopen(path, "rb");
+	if (fp == NULL)
+	{
+		perror(path);
+		return 1;
+	}
+
+	while (fgets(line, sizeof(line), fp) != NULL)
+	{
+		if (!inside)
+		{
+			inside = (strstr(line, "OLED_CF16x16[] = {") != NULL);
+			continue;
+		}
+		if (strncmp(line, "};", 2) == 0) {break;}
+
+		/* A cell starts with its character string on a line of its own */
+		for (p = line; *p == ' ' || *p == '\t'; p++) {}
+		if (*p != '"') {continue;}
+		end = strchr(p + 1, '"');
+		if (end == NULL) {continue;}
+
+		cells++;
+		if (end == p + 1) {continue;}  // The default figure is not indexed
+		k = end - p - 1;
+		entries[count].code = (k <= 4) ? decode((const uint8_t *)p + 1, k, gb2312) : 0;
+		if (entries[count].code == 0)
+		{
+			fprintf(stderr, "%s: cell %u is not a single %s character\n", path, cells - 1, gb2312 ? "GB2312" : "UTF-8");
+			return 1;
+		}
+		entries[count].cell = cells - 1;
+		memcpy(entries[count].text, p + 1, k);
+		entries[count].text[k] = '\0';
+		count++;
+	}
+	fclose(fp);
+
+	if (!inside)
+	{
+		fprintf(stderr, "%s: OLED_CF16x16 not found\n", path);
+		return 1;
+	}
+
+	qsort(entries, count, sizeof(entries[0]), compare);
+	for (i = 1; i < count; i++)
+	{
+		if (entries[i].code == entries[i - 1].code)
+		{
+			fprintf(stderr, "%s: \"%s\" is defined twice\n", path, entries[i].text);
+			return 1;
+		}
+	}
+
+	printf("/* Index of OLED_CF16x16 sorted by codepoint, generated by Tools/oled_cjk_index.c */\n");
+	printf("const ChineseIndex_t OLED_CF16x16_Index[] = {\n");
+	for (i = 0; i < count; i++)
+	{
+		printf("\t{0x%04lX, %u},  // %s\n", (unsigned long)entries[i].code, entries[i].cell, entries[i].text);
+	}
+	printf("};\n");
+	return 0;
+}
@@ -0,0 +1,786 @@
+/**
+ * @file   oled_compile.c
+ * @brief  Host-side compiler of bitmap fonts and images to the page format tables of the driver
+ *
+ * @note   Build: cc -O2 -o oled_compile oled_compile.c
+ *         Usage: oled_compile font [-m table|packed|cells] [-n name] [-s WIDTHxHEIGHT]
+ *                              [-r FIRST-LAST]... [-t chars.txt] font.bdf|font.pcf
+ *                oled_compile image [-n name] [-c] [-i] [-l threshold] image.pbm|image.png
+ *
+ *         Fonts are read from BDF or PCF files, only the glyphs in the ranges of -r (codepoints in hex,
+ *         like 4E00-9FFF) and the characters of the UTF-8 text file of -t are kept, all glyphs without them.
+ *         Each glyph is placed in a cell of the size of the font bounding box (or -s), on the baseline of the font.
+ *
+ *           table   The cells in page format, the glyph data of an OLED_FontRange_t with its index
+ *                   and an OLED_Font_t, the fastest path for OLED_ShowImage and the glyph cache.
+ *           packed  An OLED_PackedFont_t with the bounding boxes bit-packed and the advance widths of the font.
+ *           cells   OLED_CF16x16 and OLED_CF16x16_Index for oled_data.c, in 16*16 cells, the default figure last.
+ *
+ *         Images are binary PBM (P4) or non-interlaced PNG files, the page format array for OLED_ShowImage
+ *         is written, or with -c the PackBits compressed array for OLED_ShowImageRLE.
+ *         Dark pixels are lit like in PBM, -l sets the luminance threshold of PNG pixels, -i inverts the image.
+ *         Everything is written to stdout in the style of oled_data.c.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "oled_tool.h"
+
+#define MAX_RANGES  64
+#define OFFSET_STEP 8  // OLED_PACKED_OFFSET_STEP in oled_data.h
+
+/* A glyph of the font file, one byte per pixel, row by row */
+typedef struct
+{
+	uint32_t code;
+	int advance;
+	int width, height, x_offset, y_offset;  // Bounding box, the offsets from the origin on the baseline, y upwards
+	uint8_t *pixels;
+	int selected;
+} glyph_t;
+
+typedef struct
+{
+	glyph_t *glyphs;
+	int count;
+	int box_width, box_height, box_x, box_y;  // Font bounding box
+	int ascent, descent;
+	uint32_t default_char;
+} font_t;
+
+/* The default figure at the end of OLED_CF16x16, a box with a question mark inside */
+static const uint8_t default_figure[32] = {
+	0xFF,0x01,0x01,0x01,0x31,0x09,0x09,0x09,0x09,0x89,0x71,0x01,0x01,0x01,0x01,0xFF,
+	0xFF,0x80,0x80,0x80,0x80,0x80,0x80,0x96,0x81,0x80,0x80,0x80,0x80,0x80,0x80,0xFF,
+};
+
+/* Add an empty glyph to the font */
+static glyph_t *add_glyph(font_t *font)
+{
+	glyph_t *glyphs = realloc(font->glyphs, (font->count + 1) * sizeof(glyph_t));
+
+	if (glyphs == NULL) {exit(1);}
+	font->glyphs = glyphs;
+	memset(&glyphs[font->count], 0, sizeof(glyph_t));
+	return &glyphs[font->count++];
+}
+
+/* Read a BDF font */
+static int load_bdf(FILE *fp, font_t *font)
+{
+	char line[1024];
+	glyph_t *glyph = NULL;
+	int encoding = -1, advance = 0, w, h, x, y, rows = -1, k;
+	unsigned value;
+
+	if (fgets(line, sizeof(line), fp) == NULL || strncmp(line, "STARTFONT", 9) != 0) {return -1;}
+
+	while (fgets(line, sizeof(line), fp) != NULL)
+	{
+		if (rows >= 0)  // Inside BITMAP, a row of hex bytes, MSB first
+		{
+			if (strncmp(line, "ENDCHAR", 7) == 0)
+			{
+				rows = -1;
+				continue;
+			}
+			if (glyph == NULL || rows >= glyph->height) {continue;}
+			for (x = 0; x < glyph->width; x += 8)
+			{
+				if (sscanf(line + x / 4, "%2x", &value) != 1) {value = 0;}
+				for (k = 0; k < 8 && x + k < glyph->width; k++)
+				{
+					glyph->pixels[rows * glyph->width + x + k] = (value >> (7 - k)) & 1;
+				}
+			}
+			rows++;
+		}
+		else if (sscanf(line, "FONTBOUNDINGBOX %d %d %d %d", &font->box_width, &font->box_height, &font->box_x, &font->box_y) == 4) {}
+		else if (sscanf(line, "FONT_ASCENT %d", &font->ascent) == 1) {}
+		else if (sscanf(line, "FONT_DESCENT %d", &font->descent) == 1) {}
+		else if (sscanf(line, "DEFAULT_CHAR %u", &value) == 1) {font->default_char = value;}
+		else if (strncmp(line, "STARTCHAR", 9) == 0)
+		{
+			encoding = -1;
+			advance = font->box_width;
+			glyph = NULL;
+		}
+		else if (sscanf(line, "ENCODING %d", &encoding) == 1) {}
+		else if (sscanf(line, "DWIDTH %d", &advance) == 1) {}
+		else if (sscanf(line, "BBX %d %d %d %d", &w, &h, &x, &y) == 4 && encoding >= 0 && w >= 0 && h >= 0)
+		{
+			glyph = add_glyph(font);
+			glyph->code = (uint32_t)encoding;
+			glyph->advance = advance;
+			glyph->width = w;
+			glyph->height = h;
+			glyph->x_offset = x;
+			glyph->y_offset = y;
+			glyph->pixels = calloc((size_t)w * h + 1, 1);
+		}
+		else if (strncmp(line, "BITMAP", 6) == 0)
+		{
+			rows = 0;
+		}
+	}
+
+	if (font->ascent == 0 && font->descent == 0)
+	{
+		font->ascent = font->box_height + font->box_y;
+		font->descent = -font->box_y;
+	}
+	return font->count > 0 ? 0 : -1;
+}
+
+/* Read an integer of a PCF table in its byte order */
+static uint32_t pcf_read(const uint8_t *p, int size, int msb)
+{
+	uint32_t value = 0;
+	int k;
+
+	for (k = 0; k < size; k++)
+	{
+		value |= (uint32_t)p[msb ? k : size - 1 - k] << (8 * (size - 1 - k));
+	}
+	return value;
+}
+
+/* Read a PCF font, the tables of metrics, bitmaps, encodings and accelerators */
+static int load_pcf(FILE *fp, font_t *font)
+{
+	enum {ACCELERATORS = 0x02, METRICS = 0x04, BITMAPS = 0x08, ENCODINGS = 0x20, BDF_ACCELERATORS = 0x100};
+	uint8_t *file = NULL, *table[0x200] = {0}, *p, *bitmap;
+	uint32_t tables, type, format, offset, size, count, i, k, row_bytes, pad, unit, n;
+	size_t file_size = 0, got;
+	int msb, lsb, rsb, ascent, descent, advance, b1, b2, min2, max2, min1, max1, x, y;
+	int32_t *metrics = NULL;
+	uint32_t *offsets;
+
+	/* Read the whole file */
+	do
+	{
+		file = realloc(file, file_size + 65536);
+		if (file == NULL) {return -1;}
+		got = fread(file + file_size, 1, 65536, fp);
+		file_size += got;
+	} while (got == 65536);
+	if (file_size < 8 || memcmp(file, "\1fcp", 4) != 0) {return -1;}
+
+	/* The table of contents is little-endian */
+	tables = pcf_read(file + 4, 4, 0);
+	for (i = 0; i < tables && 8 + i * 16 + 16 <= file_size; i++)
+	{
+		type = pcf_read(file + 8 + i * 16, 4, 0);
+		format = pcf_read(file + 12 + i * 16, 4, 0);
+		size = pcf_read(file + 16 + i * 16, 4, 0);
+		offset = pcf_read(file + 20 + i * 16, 4, 0);
+		if (type < 0x200 && offset + size <= file_size)
+		{
+			table[type] = file + offset;
+		}
+	}
+	if (table[METRICS] == NULL || table[BITMAPS] == NULL || table[ENCODINGS] == NULL) {return -1;}
+
+	/* Metrics, compressed as bytes with an offset of 0x80 or as 16-bit values */
+	p = table[METRICS];
+	format = pcf_read(p, 4, 0);
+	msb = (format & 0x04) != 0;
+	if (format & 0x100)
+	{
+		count = pcf_read(p + 4, 2, msb);
+		metrics = malloc(count * 5 * sizeof(int32_t));
+		for (i = 0; i < count * 5; i++) {metrics[i] = (int32_t)p[6 + i] - 0x80;}
+	}
+	else
+	{
+		count = pcf_read(p + 4, 4, msb);
+		metrics = malloc(count * 5 * sizeof(int32_t));
+		for (i = 0; i < count; i++)
+		{
+			for (k = 0; k < 5; k++) {metrics[i * 5 + k] = (int16_t)pcf_read(p + 8 + i * 12 + k * 2, 2, msb);}
+		}
+	}
+
+	/* Bitmaps, rows padded to the glyph pad, in the bit and byte order of the format */
+	p = table[BITMAPS];
+	format = pcf_read(p, 4, 0);
+	msb = (format & 0x04) != 0;
+	if (pcf_read(p + 4, 4, msb) != count) {return -1;}
+	offsets = malloc(count * sizeof(uint32_t));
+	for (i = 0; i < count; i++) {offsets[i] = pcf_read(p + 8 + i * 4, 4, msb);}
+	bitmap = p + 8 + count * 4 + 16;
+	pad = 1U << (format & 3);
+	unit = 1U << ((format >> 4) & 3);
+
+	for (i = 0; i < count; i++)
+	{
+		glyph_t *glyph = add_glyph(font);
+		uint8_t bytes[64];
+
+		lsb = metrics[i * 5];
+		rsb = metrics[i * 5 + 1];
+		advance = metrics[i * 5 + 2];
+		ascent = metrics[i * 5 + 3];
+		descent = metrics[i * 5 + 4];
+
+		glyph->code = 0xFFFFFFFF;  // Set from the encodings
+		glyph->advance = advance;
+		glyph->width = (rsb > lsb) ? rsb - lsb : 0;
+		glyph->height = (ascent + descent > 0) ? ascent + descent : 0;
+		glyph->x_offset = lsb;
+		glyph->y_offset = -descent;
+		glyph->pixels = calloc((size_t)glyph->width * glyph->height + 1, 1);
+
+		row_bytes = (glyph->width + 8 * pad - 1) / (8 * pad) * pad;
+		if (row_bytes > sizeof(bytes)) {return -1;}
+		for (y = 0; y < glyph->height; y++)
+		{
+			memcpy(bytes, bitmap + offsets[i] + y * row_bytes, row_bytes);
+
+			/* Bring the bits into MSB-first order and the bytes of each scan unit into the bit order */
+			if (!(format & 0x08))
+			{
+				for (k = 0; k < row_bytes; k++)
+				{
+					uint8_t b = bytes[k], r = 0;
+					for (n = 0; n < 8; n++) {r |= ((b >> n) & 1) << (7 - n);}
+					bytes[k] = r;
+				}
+			}
+			if (((format & 0x04) != 0) != ((format & 0x08) != 0) && unit > 1)
+			{
+				for (k = 0; k + unit <= row_bytes; k += unit)
+				{
+					for (n = 0; n < unit / 2; n++)
+					{
+						uint8_t b = bytes[k + n];
+						bytes[k + n] = bytes[k + unit - 1 - n];
+						bytes[k + unit - 1 - n] = b;
+					}
+				}
+			}
+			for (x = 0; x < glyph->width; x++)
+			{
+				glyph->pixels[y * glyph->width + x] = (bytes[x / 8] >> (7 - x % 8)) & 1;
+			}
+		}
+	}
+
+	/* Encodings, a table of glyph numbers for the codes byte1 * 256 + byte2 */
+	p = table[ENCODINGS];
+	format = pcf_read(p, 4, 0);
+	msb = (format & 0x04) != 0;
+	min2 = (int16_t)pcf_read(p + 4, 2, msb);
+	max2 = (int16_t)pcf_read(p + 6, 2, msb);
+	min1 = (int16_t)pcf_read(p + 8, 2, msb);
+	max1 = (int16_t)pcf_read(p + 10, 2, msb);
+	font->default_char = pcf_read(p + 12, 2, msb);
+	for (b1 = min1; b1 <= max1; b1++)
+	{
+		for (b2 = min2; b2 <= max2; b2++)
+		{
+			n = pcf_read(p + 14 + ((b1 - min1) * (max2 - min2 + 1) + (b2 - min2)) * 2, 2, msb);
+			if (n < count) {font->glyphs[n].code = (uint32_t)(b1 << 8 | b2);}
+		}
+	}
+
+	/* Font ascent and descent from the accelerators */
+	p = table[BDF_ACCELERATORS] != NULL ? table[BDF_ACCELERATORS] : table[ACCELERATORS];
+	if (p != NULL)
+	{
+		format = pcf_read(p, 4, 0);
+		msb = (format & 0x04) != 0;
+		font->ascent = (int32_t)pcf_read(p + 12, 4, msb);
+		font->descent = (int32_t)pcf_read(p + 16, 4, msb);
+	}
+
+	/* The font bounding box of the glyphs */
+	for (i = 0; i < count; i++)
+	{
+		if (font->glyphs[i].advance > font->box_width) {font->box_width = font->glyphs[i].advance;}
+	}
+	font->box_height = font->ascent + font->descent;
+
+	free(metrics);
+	free(offsets);
+	free(file);
+	return 0;
+}
+
+/* Sort by codepoint, the glyphs without one at the end */
+static int compare(const void *a, const void *b)
+{
+	uint32_t ka = ((const glyph_t *)a)->code, kb = ((const glyph_t *)b)->code;
+
+	return (ka > kb) - (ka < kb);
+}
+
+/* Decode a UTF-8 character, returns 0 at the end of the text */
+static uint32_t decode_utf8(const uint8_t **p)
+{
+	uint32_t code = *(*p)++;
+	int length = 0;
+
+	if (code >= 0xF0) {length = 3; code &= 0x07;}
+	else if (code >= 0xE0) {length = 2; code &= 0x0F;}
+	else if (code >= 0xC0) {length = 1; code &= 0x1F;}
+	while (length-- > 0 && (**p & 0xC0) == 0x80)
+	{
+		code = (code << 6) | (*(*p)++ & 0x3F);
+	}
+	return code;
+}
+
+/* Draw a glyph into a cell in page format, with the baseline ascent pixels below the top */
+static void render_cell(const glyph_t *glyph, int width, int height, int ascent, uint8_t *cell)
+{
+	int x, y, cx, cy;
+
+	memset(cell, 0, (size_t)width * ((height + 7) / 8));
+	for (y = 0; y < glyph->height; y++)
+	{
+		cy = ascent - (glyph->y_offset + glyph->height) + y;
+		for (x = 0; x < glyph->width; x++)
+		{
+			cx = glyph->x_offset + x;
+			if (glyph->pixels[y * glyph->width + x] && cx >= 0 && cx < width && cy >= 0 && cy < height)
+			{
+				cell[(cy / 8) * width + cx] |= 0x01 << (cy % 8);
+			}
+		}
+	}
+}
+
+/* Print bytes in the style of oled_data.c, in rows of 16 bytes, without a comma after the last one */
+static void print_bytes(const uint8_t *data, size_t size)
+{
+	size_t k;
+
+	for (k = 0; k < size; k++)
+	{
+		printf("%s0x%02X", (k == 0) ? "" : (k % 16 == 0) ? ",\n\t" : ",", data[k]);
+	}
+}
+
+/* Print a codepoint as UTF-8 in a comment */
+static void print_utf8(uint32_t code)
+{
+	if (code < 0x20 || code == 0x7F) {printf("U+%04lX", (unsigned long)code);}
+	else if (code < 0x80) {printf("'%c'", (char)code);}
+	else if (code < 0x800) {printf("%c%c", 0xC0 | code >> 6, 0x80 | (code & 0x3F));}
+	else if (code < 0x10000) {printf("%c%c%c", 0xE0 | code >> 12, 0x80 | (code >> 6 & 0x3F), 0x80 | (code & 0x3F));}
+	else {printf("%c%c%c%c", 0xF0 | code >> 18, 0x80 | (code >> 12 & 0x3F), 0x80 | (code >> 6 & 0x3F), 0x80 | (code & 0x3F));}
+}
+
+/* Position of the glyph of the missing characters among the selected glyphs */
+static int missing_glyph(const glyph_t *glyphs, int count, uint32_t default_char)
+{
+	int i, question = -1;
+
+	for (i = 0; i < count; i++)
+	{
+		if (glyphs[i].code == default_char) {return i;}
+		if (glyphs[i].code == '?') {question = i;}
+	}
+	return question >= 0 ? question : 0;
+}
+
+/* Page format cells and an OLED_Font_t of one range */
+static void emit_table(const char *name, const glyph_t *glyphs, int count, int width, int height, int ascent, uint32_t default_char)
+{
+	size_t size = (size_t)width * ((height + 7) / 8);
+	uint8_t *cell = malloc(size);
+	int i, dense = (glyphs[count - 1].code - glyphs[0].code == (uint32_t)count - 1);
+
+	printf("/* %s, %d characters U+%04lX..U+%04lX, %d pixels wide, %d pixels high, generated by Tools/oled_compile.c */\n",
+		name, count, (unsigned long)glyphs[0].code, (unsigned long)glyphs[count - 1].code, width, height);
+	printf("static const uint8_t %s_Glyphs[][%zu] = {\n", name, size);
+	for (i = 0; i < count; i++)
+	{
+		render_cell(&glyphs[i], width, height, ascent, cell);
+		printf("\t{");
+		print_bytes(cell, size);
+		printf("},  // ");
+		print_utf8(glyphs[i].code);
+		printf("\n");
+	}
+	printf("};\n\n");
+
+	if (!dense)
+	{
+		printf("static const ChineseIndex_t %s_Index[] = {\n", name);
+		for (i = 0; i < count; i++)
+		{
+			printf("\t{0x%04lX, %d},  // ", (unsigned long)glyphs[i].code, i);
+			print_utf8(glyphs[i].code);
+			printf("\n");
+		}
+		printf("};\n\n");
+	}
+
+	printf("static const OLED_FontRange_t %s_Ranges[] = {\n", name);
+	printf("\t{0x%04lX, 0x%04lX, %d, %d, %s_Glyphs[0], sizeof(%s_Glyphs[0]), ",
+		(unsigned long)glyphs[0].code, (unsigned long)glyphs[count - 1].code, width, height, name, name);
+	if (dense) {printf("NULL, 0},\n");}
+	else {printf("%s_Index, %d},\n", name, count);}
+	printf("};\n\n");
+
+	printf("const OLED_Font_t %s = {%s_Ranges, 1, %d, %d, %s_Glyphs[%d]};\n",
+		name, name, width, height, name, missing_glyph(glyphs, count, default_char));
+	free(cell);
+}
+
+/* Bit-packed bounding boxes and an OLED_PackedFont_t */
+static void emit_packed(const char *name, const glyph_t *glyphs, int count, int width, int height, int ascent, uint32_t default_char)
+{
+	size_t size = (size_t)width * ((height + 7) / 8), bit = 0, k;
+	uint8_t *cell = malloc(size), *bitmap = calloc(size * count + 1, 1);
+	unsigned *offsets = malloc(((count + OFFSET_STEP - 1) / OFFSET_STEP) * sizeof(unsigned));
+	int i, x, y, x0, x1, y0, y1, advance, dense = (glyphs[count - 1].code - glyphs[0].code == (uint32_t)count - 1);
+
+	printf("/* %s, %d characters U+%04lX..U+%04lX, %d pixels high, generated by Tools/oled_compile.c */\n",
+		name, count, (unsigned long)glyphs[0].code, (unsigned long)glyphs[count - 1].code, height);
+	printf("static const OLED_PackedGlyph_t %s_Glyphs[] = {\n", name);
+	printf("\t/* width, height, x_offset, y_offset, advance */\n");
+	for (i = 0; i < count; i++)
+	{
+		render_cell(&glyphs[i], width, height, ascent, cell);
+
+		/* Bounding box of the set pixels in the cell */
+		x0 = width; x1 = -1; y0 = height; y1 = -1;
+		for (x = 0; x < width; x++)
+		{
+			for (y = 0; y < height; y++)
+			{
+				if (cell[(y / 8) * width + x] & (1 << (y % 8)))
+				{
+					if (x < x0) {x0 = x;}
+					if (x > x1) {x1 = x;}
+					if (y < y0) {y0 = y;}
+					if (y > y1) {y1 = y;}
+				}
+			}
+		}
+		if (x1 < 0) {x0 = y0 = 0; x1 = y1 = -1;}
+
+		/* Column by column from the top, LSB first, each glyph starts at a byte */
+		bit = (bit + 7) / 8 * 8;
+		if (i % OFFSET_STEP == 0) {offsets[i / OFFSET_STEP] = (unsigned)(bit / 8);}
+		for (x = x0; x <= x1; x++)
+		{
+			for (y = y0; y <= y1; y++, bit++)
+			{
+				if (cell[(y / 8) * width + x] & (1 << (y % 8))) {bitmap[bit / 8] |= 1 << (bit % 8);}
+			}
+		}
+
+		/* The advance of the font, at least the right edge of the box so that no column is lost */
+		advance = glyphs[i].advance;
+		if (advance < x1 + 1) {advance = x1 + 1;}
+		if (advance > 255) {advance = 255;}
+		printf("\t{%2d, %2d, %2d, %2d, %2d},  // ", x1 - x0 + 1, y1 - y0 + 1, x0, y0, advance);
+		print_utf8(glyphs[i].code);
+		printf("\n");
+	}
+	printf("};\n\n");
+
+	if (bit / 8 > 65535) {fprintf(stderr, "%s: the bitmap is larger than 64 KB\n", name);}
+
+	printf("static const uint8_t %s_Bitmap[] = {\n\t", name);
+	print_bytes(bitmap, (bit + 7) / 8);
+	printf(",\n};\n\n");
+
+	printf("static const uint16_t %s_Offsets[] = {", name);
+	for (i = 0; i < (count + OFFSET_STEP - 1) / OFFSET_STEP; i++)
+	{
+		printf("%s%u,", (i % 8 == 0) ? "\n\t" : " ", offsets[i]);
+	}
+	printf("\n};\n\n");
+
+	if (!dense)
+	{
+		printf("static const uint32_t %s_Codes[] = {", name);
+		for (k = 0; k < (size_t)count; k++)
+		{
+			printf("%s0x%04lX,", (k % 8 == 0) ? "\n\t" : " ", (unsigned long)glyphs[k].code);
+		}
+		printf("\n};\n\n");
+	}
+
+	printf("const OLED_PackedFont_t %s = {%s_Bitmap, %s_Offsets, %s_Glyphs, %s%s, 0x%04lX, %d, %d, %d};\n",
+		name, name, name, name, dense ? "NULL" : name, dense ? "" : "_Codes",
+		(unsigned long)glyphs[0].code, count, missing_glyph(glyphs, count, default_char), height);
+	free(cell);
+	free(bitmap);
+	free(offsets);
+}
+
+/* OLED_CF16x16 and its index, the characters as UTF-8 strings */
+static void emit_cells(const glyph_t *glyphs, int count, int ascent)
+{
+	uint8_t cell[32];
+	int i;
+
+	printf("/* OLED font library, 16 pixels wide, 16 pixels high, generated by Tools/oled_compile.c */\n");
+	printf("const ChineseCell_t OLED_CF16x16[] = {\n");
+	for (i = 0; i < count; i++)
+	{
+		render_cell(&glyphs[i], 16, 16, ascent, cell);
+		printf("\t\n\t\"");
+		print_utf8(glyphs[i].code);
+		printf("\",\n\t");
+		print_bytes(cell, 32);
+		printf(",\n");
+	}
+	printf("\t\n\t/* Following the format above, add the new font data at here */\n");
+	printf("\t// When the specified character is not found, make sure it is at the end of the array\n");
+	printf("\t\"\",\t\t\n\t");
+	print_bytes(default_figure, 32);
+	printf(",\n};\n\n");
+
+	printf("/* Index of OLED_CF16x16 sorted by codepoint, generated by Tools/oled_compile.c */\n");
+	printf("const ChineseIndex_t OLED_CF16x16_Index[] = {\n");
+	for (i = 0; i < count; i++)
+	{
+		printf("\t{0x%04lX, %d},  // ", (unsigned long)glyphs[i].code, i);
+		print_utf8(glyphs[i].code);
+		printf("\n");
+	}
+	printf("};\n");
+}
+
+static int compile_font(int argc, char **argv)
+{
+	const char *name = "Font", *mode = "table", *path = NULL, *text = NULL;
+	uint32_t first[MAX_RANGES], last[MAX_RANGES], code;
+	int ranges = 0, width = 0, height = 0, selected = 0, i, k;
+	uint8_t *chars = NULL;
+	const uint8_t *p;
+	size_t size = 0;
+	font_t font = {0};
+	glyph_t *glyphs;
+	FILE *fp;
+
+	for (i = 2; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {name = argv[++i];}
+		else if (strcmp(argv[i], "-m") == 0 && i + 1 < argc) {mode = argv[++i];}
+		else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {text = argv[++i];}
+		else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+		{
+			if (sscanf(argv[++i], "%dx%d", &width, &height) != 2) {width = -1;}
+		}
+		else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc && ranges < MAX_RANGES)
+		{
+			unsigned long a, b;
+			k = sscanf(argv[++i], "%lx-%lx", &a, &b);
+			if (k < 1) {width = -1;}
+			first[ranges] = (uint32_t)a;
+			last[ranges] = (k == 2) ? (uint32_t)b : (uint32_t)a;
+			ranges++;
+		}
+		else {path = argv[i];}
+	}
+	if (path == NULL || width < 0 || height < 0 ||
+	    (strcmp(mode, "table") != 0 && strcmp(mode, "packed") != 0 && strcmp(mode, "cells") != 0))
+	{
+		fprintf(stderr, "usage: %s font [-m table|packed|cells] [-n name] [-s WIDTHxHEIGHT] "
+			"[-r FIRST-LAST]... [-t chars.txt] font.bdf|font.pcf\n", argv[0]);
+		return 1;
+	}
+
+	fp = fopen(path, "rb");
+	if (fp == NULL)
+	{
+		perror(path);
+		return 1;
+	}
+	if (load_bdf(fp, &font) != 0)
+	{
+		rewind(fp);
+		memset(&font, 0, sizeof(font));
+		if (load_pcf(fp, &font) != 0)
+		{
+			fprintf(stderr, "%s: not a BDF or PCF font\n", path);
+			return 1;
+		}
+	}
+	fclose(fp);
+
+	if (text != NULL)
+	{
+		fp = fopen(text, "rb");
+		if (fp == NULL)
+		{
+			perror(text);
+			return 1;
+		}
+		fseek(fp, 0, SEEK_END);
+		size = (size_t)ftell(fp);
+		rewind(fp);
+		chars = calloc(size + 1, 1);
+		if (fread(chars, 1, size, fp) != size) {size = 0;}
+		fclose(fp);
+	}
+
+	/* Select the glyphs in the ranges and the text, all of them without either */
+	for (i = 0; i < font.count; i++)
+	{
+		glyph_t *glyph = &font.glyphs[i];
+
+		if (glyph->code == 0xFFFFFFFF) {continue;}
+		glyph->selected = (ranges == 0 && text == NULL);
+		for (k = 0; k < ranges; k++)
+		{
+			if (glyph->code >= first[k] && glyph->code <= last[k]) {glyph->selected = 1;}
+		}
+		for (p = chars; p != NULL && !glyph->selected && *p != '\0'; )
+		{
+			code = decode_utf8(&p);
+			if (code == glyph->code) {glyph->selected = 1;}
+		}
+		if (strcmp(mode, "cells") == 0 && glyph->code < 0x80) {glyph->selected = 0;}  // Only full-width characters
+	}
+
+	/* Keep the selected glyphs, sorted by codepoint */
+	glyphs = malloc((font.count + 1) * sizeof(glyph_t));
+	for (i = 0; i < font.count; i++)
+	{
+		if (font.glyphs[i].selected) {glyphs[selected++] = font.glyphs[i];}
+	}
+	qsort(glyphs, selected, sizeof(glyph_t), compare);
+	for (i = 1; i < selected; i++)
+	{
+		if (glyphs[i].code == glyphs[i - 1].code)
+		{
+			fprintf(stderr, "%s: U+%04lX is defined twice\n", path, (unsigned long)glyphs[i].code);
+			return 1;
+		}
+	}
+	if (selected == 0)
+	{
+		fprintf(stderr, "%s: no glyphs selected\n", path);
+		return 1;
+	}
+
+	/* Characters of the text that the font does not have */
+	for (p = chars; p != NULL && *p != '\0'; )
+	{
+		code = decode_utf8(&p);
+		if (code < 0x20 || (strcmp(mode, "cells") == 0 && code < 0x80)) {continue;}
+		for (k = 0; k < selected && glyphs[k].code != code; k++) {}
+		if (k == selected) {fprintf(stderr, "%s: U+%04lX is not in the font\n", path, (unsigned long)code);}
+	}
+
+	/* The cell size, the font bounding box if not given */
+	if (strcmp(mode, "cells") == 0)
+	{
+		width = 16;
+		height = 16;
+	}
+	if (width == 0) {width = font.box_width;}
+	if (height == 0) {height = font.ascent + font.descent;}
+	if (width <= 0 || width > 255 || height <= 0 || height > 255 || (strcmp(mode, "packed") == 0 && height > 32))
+	{
+		fprintf(stderr, "%s: a cell of %dx%d is not supported\n", path, width, height);
+		return 1;
+	}
+
+	if (strcmp(mode, "table") == 0) {emit_table(name, glyphs, selected, width, height, font.ascent, font.default_char);}
+	else if (strcmp(mode, "packed") == 0) {emit_packed(name, glyphs, selected, width, height, font.ascent, font.default_char);}
+	else {emit_cells(glyphs, selected, font.ascent);}
+
+	for (i = 0; i < font.count; i++) {free(font.glyphs[i].pixels);}
+	free(font.glyphs);
+	free(glyphs);
+	free(chars);
+	return 0;
+}
+
+static int compile_image(int argc, char **argv)
+{
+	const char *name = "Image", *path = NULL;
+	int compress = 0, invert = 0, threshold = 128, width, height, i;
+	size_t size, encoded_size;
+	uint8_t *pages, *encoded, magic[2] = {0};
+	FILE *fp;
+
+	for (i = 2; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {name = argv[++i];}
+		else if (strcmp(argv[i], "-l") == 0 && i + 1 < argc) {threshold = atoi(argv[++i]);}
+		else if (strcmp(argv[i], "-c") == 0) {compress = 1;}
+		else if (strcmp(argv[i], "-i") == 0) {invert = 1;}
+		else {path = argv[i];}
+	}
+	if (path == NULL)
+	{
+		fprintf(stderr, "usage: %s image [-n name] [-c] [-i] [-l threshold] image.pbm|image.png\n", argv[0]);
+		return 1;
+	}
+
+	fp = fopen(path, "rb");
+	if (fp == NULL)
+	{
+		perror(path);
+		return 1;
+	}
+	if (fread(magic, 1, 2, fp) != 2) {magic[0] = 0;}
+	rewind(fp);
+	pages = (magic[0] == 'P') ? load_pbm(fp, &width, &height) : load_png(fp, &width, &height, threshold);
+	fclose(fp);
+	if (pages == NULL)
+	{
+		fprintf(stderr, "%s: not a binary PBM (P4) or non-interlaced PNG image\n", path);
+		return 1;
+	}
+	if (width > 255 || height > 255)
+	{
+		fprintf(stderr, "%s: %dx%d is larger than OLED_ShowImage supports\n", path, width, height);
+		return 1;
+	}
+
+	size = (size_t)((height + 7) / 8) * width;
+	if (invert)
+	{
+		for (i = 0; i < (int)size; i++)
+		{
+			pages[i] = ~pages[i];
+			if (i / width == (height - 1) / 8 && height % 8) {pages[i] &= 0xFF >> (8 - height % 8);}
+		}
+	}
+
+	if (compress)
+	{
+		encoded = malloc(size + (size + 127) / 128);
+		encoded_size = packbits(pages, size, encoded);
+		printf("/* %s, %d pixels wide, %d pixels high, PackBits compressed (%zu -> %zu bytes) */\n",
+			name, width, height, size, encoded_size);
+		printf("const uint8_t %s[] = {\n\t", name);
+		print_bytes(encoded, encoded_size);
+		free(encoded);
+	}
+	else
+	{
+		printf("/* %s, %d pixels wide, %d pixels high */\n", name, width, height);
+		printf("const uint8_t %s[] = {\n\t", name);
+		print_bytes(pages, size);
+	}
+	printf(",\n};\n");
+
+	free(pages);
+	return 0;
+}
+
+int main(int argc, char **argv)
+{
+	if (argc >= 2 && strcmp(argv[1], "font") == 0) {return compile_font(argc, argv);}
+	if (argc >= 2 && strcmp(argv[1], "image") == 0) {return compile_image(argc, argv);}
+
+	fprintf(stderr, "usage: %s font [-m table|packed|cells] [-n name] [-s WIDTHxHEIGHT] "
+		"[-r FIRST-LAST]... [-t chars.txt] font.bdf|font.pcf\n", argv[0]);
+	fprintf(stderr, "       %s image [-n name] [-c] [-i] [-l threshold] image.pbm|image.png\n", argv[0]);
+	return 1;
+}
@@ -0,0 +1,179 @@
+/**
+ * @file   oled_pack_font.c
+ * @brief  Host-side converter of the fixed-width ASCII font libraries to OLED_PackedFont_t
+ *
+ * @note   Build: cc -O2 -o oled_pack_font oled_pack_font.c
+ *         Usage: oled_pack_font [-p] [-n name] Core/Src/oled_data.c OLED_F8x16 8 16
+ *
+ *         The glyphs of a font library like OLED_F8x16 (width * height pixels, in page format, from ' ' on)
+ *         are read from oled_data.c. Each glyph is cropped to the bounding box of its set pixels
+ *         and its bits are packed column by column, so the blank columns and rows are no longer stored.
+ *         By default every glyph keeps its position in the cell and the advance is the cell width,
+ *         which renders exactly like the original font library. With -p the glyphs are placed at the
+ *         left of the cell and advance by their width plus one column, a space by half the cell width.
+ *         The bitmap, the offsets, the glyph table and the OLED_PackedFont_t are written to stdout.
+ *         OFFSET_STEP must match OLED_PACKED_OFFSET_STEP in oled_data.h.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_GLYPHS  256
+#define OFFSET_STEP 8
+
+int main(int argc, char **argv)
+{
+	static uint8_t cells[MAX_GLYPHS][32 / 8 * 255];
+	static uint8_t bitmap[MAX_GLYPHS * 32 * 255 / 8];
+	static unsigned offsets[MAX_GLYPHS / OFFSET_STEP];
+	const char *name = NULL, *path = NULL, *array = NULL;
+	char line[1024], pattern[128], *p, *end;
+	int width = 0, height = 0, proportional = 0, inside = 0, i;
+	unsigned count = 0, bytes = 0, size, value;
+	size_t bit = 0;
+	FILE *fp;
+
+	for (i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-p") == 0) {proportional = 1;}
+		else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {name = argv[++i];}
+		else if (path == NULL) {path = argv[i];}
+		else if (array == NULL) {array = argv[i];}
+		else if (width == 0) {width = atoi(argv[i]);}
+		else {height = atoi(argv[i]);}
+	}
+	if (path == NULL || array == NULL || width <= 0 || width > 255 || height <= 0 || height > 32)
+	{
+		fprintf(stderr, "usage: %s [-p] [-n name] oled_data.c OLED_F8x16 8 16\n", argv[0]);
+		return 1;
+	}
+	if (name == NULL) {name = proportional ? "OLED_PackedFontP" : "OLED_PackedFont";}
+	size = width * ((height + 7) / 8);
+
+	fp = fopen(path, "rb");
+	if (fp == NULL)
+	{
+		perror(path);
+		return 1;
+	}
+
+	/* Read the bytes of the array in order, every size bytes are a glyph */
+	snprintf(pattern, sizeof(pattern), "%s[]", array);
+	while (fgets(line, sizeof(line), fp) != NULL)
+	{
+		if (!inside)
+		{
+			inside = (strstr(line, pattern) != NULL);
+			continue;
+		}
+		if (strncmp(line, "};", 2) == 0) {break;}
+
+		end = strstr(line, "//");  // The comments contain the characters themselves
+		if (end != NULL) {*end = '\0';}
+		for (p = line; (p = strstr(p, "0x")) != NULL; p += 2)
+		{
+			if (sscanf(p, "0x%2x", &value) != 1) {continue;}
+			if (count == MAX_GLYPHS)
+			{
+				fprintf(stderr, "%s: more than %d glyphs in %s\n", path, MAX_GLYPHS, array);
+				return 1;
+			}
+			cells[count][bytes++] = (uint8_t)value;
+			if (bytes == size)
+			{
+				bytes = 0;
+				count++;
+			}
+		}
+	}
+	fclose(fp);
+
+	if (!inside || count == 0 || bytes != 0)
+	{
+		fprintf(stderr, "%s: %s not found or not made of %dx%d glyphs\n", path, array, width, height);
+		return 1;
+	}
+
+	printf("/* %s, %u characters from ' ', packed from %s */\n", name, count, array);
+	printf("static const OLED_PackedGlyph_t %s_Glyphs[] = {\n", name);
+	printf("\t/* width, height, x_offset, y_offset, advance */\n");
+	for (i = 0; i < (int)count; i++)
+	{
+		int x0 = width, x1 = -1, y0 = height, y1 = -1, x, y, box_width, box_height, advance, x_offset;
+		size_t offset;
+
+		/* Bounding box of the set pixels */
+		for (x = 0; x < width; x++)
+		{
+			for (y = 0; y < height; y++)
+			{
+				if (cells[i][y / 8 * width + x] & (1 << (y % 8)))
+				{
+					if (x < x0) {x0 = x;}
+					if (x > x1) {x1 = x;}
+					if (y < y0) {y0 = y;}
+					if (y > y1) {y1 = y;}
+				}
+			}
+		}
+		if (x1 < 0)  // A blank glyph like the space has an empty box
+		{
+			x0 = y0 = 0;
+			box_width = box_height = 0;
+		}
+		else
+		{
+			box_width = x1 - x0 + 1;
+			box_height = y1 - y0 + 1;
+		}
+
+		/* Pack the box column by column from the top, LSB first, each glyph starts at a byte */
+		bit = (bit + 7) / 8 * 8;
+		offset = bit / 8;
+		if (offset > 65535)
+		{
+			fprintf(stderr, "%s: the bitmap is larger than 64 KB\n", array);
+			return 1;
+		}
+		if (i % OFFSET_STEP == 0) {offsets[i / OFFSET_STEP] = (unsigned)offset;}
+		for (x = x0; x < x0 + box_width; x++)
+		{
+			for (y = y0; y < y0 + box_height; y++, bit++)
+			{
+				if (cells[i][y / 8 * width + x] & (1 << (y % 8)))
+				{
+					bitmap[bit / 8] |= 1 << (bit % 8);
+				}
+			}
+		}
+
+		x_offset = proportional ? 0 : x0;
+		advance = proportional ? (box_width ? box_width + 1 : (width + 1) / 2) : width;
+		printf("\t{%2d, %2d, %2d, %2d, %2d},  // '%c'\n", box_width, box_height, x_offset, y0, advance, ' ' + i);
+	}
+	printf("};\n\n");
+
+	size = (unsigned)((bit + 7) / 8);
+	printf("static const uint8_t %s_Bitmap[] = {", name);
+	for (i = 0; i < (int)size; i++)
+	{
+		printf("%s0x%02X,", (i % 16 == 0) ? "\n\t" : "", bitmap[i]);
+	}
+	printf("\n};\n\n");
+
+	printf("static const uint16_t %s_Offsets[] = {", name);
+	for (i = 0; i < (int)((count + OFFSET_STEP - 1) / OFFSET_STEP); i++)
+	{
+		printf("%s%u,", (i % 8 == 0) ? "\n\t" : " ", offsets[i]);
+	}
+	printf("\n};\n\n");
+
+	/* Missing characters are shown as '?' */
+	printf("/* %u bytes instead of %u */\n", (unsigned)(size + count * 5 + (count + OFFSET_STEP - 1) / OFFSET_STEP * 2),
+		count * width * ((height + 7) / 8));
+	printf("const OLED_PackedFont_t %s = {%s_Bitmap, %s_Offsets, %s_Glyphs, NULL, 0x20, %u, '?' - ' ', %d};\n",
+		name, name, name, name, count, height);
+	return 0;
+}
@@ -0,0 +1,94 @@
+/**
+ * @file   oled_rle.c
+ * @brief  Host-side encoder for the run-length compressed images of OLED_ShowImageRLE
+ *
+ * @note   Build: cc -O2 -o oled_rle oled_rle.c
+ *         Usage: oled_rle [-n name] image.pbm
+ *                oled_rle [-n name] -r WIDTHxHEIGHT image.bin
+ *
+ *         The input is a binary PBM (P4) image, or with -r the raw page format bytes used by OLED_ShowImage.
+ *         The PackBits encoded array is written to stdout in the style of oled_data.c,
+ *         its declaration goes to oled_data.h like the other images.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "oled_tool.h"
+
+int main(int argc, char **argv)
+{
+	const char *name = "Image", *path = NULL;
+	int width = 0, height = 0, raw = 0, i;
+	size_t size, encoded_size, k;
+	uint8_t *pages, *encoded;
+	FILE *fp;
+
+	for (i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {name = argv[++i];}
+		else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc)
+		{
+			raw = 1;
+			if (sscanf(argv[++i], "%dx%d", &width, &height) != 2) {raw = -1;}
+		}
+		else {path = argv[i];}
+	}
+	if (path == NULL || raw < 0)
+	{
+		fprintf(stderr, "usage: %s [-n name] [-r WIDTHxHEIGHT] image\n", argv[0]);
+		return 1;
+	}
+
+	fp = fopen(path, "rb");
+	if (fp == NULL)
+	{
+		perror(path);
+		return 1;
+	}
+
+	if (raw)
+	{
+		size = (size_t)((height + 7) / 8) * width;
+		pages = malloc(size);
+		if (pages == NULL || fread(pages, 1, size, fp) != size)
+		{
+			fprintf(stderr, "%s: expected %zu bytes\n", path, size);
+			return 1;
+		}
+	}
+	else
+	{
+		pages = load_pbm(fp, &width, &height);
+		if (pages == NULL)
+		{
+			fprintf(stderr, "%s: not a binary PBM (P4) image\n", path);
+			return 1;
+		}
+		size = (size_t)((height + 7) / 8) * width;
+	}
+	fclose(fp);
+
+	if (width > 128 || height > 64)
+	{
+		fprintf(stderr, "%s: %dx%d is larger than the screen\n", path, width, height);
+		return 1;
+	}
+
+	encoded = malloc(size + (size + 127) / 128);
+	encoded_size = packbits(pages, size, encoded);
+
+	printf("/* %s, %d pixels wide, %d pixels high, PackBits compressed (%zu -> %zu bytes) */\n",
+		name, width, height, size, encoded_size);
+	printf("const uint8_t %s[] = {", name);
+	for (k = 0; k < encoded_size; k++)
+	{
+		printf("%s0x%02X,", (k % 16 == 0) ? "\n\t" : "", encoded[k]);
+	}
+	printf("\n};\n");
+
+	free(pages);
+	free(encoded);
+	return 0;
+}
@@ -0,0 +1,443 @@
+/**
+ * @file   oled_tool.h
+ * @brief  Image helpers shared by the host-side tools, PBM and PNG loading and PackBits encoding
+ *
+ * @note   Header-only, every tool is a single translation unit.
+ */
+
+#ifndef __OLED_TOOL_H__
+#define __OLED_TOOL_H__
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Read a PBM header token, skipping whitespace and comments */
+static inline int read_token(FILE *fp, char *buf, size_t size)
+{
+	int c;
+	size_t n = 0;
+
+	do
+	{
+		c = fgetc(fp);
+		if (c == '#')
+		{
+			while (c != '\n' && c != EOF) {c = fgetc(fp);}
+		}
+	} while (c == ' ' || c == '\t' || c == '\r' || c == '\n');
+
+	while (c != EOF && c != ' ' && c != '\t' && c != '\r' && c != '\n' && n + 1 < size)
+	{
+		buf[n++] = (char)c;
+		c = fgetc(fp);
+	}
+	buf[n] = '\0';
+	return n > 0;
+}
+
+/* Load a binary PBM image and convert it to the page format */
+static inline uint8_t *load_pbm(FILE *fp, int *width, int *height)
+{
+	char token[16];
+	int stride, x, y;
+	uint8_t *rows, *pages;
+
+	if (!read_token(fp, token, sizeof(token)) || strcmp(token, "P4") != 0) {return NULL;}
+	if (!read_token(fp, token, sizeof(token))) {return NULL;}
+	*width = atoi(token);
+	if (!read_token(fp, token, sizeof(token))) {return NULL;}
+	*height = atoi(token);
+	if (*width <= 0 || *height <= 0) {return NULL;}
+
+	stride = (*width + 7) / 8;
+	rows = malloc((size_t)stride * *height);
+	pages = calloc((size_t)((*height + 7) / 8) * *width, 1);
+	if (rows == NULL || pages == NULL || fread(rows, stride, *height, fp) != (size_t)*height)
+	{
+		free(rows);
+		free(pages);
+		return NULL;
+	}
+
+	/* PBM rows are MSB-first, a set bit is a lit pixel */
+	for (y = 0; y < *height; y++)
+	{
+		for (x = 0; x < *width; x++)
+		{
+			if (rows[y * stride + x / 8] & (0x80 >> (x % 8)))
+			{
+				pages[(y / 8) * *width + x] |= 0x01 << (y % 8);
+			}
+		}
+	}
+	free(rows);
+	return pages;
+}
+
+/* PackBits encode src into dst, dst needs size + (size + 127) / 128 bytes, returns the encoded size */
+static inline size_t packbits(const uint8_t *src, size_t size, uint8_t *dst)
+{
+	size_t i = 0, out = 0, run, lit;
+
+	while (i < size)
+	{
+		/* Length of the repeat run at i */
+		for (run = 1; i + run < size && run < 128 && src[i + run] == src[i]; run++) {}
+
+		if (run >= 2)
+		{
+			dst[out++] = (uint8_t)(257 - run);
+			dst[out++] = src[i];
+			i += run;
+			continue;
+		}
+
+		/* Literal run until the next repeat of at least 3 bytes, or 128 bytes */
+		for (lit = 1; i + lit < size && lit < 128; lit++)
+		{
+			if (i + lit + 2 < size && src[i + lit] == src[i + lit + 1] && src[i + lit] == src[i + lit + 2]) {break;}
+		}
+		dst[out++] = (uint8_t)(lit - 1);
+		memcpy(&dst[out], &src[i], lit);
+		out += lit;
+		i += lit;
+	}
+	return out;
+}
+
+/* Bit reader of a DEFLATE stream */
+typedef struct
+{
+	const uint8_t *src;
+	size_t size, pos;
+	uint32_t bits;
+	int count, error;
+} inflate_t;
+
+/* Canonical Huffman code, the number of codes of each length and the symbols in code order */
+typedef struct
+{
+	uint16_t counts[16];
+	uint16_t symbols[288];
+} huffman_t;
+
+/* Read count bits, the first bit in the LSB */
+static inline uint32_t inflate_bits(inflate_t *s, int count)
+{
+	uint32_t value;
+
+	while (s->count < count)
+	{
+		if (s->pos >= s->size)
+		{
+			s->error = 1;
+			return 0;
+		}
+		s->bits |= (uint32_t)s->src[s->pos++] << s->count;
+		s->count += 8;
+	}
+	value = s->bits & ((1UL << count) - 1);
+	s->bits >>= count;
+	s->count -= count;
+	return value;
+}
+
+/* Build a canonical Huffman code from the code lengths of n symbols */
+static inline void huffman_build(huffman_t *h, const uint8_t *lengths, int n)
+{
+	uint16_t offsets[16];
+	int i;
+
+	memset(h->counts, 0, sizeof(h->counts));
+	for (i = 0; i < n; i++) {h->counts[lengths[i]]++;}
+	h->counts[0] = 0;
+
+	offsets[1] = 0;
+	for (i = 1; i < 15; i++) {offsets[i + 1] = offsets[i] + h->counts[i];}
+	for (i = 0; i < n; i++)
+	{
+		if (lengths[i] != 0) {h->symbols[offsets[lengths[i]]++] = (uint16_t)i;}
+	}
+}
+
+/* Decode a symbol, the codes of each length follow the codes of the shorter lengths */
+static inline int huffman_decode(inflate_t *s, const huffman_t *h)
+{
+	int code = 0, first = 0, index = 0, length;
+
+	for (length = 1; length < 16; length++)
+	{
+		code |= (int)inflate_bits(s, 1);
+		if (code - h->counts[length] < first) {return h->symbols[index + code - first];}
+		index += h->counts[length];
+		first = (first + h->counts[length]) << 1;
+		code <<= 1;
+	}
+	s->error = 1;
+	return 0;
+}
+
+/* Inflate a zlib stream into dst of exactly size bytes, returns 0 on success */
+static inline int inflate_zlib(const uint8_t *src, size_t src_size, uint8_t *dst, size_t size)
+{
+	static const uint16_t length_base[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+		35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+	static const uint8_t length_extra[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+	static const uint16_t distance_base[30] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+		257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+	static const uint8_t distance_extra[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8,
+		9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+	static const uint8_t order[19] = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+	inflate_t s = {src, src_size, 2, 0, 0, 0};  // Skip the zlib header
+	huffman_t literals, distances;
+	uint8_t lengths[320];
+	size_t out = 0, length, distance;
+	int last, type, n_literal, n_distance, n_code, i, symbol, repeat;
+
+	if (src_size < 2 || (src[0] & 0x0F) != 8 || (src[0] << 8 | src[1]) % 31 != 0) {return -1;}
+
+	do
+	{
+		last = (int)inflate_bits(&s, 1);
+		type = (int)inflate_bits(&s, 2);
+
+		if (type == 0)  // Stored block
+		{
+			s.bits = 0;
+			s.count = 0;
+			if (s.pos + 4 > s.size) {return -1;}
+			length = s.src[s.pos] | s.src[s.pos + 1] << 8;
+			s.pos += 4;
+			if (s.pos + length > s.size || out + length > size) {return -1;}
+			memcpy(dst + out, s.src + s.pos, length);
+			s.pos += length;
+			out += length;
+			continue;
+		}
+
+		if (type == 1)  // Fixed Huffman codes
+		{
+			for (i = 0; i < 288; i++) {lengths[i] = (i < 144) ? 8 : (i < 256) ? 9 : (i < 280) ? 7 : 8;}
+			huffman_build(&literals, lengths, 288);
+			for (i = 0; i < 30; i++) {lengths[i] = 5;}
+			huffman_build(&distances, lengths, 30);
+		}
+		else if (type == 2)  // Dynamic Huffman codes, their lengths are Huffman coded themselves
+		{
+			n_literal = (int)inflate_bits(&s, 5) + 257;
+			n_distance = (int)inflate_bits(&s, 5) + 1;
+			n_code = (int)inflate_bits(&s, 4) + 4;
+			memset(lengths, 0, sizeof(lengths));
+			for (i = 0; i < n_code; i++) {lengths[order[i]] = (uint8_t)inflate_bits(&s, 3);}
+			huffman_build(&literals, lengths, 19);
+
+			for (i = 0; i < n_literal + n_distance && !s.error; )
+			{
+				symbol = huffman_decode(&s, &literals);
+				if (symbol < 16) {lengths[i++] = (uint8_t)symbol; continue;}
+
+				if (symbol == 16)
+				{
+					if (i == 0) {return -1;}
+					repeat = 3 + (int)inflate_bits(&s, 2);
+					symbol = lengths[i - 1];
+				}
+				else
+				{
+					repeat = (symbol == 17) ? 3 + (int)inflate_bits(&s, 3) : 11 + (int)inflate_bits(&s, 7);
+					symbol = 0;
+				}
+				if (i + repeat > n_literal + n_distance) {return -1;}
+				while (repeat--) {lengths[i++] = (uint8_t)symbol;}
+			}
+			huffman_build(&literals, lengths, n_literal);
+			huffman_build(&distances, lengths + n_literal, n_distance);
+		}
+		else
+		{
+			return -1;
+		}
+
+		/* Literals and back references until the end of the block */
+		while (!s.error)
+		{
+			symbol = huffman_decode(&s, &literals);
+			if (symbol < 256)
+			{
+				if (out >= size) {return -1;}
+				dst[out++] = (uint8_t)symbol;
+				continue;
+			}
+			if (symbol == 256) {break;}
+
+			symbol -= 257;
+			if (symbol >= 29) {return -1;}
+			length = length_base[symbol] + inflate_bits(&s, length_extra[symbol]);
+			symbol = huffman_decode(&s, &distances);
+			if (symbol >= 30) {return -1;}
+			distance = distance_base[symbol] + inflate_bits(&s, distance_extra[symbol]);
+			if (distance > out || out + length > size) {return -1;}
+			while (length--)
+			{
+				dst[out] = dst[out - distance];
+				out++;
+			}
+		}
+	} while (!last && !s.error);
+
+	return (s.error || out != size) ? -1 : 0;
+}
+
+/* Big-endian 32-bit value of a PNG chunk */
+static inline uint32_t png_u32(const uint8_t *p)
+{
+	return (uint32_t)p[0] << 24 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 8 | p[3];
+}
+
+/* Load a non-interlaced PNG image and convert it to the page format, dark opaque pixels are lit like in PBM */
+static inline uint8_t *load_png(FILE *fp, int *width, int *height, int threshold)
+{
+	static const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+	static const uint8_t channels_of[7] = {1, 0, 3, 1, 2, 0, 4};
+	uint8_t *file = NULL, *data = NULL, *raw = NULL, *pages = NULL, palette[256][4], *row, *prior, *chunk;
+	size_t file_size = 0, data_size = 0, stride, pos, x, i;
+	int depth = 0, color = 0, channels, bpp, y, k, a, b, c, pa, pb, pc, value[4], luma, alpha;
+	uint32_t length, w = 0, h = 0;
+
+	/* Read the whole file */
+	for (;;)
+	{
+		uint8_t *grown = realloc(file, file_size + 65536);
+		if (grown == NULL) {goto fail;}
+		file = grown;
+		length = (uint32_t)fread(file + file_size, 1, 65536, fp);
+		file_size += length;
+		if (length < 65536) {break;}
+	}
+	if (file_size < 8 || memcmp(file, signature, 8) != 0) {goto fail;}
+
+	memset(palette, 0xFF, sizeof(palette));
+	for (pos = 8; pos + 12 <= file_size; pos += 12 + length)
+	{
+		length = png_u32(file + pos);
+		chunk = file + pos + 8;
+		if (pos + 12 + length > file_size) {goto fail;}
+
+		if (memcmp(file + pos + 4, "IHDR", 4) == 0 && length >= 13)
+		{
+			w = png_u32(chunk);
+			h = png_u32(chunk + 4);
+			depth = chunk[8];
+			color = chunk[9];
+			if (chunk[12] != 0 || color > 6 || channels_of[color] == 0) {goto fail;}  // Interlaced or unknown
+		}
+		else if (memcmp(file + pos + 4, "PLTE", 4) == 0)
+		{
+			for (i = 0; i < length / 3 && i < 256; i++) {memcpy(palette[i], chunk + i * 3, 3);}
+		}
+		else if (memcmp(file + pos + 4, "tRNS", 4) == 0 && color == 3)
+		{
+			for (i = 0; i < length && i < 256; i++) {palette[i][3] = chunk[i];}
+		}
+		else if (memcmp(file + pos + 4, "IDAT", 4) == 0)
+		{
+			uint8_t *grown = realloc(data, data_size + length + 1);
+			if (grown == NULL) {goto fail;}
+			data = grown;
+			memcpy(data + data_size, chunk, length);
+			data_size += length;
+		}
+		else if (memcmp(file + pos + 4, "IEND", 4) == 0)
+		{
+			break;
+		}
+	}
+	if (w == 0 || h == 0 || w > 4096 || h > 4096 || data == NULL) {goto fail;}
+
+	/* Inflate the rows, each starts with its filter type */
+	channels = channels_of[color];
+	bpp = (channels * depth + 7) / 8;
+	stride = ((size_t)w * channels * depth + 7) / 8;
+	raw = malloc((stride + 1) * h);
+	pages = calloc((size_t)((h + 7) / 8) * w, 1);
+	if (raw == NULL || pages == NULL || inflate_zlib(data, data_size, raw, (stride + 1) * h) != 0) {goto fail;}
+
+	for (y = 0; y < (int)h; y++)
+	{
+		row = raw + y * (stride + 1) + 1;
+		prior = (y > 0) ? row - (stride + 1) : NULL;
+
+		/* Undo the filter of the row */
+		for (x = 0; x < stride; x++)
+		{
+			a = (x >= (size_t)bpp) ? row[x - bpp] : 0;
+			b = (prior != NULL) ? prior[x] : 0;
+			c = (prior != NULL && x >= (size_t)bpp) ? prior[x - bpp] : 0;
+			switch (row[-1])
+			{
+				case 0: break;
+				case 1: row[x] += a; break;
+				case 2: row[x] += b; break;
+				case 3: row[x] += (a + b) / 2; break;
+				case 4:
+					pa = abs(b - c);
+					pb = abs(a - c);
+					pc = abs(a + b - 2 * c);
+					row[x] += (pa <= pb && pa <= pc) ? a : (pb <= pc) ? b : c;
+					break;
+				default: goto fail;
+			}
+		}
+
+		/* Luminance and alpha of each pixel, samples scaled to 8 bits */
+		for (x = 0; x < w; x++)
+		{
+			for (k = 0; k < channels; k++)
+			{
+				if (depth == 16) {value[k] = row[(x * channels + k) * 2];}
+				else if (depth == 8) {value[k] = row[x * channels + k];}
+				else
+				{
+					value[k] = (row[x * depth / 8] >> (8 - depth - x * depth % 8)) & ((1 << depth) - 1);
+					if (color != 3) {value[k] = value[k] * 255 / ((1 << depth) - 1);}
+				}
+			}
+
+			alpha = 255;
+			switch (color)
+			{
+				case 0: luma = value[0]; break;
+				case 2: luma = (value[0] * 299 + value[1] * 587 + value[2] * 114) / 1000; break;
+				case 3:
+					luma = (palette[value[0]][0] * 299 + palette[value[0]][1] * 587 + palette[value[0]][2] * 114) / 1000;
+					alpha = palette[value[0]][3];
+					break;
+				case 4: luma = value[0]; alpha = value[1]; break;
+				default: luma = (value[0] * 299 + value[1] * 587 + value[2] * 114) / 1000; alpha = value[3]; break;
+			}
+
+			if (alpha >= 128 && luma < threshold)
+			{
+				pages[(y / 8) * w + x] |= 0x01 << (y % 8);
+			}
+		}
+	}
+
+	*width = (int)w;
+	*height = (int)h;
+	free(file);
+	free(data);
+	free(raw);
+	return pages;
+
+fail:
+	free(file);
+	free(data);
+	free(raw);
+	free(pages);
+	return NULL;
+}
+
+#endif /* __OLED_TOOL_H__ */